@@ -1,6 +1,31 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Joyship2.h"
+#include "JoyshipProfiling.h"
 #include "Modules/ModuleManager.h"
+#include "Misc/CoreDelegates.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Joyship2, "Joyship2" );
+class FJoyship2Module : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		// Per-frame live counts for -csvprofile
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&JoyshipProfiling::EmitFrameStats);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	}
+
+private:
+	FDelegateHandle EndFrameHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FJoyship2Module, Joyship2, "Joyship2" );
+
+DEFINE_LOG_CATEGORY(LogJoyship);
+DEFINE_LOG_CATEGORY(LogJoyshipMovement);
+DEFINE_LOG_CATEGORY(LogJoyshipCombat);
+DEFINE_LOG_CATEGORY(LogJoyshipPickup);
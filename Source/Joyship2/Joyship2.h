@@ -4,3 +4,37 @@
 
 #include "CoreMinimal.h"
 
+/* ---------------- LOGGING ---------------- */
+
+// Highest verbosity compiled into the Joyship categories. Shipping keeps warnings and errors only,
+// so Verbose/VeryVerbose diagnostics (and their argument formatting) disappear entirely.
+#if UE_BUILD_SHIPPING
+#define JOYSHIP_LOG_COMPILE_VERBOSITY Warning
+#else
+#define JOYSHIP_LOG_COMPILE_VERBOSITY All
+#endif
+
+JOYSHIP2_API DECLARE_LOG_CATEGORY_EXTERN(LogJoyship, Log, JOYSHIP_LOG_COMPILE_VERBOSITY);
+// Ship thrust, rotation and physics state
+JOYSHIP2_API DECLARE_LOG_CATEGORY_EXTERN(LogJoyshipMovement, Log, JOYSHIP_LOG_COMPILE_VERBOSITY);
+// Firing, projectiles, aggro and damage
+JOYSHIP2_API DECLARE_LOG_CATEGORY_EXTERN(LogJoyshipCombat, Log, JOYSHIP_LOG_COMPILE_VERBOSITY);
+// Collectables and fuel
+JOYSHIP2_API DECLARE_LOG_CATEGORY_EXTERN(LogJoyshipPickup, Log, JOYSHIP_LOG_COMPILE_VERBOSITY);
+
+// Per-frame diagnostics: log at most once every IntervalSeconds per call site (shared by all instances).
+// Nothing is evaluated when the category/verbosity is disabled or compiled out.
+#define JOYSHIP_LOG_THROTTLED(CategoryName, Verbosity, IntervalSeconds, Format, ...) \
+    do \
+    { \
+        if (UE_LOG_ACTIVE(CategoryName, Verbosity)) \
+        { \
+            static double JoyshipLastLogTime = -DBL_MAX; \
+            const double JoyshipNow = FPlatformTime::Seconds(); \
+            if (JoyshipNow - JoyshipLastLogTime >= (IntervalSeconds)) \
+            { \
+                JoyshipLastLogTime = JoyshipNow; \
+                UE_LOG(CategoryName, Verbosity, Format, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
@@ -0,0 +1,63 @@
+#include "JoyshipHeadlessWorld.h"
+#include "Joyship2.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "UObject/Package.h"
+
+UWorld* JoyshipHeadlessWorld::Create(const FString& MapPath, const TCHAR* Name, TFunction<void(UWorld*)> PopulateBeforePlay)
+{
+    UWorld* World = nullptr;
+
+    if (!MapPath.IsEmpty())
+    {
+        UPackage* Package = LoadPackage(nullptr, *MapPath, LOAD_None);
+        World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+        if (!World)
+        {
+            UE_LOG(LogJoyship, Error, TEXT("[World] Could not load map %s"), *MapPath);
+            return nullptr;
+        }
+
+        World->WorldType = EWorldType::Game;
+        World->AddToRoot();
+        if (!World->bIsWorldInitialized)
+        {
+            World->InitWorld(UWorld::InitializationValues().AllowAudioPlayback(false));
+        }
+    }
+    else
+    {
+        World = UWorld::CreateWorld(EWorldType::Game, false, Name);
+        World->AddToRoot();
+    }
+
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    FURL URL;
+    World->InitializeActorsForPlay(URL);
+    if (PopulateBeforePlay)
+    {
+        PopulateBeforePlay(World);
+    }
+    World->BeginPlay();
+
+    // No game instance means no game mode to start play; dispatch BeginPlay to actors directly
+    if (!World->HasBegunPlay() && World->GetWorldSettings())
+    {
+        World->GetWorldSettings()->NotifyBeginPlay();
+    }
+
+    return World;
+}
+
+void JoyshipHeadlessWorld::Destroy(UWorld* World)
+{
+    if (!World) return;
+
+    World->RemoveFromRoot();
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
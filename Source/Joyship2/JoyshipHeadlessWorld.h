@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+// Game worlds without a game instance or viewport, for the benchmark commandlets and the automation tests.
+// Subsystems and BeginPlay run as in a game; nothing here ticks the world.
+namespace JoyshipHeadlessWorld
+{
+    // Load MapPath (or create an empty world called Name when it is empty), initialize it as a game world and begin play.
+    // PopulateBeforePlay spawns actors that begin play with the world, as actors loaded with a map do.
+    // Returns null if the map could not be loaded.
+    JOYSHIP2_API UWorld* Create(const FString& MapPath, const TCHAR* Name, TFunction<void(UWorld*)> PopulateBeforePlay = nullptr);
+
+    // Tear down a world made by Create and collect its garbage
+    JOYSHIP2_API void Destroy(UWorld* World);
+}
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "JoyshipProfiling.h"
+
+DEFINE_STAT(STAT_Joyship_ShipTick);
+DEFINE_STAT(STAT_Joyship_EnemyTick);
+DEFINE_STAT(STAT_Joyship_EnemySteering);
+DEFINE_STAT(STAT_Joyship_TurretTick);
+DEFINE_STAT(STAT_Joyship_TurretScan);
+DEFINE_STAT(STAT_Joyship_CollectableTick);
+DEFINE_STAT(STAT_Joyship_Fire);
+DEFINE_STAT(STAT_Joyship_ProjectileHit);
+DEFINE_STAT(STAT_Joyship_ProjectileSim);
+DEFINE_STAT(STAT_Joyship_DamageResolve);
+
+DEFINE_STAT(STAT_JoyshipLiveProjectiles);
+DEFINE_STAT(STAT_JoyshipLiveEnemies);
+DEFINE_STAT(STAT_JoyshipLiveCollectables);
+
+DEFINE_STAT(STAT_JoyshipSpatialGridMemory);
+DEFINE_STAT(STAT_JoyshipSteeringMemory);
+DEFINE_STAT(STAT_JoyshipProjectilePoolMemory);
+
+CSV_DEFINE_CATEGORY_MODULE(JOYSHIP2_API, Joyship, true);
+
+namespace JoyshipProfiling
+{
+    bool bEnabled = false;
+
+    static FSlotTotals Totals[(int32)ESlot::Num];
+    static int32 Counters[(int32)ECounter::Num] = {};
+
+    const TCHAR* GetSlotName(ESlot Slot)
+    {
+        switch (Slot)
+        {
+        case ESlot::ShipTick:        return TEXT("ShipTick");
+        case ESlot::EnemyTick:       return TEXT("EnemyTick");
+        case ESlot::EnemySteering:   return TEXT("EnemySteering");
+        case ESlot::TurretTick:      return TEXT("TurretTick");
+        case ESlot::TurretScan:      return TEXT("TurretScan");
+        case ESlot::CollectableTick: return TEXT("CollectableTick");
+        case ESlot::Fire:            return TEXT("Fire");
+        case ESlot::ProjectileHit:   return TEXT("ProjectileHit");
+        case ESlot::ProjectileSim:   return TEXT("ProjectileSim");
+        case ESlot::DamageResolve:   return TEXT("DamageResolve");
+        default:                     return TEXT("Unknown");
+        }
+    }
+
+    void Reset()
+    {
+        for (FSlotTotals& Slot : Totals)
+        {
+            Slot = FSlotTotals();
+        }
+    }
+
+    const FSlotTotals& GetTotals(ESlot Slot)
+    {
+        return Totals[(int32)Slot];
+    }
+
+    void Accumulate(ESlot Slot, uint64 Cycles)
+    {
+        FSlotTotals& Entry = Totals[(int32)Slot];
+        Entry.Cycles += Cycles;
+        ++Entry.Calls;
+    }
+
+    void AdjustCounter(ECounter Counter, int32 Delta)
+    {
+        Counters[(int32)Counter] += Delta;
+
+        switch (Counter)
+        {
+        case ECounter::LiveProjectiles:
+            if (Delta >= 0) { INC_DWORD_STAT_BY(STAT_JoyshipLiveProjectiles, Delta); } else { DEC_DWORD_STAT_BY(STAT_JoyshipLiveProjectiles, -Delta); }
+            break;
+        case ECounter::LiveEnemies:
+            if (Delta >= 0) { INC_DWORD_STAT_BY(STAT_JoyshipLiveEnemies, Delta); } else { DEC_DWORD_STAT_BY(STAT_JoyshipLiveEnemies, -Delta); }
+            break;
+        case ECounter::LiveCollectables:
+            if (Delta >= 0) { INC_DWORD_STAT_BY(STAT_JoyshipLiveCollectables, Delta); } else { DEC_DWORD_STAT_BY(STAT_JoyshipLiveCollectables, -Delta); }
+            break;
+        default: break;
+        }
+    }
+
+    int32 GetCounter(ECounter Counter)
+    {
+        return Counters[(int32)Counter];
+    }
+
+    void EmitFrameStats()
+    {
+        CSV_CUSTOM_STAT(Joyship, LiveProjectiles, Counters[(int32)ECounter::LiveProjectiles], ECsvCustomStatOp::Set);
+        CSV_CUSTOM_STAT(Joyship, LiveEnemies, Counters[(int32)ECounter::LiveEnemies], ECsvCustomStatOp::Set);
+        CSV_CUSTOM_STAT(Joyship, LiveCollectables, Counters[(int32)ECounter::LiveCollectables], ECsvCustomStatOp::Set);
+    }
+}
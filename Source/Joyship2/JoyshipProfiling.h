@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/* ---------------- STATS / TRACE / CSV ---------------- */
+
+// `stat Joyship` shows the cycle counters, live counts and memory below
+DECLARE_STATS_GROUP(TEXT("Joyship"), STATGROUP_Joyship, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ship Tick"), STAT_Joyship_ShipTick, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Tick"), STAT_Joyship_EnemyTick, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Steering"), STAT_Joyship_EnemySteering, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Turret Tick"), STAT_Joyship_TurretTick, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Turret Scan"), STAT_Joyship_TurretScan, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Collectable Tick"), STAT_Joyship_CollectableTick, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fire"), STAT_Joyship_Fire, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Hit"), STAT_Joyship_ProjectileHit, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Simulation"), STAT_Joyship_ProjectileSim, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Damage Resolve"), STAT_Joyship_DamageResolve, STATGROUP_Joyship, JOYSHIP2_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Projectiles"), STAT_JoyshipLiveProjectiles, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Enemies"), STAT_JoyshipLiveEnemies, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Collectables"), STAT_JoyshipLiveCollectables, STATGROUP_Joyship, JOYSHIP2_API);
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Spatial Grid"), STAT_JoyshipSpatialGridMemory, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Enemy Steering Buffers"), STAT_JoyshipSteeringMemory, STATGROUP_Joyship, JOYSHIP2_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Projectile Pool (actors, shallow)"), STAT_JoyshipProjectilePoolMemory, STATGROUP_Joyship, JOYSHIP2_API);
+
+// -csvprofile category: timings from JOYSHIP_TIMING_SCOPE plus per-frame live counts
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(JOYSHIP2_API, Joyship);
+
+/* ---------------- GAMEPLAY TIMING ---------------- */
+
+// Lightweight per-hot-path timers read by the benchmark commandlet. Disabled by default; when disabled a
+// scope costs one branch. Scopes are inclusive (AEnemyShip::Tick includes the ABaseShip::Tick it calls).
+namespace JoyshipProfiling
+{
+    enum class ESlot : uint8
+    {
+        ShipTick,
+        EnemyTick,
+        EnemySteering,
+        TurretTick,
+        TurretScan,
+        CollectableTick,
+        Fire,
+        ProjectileHit,
+        ProjectileSim,
+        DamageResolve,
+        Num
+    };
+
+    struct FSlotTotals
+    {
+        uint64 Cycles = 0;
+        uint64 Calls = 0;
+    };
+
+    JOYSHIP2_API extern bool bEnabled;
+
+    JOYSHIP2_API const TCHAR* GetSlotName(ESlot Slot);
+    JOYSHIP2_API void Reset();
+    JOYSHIP2_API const FSlotTotals& GetTotals(ESlot Slot);
+    JOYSHIP2_API void Accumulate(ESlot Slot, uint64 Cycles);
+
+    enum class ECounter : uint8
+    {
+        LiveProjectiles,
+        LiveEnemies,
+        LiveCollectables,
+        Num
+    };
+
+    // Adjust a live count (also updates the matching STAT_Joyship* accumulator)
+    JOYSHIP2_API void AdjustCounter(ECounter Counter, int32 Delta);
+    JOYSHIP2_API int32 GetCounter(ECounter Counter);
+
+    // Once per frame: push live counts to the CSV profiler
+    JOYSHIP2_API void EmitFrameStats();
+
+    // Game-thread only
+    struct FScope
+    {
+        explicit FScope(ESlot InSlot)
+            : Slot(InSlot)
+            , StartCycles(bEnabled ? FPlatformTime::Cycles64() : 0)
+        {
+        }
+
+        ~FScope()
+        {
+            if (StartCycles)
+            {
+                Accumulate(Slot, FPlatformTime::Cycles64() - StartCycles);
+            }
+        }
+
+        ESlot Slot;
+        uint64 StartCycles;
+    };
+}
+
+// Marks a gameplay hot path for the benchmark timers, `stat Joyship`, Unreal Insights and -csvprofile
+#define JOYSHIP_TIMING_SCOPE(SlotName) \
+    JoyshipProfiling::FScope PREPROCESSOR_JOIN(JoyshipTimingScope_, __LINE__)(JoyshipProfiling::ESlot::SlotName); \
+    SCOPE_CYCLE_COUNTER(STAT_Joyship_##SlotName); \
+    TRACE_CPUPROFILER_EVENT_SCOPE(Joyship_##SlotName); \
+    CSV_SCOPED_TIMING_STAT(Joyship, SlotName)
@@ -1,61 +1,138 @@
 #include "Actors/Collectable.h"
+#include "Joyship2.h"
+#include "JoyshipProfiling.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
 #include "Pawns/PlayerShip.h"
-
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "Subsystems/CollectableSubsystem.h"
+#include "Subsystems/StreamingCellSubsystem.h"
+#include "Net/UnrealNetwork.h"
 
 ACollectable::ACollectable()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // UCollectableSubsystem moves magnetised collectables in one batch
+    PrimaryActorTick.bCanEverTick = false;
 
     MeshComp = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComp"));
     SetRootComponent(MeshComp);
     MeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-    // Start with ticking disabled; the Blueprint should enable/disable magnet by calling ActivateMagnet/DeactivateMagnet
-    SetActorTickEnabled(false);
+    // Idle pickups never change: dormant until magnetised, collected or respawned
+    bReplicates = true;
+    NetDormancy = DORM_Initial;
+}
+
+void ACollectable::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(ACollectable, CachedPlayer);
+    DOREPLIFETIME(ACollectable, bCollected);
+    DOREPLIFETIME(ACollectable, ActiveLocation);
+}
+
+void ACollectable::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    // A placed pickup collected for good before its cell streamed out is not reloaded
+    UStreamingCellSubsystem::DiscardIfConsumed(this);
 }
 
 void ACollectable::BeginPlay()
 {
     Super::BeginPlay();
+
+    HomeTransform = GetActorTransform();
+    ActiveLocation = GetActorLocation();
+
+    JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveCollectables, 1);
+
+    if (UCollectableSubsystem* Collectables = GetWorld() ? GetWorld()->GetSubsystem<UCollectableSubsystem>() : nullptr)
+    {
+        Collectables->NotifyBeginPlay(this);
+    }
+
+    if (UStreamingCellSubsystem* Cells = GetWorld()->GetSubsystem<UStreamingCellSubsystem>())
+    {
+        Cells->AddCellActor(this);
+    }
+
+    if (USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+    {
+        Grid->Register(this, ESpatialGridFlags::Collectable);
+    }
+
+    RegisterInstancedMesh();
 }
 
-void ACollectable::Tick(float DeltaTime)
+void ACollectable::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::Tick(DeltaTime);
+    // Pooled and respawning collectables were already taken off the live count
+    if (PoolState == ECollectableState::Active)
+    {
+        JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveCollectables, -1);
+    }
 
-    if (bCollected) return;
+    if (USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+    {
+        Grid->Unregister(this);
+    }
 
-    // Use per-frame smoothing for smoother movement. Magnet activation enables ticking.
-    if (!CachedPlayer) return;
-    float StepTime = DeltaTime;
+    ReleaseInstancedMesh();
 
-    FVector ToPlayer = CachedPlayer->GetActorLocation() - GetActorLocation();
-    float DistSq = ToPlayer.SizeSquared();
+    if (UCollectableSubsystem* Collectables = GetWorld() ? GetWorld()->GetSubsystem<UCollectableSubsystem>() : nullptr)
+    {
+        Collectables->NotifyEndPlay(this);
+    }
 
-    // If within collect distance and auto-collect is enabled, collect immediately
-    if (bAllowRangeCollect && DistSq <= CollectDistance * CollectDistance)
+    // Pooled without a respawn counts as collected for good; a pending respawn reloads as a fresh pickup
+    if (UStreamingCellSubsystem* Cells = GetWorld() ? GetWorld()->GetSubsystem<UStreamingCellSubsystem>() : nullptr)
     {
-        APlayerShip* PS = Cast<APlayerShip>(CachedPlayer);
-        Collect(PS);
-        return;
+        Cells->RemoveCellActor(this, EndPlayReason, EndPlayReason == EEndPlayReason::Destroyed || PoolState == ECollectableState::Pooled);
     }
-    // If within magnet radius, smoothly move toward the player each frame
-    if (DistSq <= MagnetRadius * MagnetRadius)
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ACollectable::RegisterInstancedMesh()
+{
+    if (!bRenderInstanced || !MeshComp) return;
+
+    UStaticMesh* Mesh = MeshComp->GetStaticMesh();
+    UInstancedMeshSubsystem* Instanced = GetWorld() ? GetWorld()->GetSubsystem<UInstancedMeshSubsystem>() : nullptr;
+    if (!Mesh || !Instanced) return;
+
+    // Instances share the mesh's own materials, so keep per-actor rendering for overridden ones
+    for (int32 i = 0; i < MeshComp->GetNumMaterials(); ++i)
     {
-        float Dist = FMath::Sqrt(DistSq);
-        if (Dist > KINDA_SMALL_NUMBER)
-        {
-            FVector Dir = ToPlayer / Dist;
+        if (MeshComp->GetMaterial(i) != Mesh->GetMaterial(i)) return;
+    }
 
-            // Determine stop distance: if auto-range-collect is disabled, stop at CollectDistance
-            float StopDistance = bAllowRangeCollect ? 0.f : CollectDistance;
-            FVector DesiredLoc = CachedPlayer->GetActorLocation() - Dir * StopDistance;
+    MeshHandle = Instanced->AddInstance(Mesh, MeshComp->GetComponentTransform());
+    if (MeshHandle.IsValid())
+    {
+        // Invisible primitives are not added to the scene, so this drops the per-actor proxy
+        MeshComp->SetVisibility(false);
+    }
+}
 
-            // Smoothly interpolate actor location toward desired location. Use sweep=false to avoid collision jitter.
-            FVector NewLoc = FMath::VInterpTo(GetActorLocation(), DesiredLoc, DeltaTime, AttractionSpeed);
-            SetActorLocation(NewLoc, false);
-        }
+void ACollectable::ReleaseInstancedMesh()
+{
+    if (!MeshHandle.IsValid()) return;
+
+    if (UInstancedMeshSubsystem* Instanced = GetWorld() ? GetWorld()->GetSubsystem<UInstancedMeshSubsystem>() : nullptr)
+    {
+        Instanced->UntrackActor(this);
+        Instanced->RemoveInstance(MeshHandle);
+    }
+    MeshHandle.Reset();
+
+    // Back to per-actor rendering in case re-registering is refused
+    if (MeshComp)
+    {
+        MeshComp->SetVisibility(true);
     }
 }
 
@@ -63,56 +140,172 @@ void ACollectable::Tick(float DeltaTime)
 // ActivateMagnet/DeactivateMagnet and Collect. Definitions removed so Blueprint
 // collision handlers can be used instead.
 
+void ACollectable::StartAttraction()
+{
+    if (UCollectableSubsystem* Collectables = GetWorld()->GetSubsystem<UCollectableSubsystem>())
+    {
+        Collectables->AddMagnet(this, CachedPlayer);
+    }
+
+    // Follow the actor while it is being pulled toward the player
+    if (MeshHandle.IsValid())
+    {
+        if (UInstancedMeshSubsystem* Instanced = GetWorld()->GetSubsystem<UInstancedMeshSubsystem>())
+        {
+            Instanced->TrackActor(this, MeshHandle, MeshComp->GetRelativeTransform());
+        }
+    }
+}
+
+void ACollectable::StopAttraction()
+{
+    if (UCollectableSubsystem* Collectables = GetWorld()->GetSubsystem<UCollectableSubsystem>())
+    {
+        Collectables->RemoveMagnet(this);
+    }
+    if (MeshHandle.IsValid())
+    {
+        if (UInstancedMeshSubsystem* Instanced = GetWorld()->GetSubsystem<UInstancedMeshSubsystem>())
+        {
+            Instanced->UntrackActor(this);
+        }
+    }
+}
+
+void ACollectable::OnRep_CachedPlayer()
+{
+    if (CachedPlayer)
+    {
+        StartAttraction();
+    }
+    else
+    {
+        StopAttraction();
+    }
+}
+
 void ACollectable::ActivateMagnet(APawn* Pawn)
 {
-    if (bCollected) return;
+    if (bCollected || !HasAuthority()) return;
     if (!Pawn) return;
     CachedPlayer = Pawn;
-    TickAccumulator = 0.f;
-    SetActorTickEnabled(true);
-    UE_LOG(LogTemp, Warning, TEXT("[Collectable] ActivateMagnet called for %s"), Pawn ? *Pawn->GetName() : TEXT("None"));
+    StartAttraction();
 
-    // Start a fail-safe timer to ensure collection is attempted after MagnetFailSafeDelay
-    if (MagnetFailSafeDelay > 0.f)
+    if (GetNetMode() != NM_Standalone)
     {
-        GetWorldTimerManager().ClearTimer(MagnetFailSafeTimer);
-        GetWorldTimerManager().SetTimer(MagnetFailSafeTimer, this, &ACollectable::AttemptFailSafeCollect, MagnetFailSafeDelay, false);
+        SetNetDormancy(DORM_Awake);
     }
+    UE_LOG(LogJoyshipPickup, Verbose, TEXT("[Collectable] ActivateMagnet called for %s"), Pawn ? *Pawn->GetName() : TEXT("None"));
 }
 
 void ACollectable::DeactivateMagnet(APawn* Pawn)
 {
-    if (!Pawn) return;
+    if (!Pawn || !HasAuthority()) return;
     if (Pawn == CachedPlayer)
     {
         CachedPlayer = nullptr;
-        SetActorTickEnabled(false);
-        UE_LOG(LogTemp, Warning, TEXT("[Collectable] DeactivateMagnet called for %s"), Pawn ? *Pawn->GetName() : TEXT("None"));
-        // Clear fail-safe timer
-        GetWorldTimerManager().ClearTimer(MagnetFailSafeTimer);
+        StopAttraction();
+
+        // Send the release, then sleep again
+        if (GetNetMode() != NM_Standalone)
+        {
+            FlushNetDormancy();
+            SetNetDormancy(DORM_DormantAll);
+        }
+        UE_LOG(LogJoyshipPickup, Verbose, TEXT("[Collectable] DeactivateMagnet called for %s"), Pawn ? *Pawn->GetName() : TEXT("None"));
     }
 }
 
 void ACollectable::Collect(APlayerShip* Collector)
 {
-    if (bCollected) return;
+    if (bCollected || !HasAuthority()) return;
 
     bCollected = true;
+    StopAttraction();
 
-    UE_LOG(LogTemp, Warning, TEXT("[Collectable] Collected by %s"), Collector ? *Collector->GetName() : TEXT("None"));
+    UE_LOG(LogJoyshipPickup, Verbose, TEXT("[Collectable] Collected by %s"), Collector ? *Collector->GetName() : TEXT("None"));
 
     // Trigger Blueprint hook
     OnCollected(Collector);
 
-    // Default: destroy the actor
+    // The Blueprint hook may have destroyed the actor itself
+    if (IsActorBeingDestroyed()) return;
+
+    // The subsystem pools or destroys it (bReturnToPoolOnCollect)
+    if (UCollectableSubsystem* Collectables = GetWorld()->GetSubsystem<UCollectableSubsystem>())
+    {
+        Collectables->Release(this);
+        return;
+    }
+
+    ReleaseInstancedMesh();
     Destroy();
 }
 
-void ACollectable::AttemptFailSafeCollect()
+/* ---------------- POOLING ---------------- */
+
+void ACollectable::ApplyCollectedState()
 {
-    if (bCollected) return;
-    if (!CachedPlayer) return;
-    APlayerShip* PS = Cast<APlayerShip>(CachedPlayer);
-    UE_LOG(LogTemp, Warning, TEXT("[Collectable] AttemptFailSafeCollect called for %s"), CachedPlayer ? *CachedPlayer->GetName() : TEXT("None"));
-    Collect(PS);
+    SetActorHiddenInGame(bCollected);
+    SetActorEnableCollision(!bCollected);
+
+    // Collected items stay in the grid under their own flag, so pickup queries skip them but the replication
+    // graph still sends their state
+    if (USpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+    {
+        Grid->Unregister(this);
+        Grid->Register(this, bCollected ? ESpatialGridFlags::PooledCollectable : ESpatialGridFlags::Collectable);
+    }
+
+    if (bCollected)
+    {
+        StopAttraction();
+        ReleaseInstancedMesh();
+    }
+    else if (!MeshHandle.IsValid())
+    {
+        RegisterInstancedMesh();
+    }
+}
+
+void ACollectable::DeactivateCollectable()
+{
+    bCollected = true;
+    CachedPlayer = nullptr;
+    ApplyCollectedState();
+
+    JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveCollectables, -1);
+
+    // Send the hidden state, then sleep until reactivated
+    if (GetNetMode() != NM_Standalone)
+    {
+        FlushNetDormancy();
+        SetNetDormancy(DORM_DormantAll);
+    }
+}
+
+void ACollectable::ActivateCollectable(const FTransform& Transform)
+{
+    SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+    ActiveLocation = Transform.GetLocation();
+    bCollected = false;
+    ApplyCollectedState();
+
+    JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveCollectables, 1);
+
+    if (GetNetMode() != NM_Standalone)
+    {
+        FlushNetDormancy();
+    }
+
+    UE_LOG(LogJoyshipPickup, Verbose, TEXT("[Collectable] Activated at %s"), *ActiveLocation.ToString());
+}
+
+void ACollectable::OnRep_Collected()
+{
+    if (!bCollected)
+    {
+        SetActorLocation(ActiveLocation, false, nullptr, ETeleportType::TeleportPhysics);
+    }
+    ApplyCollectedState();
 }
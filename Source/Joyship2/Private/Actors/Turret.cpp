@@ -1,10 +1,19 @@
 #include "Actors/Turret.h"
+#include "JoyshipProfiling.h"
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SceneComponent.h"
 #include "Kismet/GameplayStatics.h"
-#include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/HealthComponent.h"
+#include "Subsystems/AssetPreloadSubsystem.h"
+#include "Subsystems/ProjectileNetSubsystem.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/SimulatedProjectileSubsystem.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "Subsystems/StreamingCellSubsystem.h"
+#include "Subsystems/TickSignificanceSubsystem.h"
+#include "TimerManager.h"
+#include "Net/UnrealNetwork.h"
 
 ATurret::ATurret()
 {
@@ -23,28 +32,308 @@ ATurret::ATurret()
 
     // Health
     UHealthComponent* HealthComp = CreateDefaultSubobject<UHealthComponent>(TEXT("HealthComp"));
+
+    // Health, target and destruction come from the server; turrets never move. Dormant until a target is set.
+    bReplicates = true;
+    NetDormancy = DORM_Initial;
+}
+
+void ATurret::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(ATurret, TargetPawn);
+}
+
+void ATurret::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    // A placed turret destroyed before its cell streamed out stays destroyed
+    if (UStreamingCellSubsystem::DiscardIfConsumed(this)) return;
+
+    UAssetPreloadSubsystem::Preload(this, { ProjectileClass.ToSoftObjectPath() });
 }
 
 void ATurret::BeginPlay()
 {
     Super::BeginPlay();
 
-    if (Trigger)
+    if (UStreamingCellSubsystem* Cells = GetWorld()->GetSubsystem<UStreamingCellSubsystem>())
+    {
+        Cells->AddCellActor(this);
+    }
+
+    CosAimTolerance = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(AimToleranceDegrees, 0.f, 180.f)));
+
+    USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr;
+    if (Grid)
+    {
+        // Size the entry by the aiming body, not the (much larger) trigger box root
+        Grid->Register(this, ESpatialGridFlags::Turret, AimMesh ? AimMesh->Bounds.SphereRadius : 0.f);
+    }
+
+    // Clients only aim at the target the server replicates
+    if (Trigger && HasAuthority())
+    {
+        if (bUseSpatialTargeting && Grid)
+        {
+            // Poll the grid instead of paying for overlap updates every time something moves near the turret
+            Trigger->SetGenerateOverlapEvents(false);
+            GetWorldTimerManager().SetTimer(TargetScanTimer, this, &ATurret::ScanForTarget, FMath::Max(TargetScanInterval, 0.01f), true, FMath::FRand() * TargetScanInterval);
+        }
+        else
+        {
+            Trigger->OnComponentBeginOverlap.AddDynamic(this, &ATurret::OnTriggerBeginOverlap);
+            Trigger->OnComponentEndOverlap.AddDynamic(this, &ATurret::OnTriggerEndOverlap);
+        }
+    }
+
+    // Pre-warm the projectile pool so the first shot does not spawn an actor; a turret spawned during play
+    // usually begins play before its class has loaded, so this waits for the preload
+    if (!ProjectileClass.IsNull() && !bUseSimulatedProjectiles)
+    {
+        UAssetPreloadSubsystem::Preload(this, { ProjectileClass.ToSoftObjectPath() }, FStreamableDelegate::CreateUObject(this, &ATurret::PrewarmProjectilePool));
+    }
+
+    if (UTickSignificanceSubsystem* Significance = GetWorld() ? GetWorld()->GetSubsystem<UTickSignificanceSubsystem>() : nullptr)
+    {
+        Significance->Register(this, [this](ESignificanceTier Tier)
+        {
+            SignificanceTier = Tier;
+            RefreshTickState();
+            RefreshScanRate();
+        });
+    }
+
+    // Sleep (Idle) until something enters the trigger
+    RefreshTickState();
+}
+
+void ATurret::PrewarmProjectilePool()
+{
+    UProjectilePoolSubsystem* Pool = GetWorld() ? GetWorld()->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+    if (Pool && ProjectileClass.Get() && !IsActorBeingDestroyed())
+    {
+        Pool->Prewarm(ProjectileClass.Get(), ProjectilePoolPrewarm);
+    }
+}
+
+void ATurret::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    GetWorldTimerManager().ClearTimer(TargetScanTimer);
+    GetWorldTimerManager().ClearTimer(LockTimer);
+    GetWorldTimerManager().ClearTimer(FireTimer);
+
+    if (USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+    {
+        Grid->Unregister(this);
+    }
+
+    if (UTickSignificanceSubsystem* Significance = GetWorld() ? GetWorld()->GetSubsystem<UTickSignificanceSubsystem>() : nullptr)
+    {
+        Significance->Unregister(this);
+    }
+
+    if (UStreamingCellSubsystem* Cells = GetWorld() ? GetWorld()->GetSubsystem<UStreamingCellSubsystem>() : nullptr)
+    {
+        Cells->RemoveCellActor(this, EndPlayReason, EndPlayReason == EEndPlayReason::Destroyed);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ATurret::ScanForTarget()
+{
+    JOYSHIP_TIMING_SCOPE(TurretScan);
+
+    USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr;
+    if (!Grid || !Trigger) return;
+
+    const FTransform& BoxTransform = Trigger->GetComponentTransform();
+    const FVector Extent = Trigger->GetUnscaledBoxExtent();
+
+    TArray<AActor*> Candidates;
+    Grid->QueryRadius(BoxTransform.GetLocation(), Trigger->GetScaledBoxExtent().Size(), ESpatialGridFlags::Pawn, Candidates, this);
+
+    APawn* NewTarget = nullptr;
+    float BestDistSq = TNumericLimits<float>::Max();
+    for (AActor* Candidate : Candidates)
     {
-        Trigger->OnComponentBeginOverlap.AddDynamic(this, &ATurret::OnTriggerBeginOverlap);
-        Trigger->OnComponentEndOverlap.AddDynamic(this, &ATurret::OnTriggerEndOverlap);
+        APawn* P = Cast<APawn>(Candidate);
+        if (!P) continue;
+
+        // Does the pawn's circle touch the (possibly rotated/scaled) trigger box, as an overlap would report?
+        // The nearest point of the box is found in its local space and measured back in world space.
+        float PawnRadius = 0.f;
+        Grid->GetRadius(P, PawnRadius);
+        const FVector Local = BoxTransform.InverseTransformPosition(P->GetActorLocation());
+        const FVector Nearest = BoxTransform.TransformPosition(Local.BoundToBox(-Extent, Extent));
+        if (FVector::DistSquared(Nearest, P->GetActorLocation()) > PawnRadius * PawnRadius) continue;
+
+        // Keep the current target while it stays inside, like the overlap path did
+        if (P == TargetPawn)
+        {
+            NewTarget = P;
+            break;
+        }
+
+        const float DistSq = FVector::DistSquared(P->GetActorLocation(), BoxTransform.GetLocation());
+        if (DistSq < BestDistSq)
+        {
+            BestDistSq = DistSq;
+            NewTarget = P;
+        }
+    }
+
+    SetTarget(NewTarget);
+}
+
+void ATurret::SetTarget(APawn* NewTarget)
+{
+    // Targeting and firing run on the server; clients draw its fire events
+    if (NewTarget == TargetPawn || !HasAuthority()) return;
+    TargetPawn = NewTarget;
+
+    // Nothing about an idle turret changes, so it stops being considered for replication
+    if (GetNetMode() != NM_Standalone)
+    {
+        if (TargetPawn)
+        {
+            SetNetDormancy(DORM_Awake);
+        }
+        else
+        {
+            FlushNetDormancy();
+            SetNetDormancy(DORM_DormantAll);
+        }
+    }
+
+    // A new target (or none) always restarts the lock-on
+    SetState(TargetPawn ? ETurretState::Tracking : ETurretState::Idle);
+}
+
+void ATurret::OnRep_TargetPawn()
+{
+    // Aim only: lock and fire timers stay on the server
+    State = TargetPawn ? ETurretState::Tracking : ETurretState::Idle;
+    RefreshTickState();
+}
+
+void ATurret::SetState(ETurretState NewState)
+{
+    if (NewState == State) return;
+
+    FTimerManager& Timers = GetWorldTimerManager();
+    if (NewState == ETurretState::Idle || NewState == ETurretState::Tracking)
+    {
+        Timers.ClearTimer(LockTimer);
+        Timers.ClearTimer(FireTimer);
+    }
+    else if (NewState == ETurretState::Locked && State == ETurretState::Tracking)
+    {
+        Timers.SetTimer(FireTimer, this, &ATurret::OnFireTimer, FMath::Max(FireInterval, 0.01f), true);
+    }
+
+    State = NewState;
+    RefreshTickState();
+}
+
+void ATurret::RefreshTickState()
+{
+    const bool bShouldTick = State == ETurretState::Tracking || State == ETurretState::Locked;
+    if (bShouldTick)
+    {
+        const UTickSignificanceSubsystem* Significance = GetWorld() ? GetWorld()->GetSubsystem<UTickSignificanceSubsystem>() : nullptr;
+        SetActorTickInterval(Significance ? Significance->GetTierTickInterval(SignificanceTier) : 0.f);
+    }
+    if (IsActorTickEnabled() != bShouldTick)
+    {
+        SetActorTickEnabled(bShouldTick);
+    }
+}
+
+void ATurret::RefreshScanRate()
+{
+    if (!TargetScanTimer.IsValid()) return;
+
+    // Far-away turrets look for targets less often; the player cannot be inside their trigger anyway
+    float Interval = FMath::Max(TargetScanInterval, 0.01f);
+    if (SignificanceTier == ESignificanceTier::Low || SignificanceTier == ESignificanceTier::Dormant)
+    {
+        const UTickSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UTickSignificanceSubsystem>();
+        Interval = FMath::Max(Interval, Significance ? Significance->GetTierTickInterval(SignificanceTier) : 0.f);
+    }
+    GetWorldTimerManager().SetTimer(TargetScanTimer, this, &ATurret::ScanForTarget, Interval, true, FMath::FRand() * Interval);
+}
+
+void ATurret::OnLockAcquired()
+{
+    if (State == ETurretState::Tracking)
+    {
+        SetState(ETurretState::Locked);
+    }
+}
+
+void ATurret::OnFireTimer()
+{
+    if (State != ETurretState::Locked) return;
+
+    SetState(ETurretState::Firing);
+    FireProjectile();
+    // The shot may have changed state (e.g. target destroyed); only resume if still firing
+    if (State == ETurretState::Firing)
+    {
+        SetState(ETurretState::Locked);
+    }
+}
+
+void ATurret::FireProjectile()
+{
+    UClass* Projectile = ProjectileClass.Get();
+    if (!Projectile || !Muzzle) return;
+
+    UWorld* W = GetWorld();
+    FVector SpawnLoc = Muzzle->GetComponentLocation();
+    FRotator SpawnRot = AimMesh->GetComponentRotation();
+
+    UProjectileNetSubsystem* ProjectileNet = W ? W->GetSubsystem<UProjectileNetSubsystem>() : nullptr;
+    if (ProjectileNet && ProjectileNet->IsNetworked())
+    {
+        FProjectileFireEvent Event;
+        Event.Origin = SpawnLoc;
+        Event.Direction = AimMesh->GetForwardVector();
+        Event.Time = (float)ProjectileNet->GetServerTime();
+        Event.ProjectileClass = Projectile;
+        Event.Shooter = this;
+        ProjectileNet->QueueFireEvent(Event);
+    }
+    USimulatedProjectileSubsystem* Sim = (W && bUseSimulatedProjectiles) ? W->GetSubsystem<USimulatedProjectileSubsystem>() : nullptr;
+    if (!Sim || !Sim->Fire(Projectile, SpawnLoc, AimMesh->GetForwardVector(), this, nullptr))
+    {
+        UProjectilePoolSubsystem* Pool = W ? W->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+        if (Pool)
+        {
+            Pool->SpawnProjectile(Projectile, SpawnLoc, SpawnRot, AimMesh->GetForwardVector(), this, nullptr);
+        }
     }
 }
 
 void ATurret::Tick(float DeltaTime)
 {
+    JOYSHIP_TIMING_SCOPE(TurretTick);
+
     Super::Tick(DeltaTime);
 
-    if (!TargetPawn)
+    if (!IsValid(TargetPawn))
     {
-        // reset timers
-        LookAccum = 0.f;
-        FireAccum = 0.f;
+        // Target gone (destroyed between scans): go back to sleep (and dormant on the server)
+        if (HasAuthority())
+        {
+            SetTarget(nullptr);
+        }
+        TargetPawn = nullptr;
+        SetState(ETurretState::Idle);
         return;
     }
 
@@ -52,56 +341,39 @@ void ATurret::Tick(float DeltaTime)
     FVector AimLoc = AimMesh->GetComponentLocation();
     FVector ToTarget = (TargetLoc - AimLoc).GetSafeNormal();
 
-    // Current forward of AimMesh
-    FVector AimForward = AimMesh->GetForwardVector();
-
-    // Compute desired rotation to look at target (only yaw and pitch if needed)
+    // Interpolate rotation toward the target
     FRotator CurrentRot = AimMesh->GetComponentRotation();
     FRotator TargetRot = ToTarget.Rotation();
-
-    // Interpolate rotation
     FRotator NewRot = FMath::RInterpConstantTo(CurrentRot, TargetRot, DeltaTime, TurnSpeed);
     AimMesh->SetWorldRotation(NewRot);
 
-    // Check angle between forward and target
-    float AngleDeg = FMath::RadiansToDegrees(acosf(FVector::DotProduct(AimMesh->GetForwardVector(), ToTarget)));
-    if (AngleDeg <= AimToleranceDegrees)
+    if (!HasAuthority()) return;
+
+    const bool bOnTarget = FVector::DotProduct(AimMesh->GetForwardVector(), ToTarget) >= CosAimTolerance;
+    FTimerManager& Timers = GetWorldTimerManager();
+
+    if (State == ETurretState::Tracking)
     {
-        LookAccum += DeltaTime;
-        if (LookAccum >= LookTimeRequired)
+        if (!bOnTarget)
+        {
+            Timers.ClearTimer(LockTimer);
+        }
+        else if (!Timers.IsTimerActive(LockTimer))
         {
-            FireAccum += DeltaTime;
-            if (FireAccum >= FireInterval)
+            if (LookTimeRequired > 0.f)
+            {
+                Timers.SetTimer(LockTimer, this, &ATurret::OnLockAcquired, LookTimeRequired, false);
+            }
+            else
             {
-                // Fire
-                if (ProjectileClass && Muzzle)
-                {
-                    UWorld* W = GetWorld();
-                    if (W)
-                    {
-                        FActorSpawnParameters Params;
-                        Params.Owner = this;
-                        FVector SpawnLoc = Muzzle->GetComponentLocation();
-                        FRotator SpawnRot = AimMesh->GetComponentRotation();
-                        AActor* P = W->SpawnActor<AActor>(ProjectileClass, SpawnLoc, SpawnRot, Params);
-                        if (P)
-                        {
-                            UProjectileMovementComponent* PM = P->FindComponentByClass<UProjectileMovementComponent>();
-                            if (PM)
-                            {
-                                PM->Velocity = AimMesh->GetForwardVector() * PM->InitialSpeed;
-                            }
-                        }
-                    }
-                }
-                FireAccum = 0.f;
+                OnLockAcquired();
             }
         }
     }
-    else
+    else if (State == ETurretState::Locked && !bOnTarget)
     {
-        LookAccum = 0.f;
-        FireAccum = 0.f;
+        // Lost the aim: lock on again from scratch
+        SetState(ETurretState::Tracking);
     }
 }
 
@@ -110,7 +382,7 @@ void ATurret::OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor*
     APawn* P = Cast<APawn>(OtherActor);
     if (P)
     {
-        TargetPawn = P;
+        SetTarget(P);
     }
 }
 
@@ -119,6 +391,6 @@ void ATurret::OnTriggerEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* O
     APawn* P = Cast<APawn>(OtherActor);
     if (P && P == TargetPawn)
     {
-        TargetPawn = nullptr;
+        SetTarget(nullptr);
     }
 }
@@ -0,0 +1,614 @@
+#include "Commandlets/JoyshipBenchmarkCommandlet.h"
+#include "Joyship2.h"
+#include "JoyshipProfiling.h"
+#include "JoyshipHeadlessWorld.h"
+#include "Pawns/PlayerShip.h"
+#include "Pawns/EnemyShip.h"
+#include "Actors/Turret.h"
+#include "Actors/Collectable.h"
+#include "Weapons/Projectile.h"
+#include "Subsystems/AssetPreloadSubsystem.h"
+#include "Subsystems/EffectsSubsystem.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/StreamingCellSubsystem.h"
+#include "Replay/ShipInputRecording.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/WorldPartitionStreamingSourceComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectArray.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+
+namespace
+{
+    double ToMs(uint64 Cycles)
+    {
+        return FPlatformTime::ToMilliseconds64(Cycles);
+    }
+
+    // The engine loop normally updates World Partition streaming and pumps async loads (cells, and the preloads
+    // their actors queue); a commandlet world has to do it itself
+    void UpdateStreaming(UWorld* World)
+    {
+        if (UWorldPartitionSubsystem* WorldPartition = World->GetSubsystem<UWorldPartitionSubsystem>())
+        {
+            WorldPartition->UpdateStreamingState();
+        }
+        World->UpdateLevelStreaming();
+        ProcessAsyncLoading(true, false, 0.005);
+    }
+
+    // -SpawnCost's before: the physics work d59c80f's ABaseShip::BeginPlay and AEnemyShip::BeginPlay did after
+    // Super::BeginPlay, copied as it was. Only the three delegate bindings are left out; the current BeginPlay
+    // already makes them, in both passes.
+    void ReplayBaselineBeginPlayPhysics(AEnemyShip* Ship)
+    {
+        UCapsuleComponent* Root = Ship->Root;
+        if (Root)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[BaseShip] BeginPlay: Root=%s Simulating=%s Gravity=%s Mass=%.2f CollisionProfile=%s CollisionEnabled=%d"),
+                *Root->GetName(),
+                Root->IsSimulatingPhysics() ? TEXT("true") : TEXT("false"),
+                Root->IsGravityEnabled() ? TEXT("true") : TEXT("false"),
+                Root->GetMass(),
+                *Root->GetCollisionProfileName().ToString(),
+                (int)Root->GetCollisionEnabled());
+            // Log world gravity
+            if (Ship->GetWorld())
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[BaseShip] World gravity Z=%.2f"), Ship->GetWorld()->GetGravityZ());
+            }
+
+            // List overlapping components (helps detect initial overlap that can block physics)
+            TArray<UPrimitiveComponent*> Overlaps;
+            Root->GetOverlappingComponents(Overlaps);
+            UE_LOG(LogTemp, Warning, TEXT("[BaseShip] BeginPlay: Overlapping components count=%d"), Overlaps.Num());
+            for (UPrimitiveComponent* Comp : Overlaps)
+            {
+                if (Comp)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("[BaseShip]   Overlap: %s (Simulating=%s CollisionEnabled=%d)"), *Comp->GetName(), Comp->IsSimulatingPhysics() ? TEXT("true") : TEXT("false"), (int)Comp->GetCollisionEnabled());
+                }
+            }
+
+            // If blueprint defaults overrode C++ settings, enforce correct physics settings at runtime
+            if (!Root->IsSimulatingPhysics())
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[BaseShip] BeginPlay: Enabling SimulatePhysics on Root"));
+                Root->SetSimulatePhysics(true);
+            }
+            Root->SetEnableGravity(true);
+            Root->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+            Root->SetCollisionProfileName(TEXT("PhysicsActor"));
+            Root->SetMobility(EComponentMobility::Movable);
+
+            // Wake physics and apply a tiny impulse to ensure the body wakes and reacts
+            Root->WakeRigidBody();
+            Root->WakeAllRigidBodies();
+            FVector TinyImpulse = FVector(0.f, 0.f, -5.f) * Root->GetMass();
+            Root->AddImpulse(TinyImpulse);
+            UE_LOG(LogTemp, Warning, TEXT("[BaseShip] BeginPlay: Applied tiny impulse=(%.2f,%.2f,%.2f) to wake body"), TinyImpulse.X, TinyImpulse.Y, TinyImpulse.Z);
+
+            // Bind overlap handler
+            Root->SetGenerateOverlapEvents(true);
+            // Bind hit handler for blocking collisions
+            Root->SetNotifyRigidBodyCollision(true);
+
+            // Log overlap-related settings for debugging
+            UE_LOG(LogTemp, Warning, TEXT("[BaseShip] Overlap settings: GenerateOverlapEvents=%d CollisionEnabled=%d ObjectType=%d Response_WorldDynamic=%d Response_PhysicsBody=%d Response_Pawn=%d"),
+                Root->GetGenerateOverlapEvents(),
+                (int)Root->GetCollisionEnabled(),
+                (int)Root->GetCollisionObjectType(),
+                (int)Root->GetCollisionResponseToChannel(ECC_WorldDynamic),
+                (int)Root->GetCollisionResponseToChannel(ECC_PhysicsBody),
+                (int)Root->GetCollisionResponseToChannel(ECC_Pawn));
+        }
+
+        // Reinforce gravity disable in case Blueprints or defaults changed it
+        if (Root)
+        {
+            Root->SetEnableGravity(false);
+        }
+    }
+}
+
+UJoyshipBenchmarkCommandlet::UJoyshipBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UJoyshipBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 NumEnemies = 200;
+    int32 NumTurrets = 50;
+    int32 NumCollectables = 300;
+    int32 NumFrames = 1800;
+    int32 WarmupFrames = 60;
+    int32 GCInterval = 600;
+    int32 Seed = 1;
+    float DeltaTime = 1.f / 60.f;
+    float FireInterval = 0.25f;
+    FString MapPath;
+    FString ReplayPath;
+    FString OutputBase = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("JoyshipBenchmark");
+
+    FParse::Value(*Params, TEXT("Enemies="), NumEnemies);
+    FParse::Value(*Params, TEXT("Turrets="), NumTurrets);
+    FParse::Value(*Params, TEXT("Collectables="), NumCollectables);
+    FParse::Value(*Params, TEXT("Frames="), NumFrames);
+    FParse::Value(*Params, TEXT("WarmupFrames="), WarmupFrames);
+    FParse::Value(*Params, TEXT("GCInterval="), GCInterval);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+    FParse::Value(*Params, TEXT("FireInterval="), FireInterval);
+    FParse::Value(*Params, TEXT("Map="), MapPath);
+    FParse::Value(*Params, TEXT("Output="), OutputBase);
+    FParse::Value(*Params, TEXT("Replay="), ReplayPath);
+    const bool bFailOnSyncLoad = FParse::Param(*Params, TEXT("FailOnSyncLoad"));
+
+    const TSubclassOf<AEnemyShip> EnemyClass = ParseClassParam<AEnemyShip>(Params, TEXT("EnemyClass="), AEnemyShip::StaticClass());
+    const TSubclassOf<ATurret> TurretClass = ParseClassParam<ATurret>(Params, TEXT("TurretClass="), ATurret::StaticClass());
+    const TSubclassOf<ACollectable> CollectableClass = ParseClassParam<ACollectable>(Params, TEXT("CollectableClass="), ACollectable::StaticClass());
+    const TSubclassOf<AActor> ProjectileClass = ParseClassParam<AActor>(Params, TEXT("ProjectileClass="), AProjectile::StaticClass());
+
+    if (FParse::Param(*Params, TEXT("SpawnCost")))
+    {
+        return RunSpawnCost(Params, MapPath, EnemyClass, ProjectileClass, OutputBase);
+    }
+
+    FShipInputRecording Recording;
+    const bool bReplay = !ReplayPath.IsEmpty();
+    if (bReplay)
+    {
+        if (!Recording.LoadFromFile(APlayerShip::GetReplayPath(ReplayPath)) || Recording.Frames.Num() == 0)
+        {
+            UE_LOG(LogJoyship, Error, TEXT("[Benchmark] Could not load replay %s"), *ReplayPath);
+            return 1;
+        }
+        NumFrames = Recording.Frames.Num();
+        // Replay in the recorded map unless one was given
+        if (MapPath.IsEmpty() && FPackageName::DoesPackageExist(Recording.MapName))
+        {
+            MapPath = Recording.MapName;
+        }
+    }
+
+    DeltaTime = FMath::Max(DeltaTime, 0.0001f);
+    NumFrames = FMath::Max(NumFrames, 1);
+
+    const FPlatformMemoryStats MemBefore = FPlatformMemory::GetStats();
+    const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+    UWorld* World = JoyshipHeadlessWorld::Create(MapPath, TEXT("JoyshipBenchmark"));
+    if (!World)
+    {
+        UE_LOG(LogJoyship, Error, TEXT("[Benchmark] Failed to create world"));
+        return 1;
+    }
+    // The recorded inputs only reproduce the session against the level they were recorded in
+    if (bReplay && !Recording.MatchesWorld(World))
+    {
+        UE_LOG(LogJoyship, Error, TEXT("[Benchmark] Replay %s was recorded in %s, not %s"), *ReplayPath, *Recording.MapName, *World->GetOutermost()->GetName());
+        JoyshipHeadlessWorld::Destroy(World);
+        return 1;
+    }
+
+    FRandomStream Rng(Seed);
+    FMath::RandInit(Seed);
+
+    /* ---------------- SPAWN ---------------- */
+
+    const double SpawnStart = FPlatformTime::Seconds();
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    // The player is kept still at the origin so every run sees the same layout (a replay flies it from its recorded start)
+    const FTransform PlayerStart = bReplay ? FTransform(Recording.StartRotation, Recording.StartLocation) : FTransform::Identity;
+    APlayerShip* Player = World->SpawnActor<APlayerShip>(APlayerShip::StaticClass(), PlayerStart, SpawnParams);
+    if (Player && Player->Root && !bReplay)
+    {
+        Player->Root->SetEnableGravity(false);
+    }
+
+    // No player controller here, so the ship itself drives cell streaming in a World Partition map
+    const bool bStreaming = World->IsPartitionedWorld();
+    if (bStreaming)
+    {
+        if (Player)
+        {
+            Player->AddComponentByClass(UWorldPartitionStreamingSourceComponent::StaticClass(), false, FTransform::Identity, false);
+        }
+        UpdateStreaming(World);
+        World->BlockTillLevelStreamingCompleted();
+    }
+
+    // Weak: enemies and collectables can be destroyed (and garbage collected) mid-run
+    TArray<TWeakObjectPtr<AEnemyShip>> Enemies;
+    for (int32 i = 0; i < NumEnemies; ++i)
+    {
+        AEnemyShip* Enemy = World->SpawnActorDeferred<AEnemyShip>(EnemyClass, FTransform(RandomPlanePoint(Rng, 1000.f, 6000.f)), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        if (!Enemy) continue;
+        if (Enemy->ProjectileClass.IsNull())
+        {
+            Enemy->ProjectileClass = ProjectileClass.Get();
+        }
+        Enemy->FinishSpawning(Enemy->GetTransform());
+        if (Player)
+        {
+            Enemy->StartFollowing(Player);
+        }
+        Enemies.Add(Enemy);
+    }
+
+    int32 TurretsSpawned = 0;
+    for (int32 i = 0; i < NumTurrets; ++i)
+    {
+        ATurret* Turret = World->SpawnActorDeferred<ATurret>(TurretClass, FTransform(RandomPlanePoint(Rng, 500.f, 5000.f)), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        if (!Turret) continue;
+        if (Turret->ProjectileClass.IsNull())
+        {
+            Turret->ProjectileClass = ProjectileClass.Get();
+        }
+        // Large trigger so turrets keep finding ships to shoot at
+        if (Turret->Trigger)
+        {
+            Turret->Trigger->SetBoxExtent(FVector(200.f, 1500.f, 1500.f), false);
+        }
+        Turret->FinishSpawning(Turret->GetTransform());
+        ++TurretsSpawned;
+    }
+
+    TArray<TWeakObjectPtr<ACollectable>> Collectables;
+    for (int32 i = 0; i < NumCollectables; ++i)
+    {
+        ACollectable* Collectable = World->SpawnActor<ACollectable>(CollectableClass, FTransform(RandomPlanePoint(Rng, 200.f, 4000.f)), SpawnParams);
+        if (Collectable)
+        {
+            Collectables.Add(Collectable);
+        }
+    }
+
+    // Nothing pumps async loads in a commandlet: finish the spawned actors' preloads before the run
+    FlushAsyncLoading();
+
+    const double SpawnMs = (FPlatformTime::Seconds() - SpawnStart) * 1000.0;
+
+    /* ---------------- RUN ---------------- */
+
+    const int32 FireEveryFrames = FMath::Max(1, FMath::RoundToInt(FireInterval / DeltaTime));
+    // Magnetise collectables gradually so pickups happen throughout the run
+    const int32 MagnetsPerFrame = Collectables.Num() > 0 ? FMath::Max(1, FMath::DivideAndRoundUp(Collectables.Num(), NumFrames)) : 0;
+    int32 NextMagnet = 0;
+    int64 ShotsFired = 0;
+    uint64 GCCycles = 0;
+    uint64 FrameCycles = 0;
+    uint64 WorstFrameCycles = 0;
+
+    auto RunFrame = [&](int32 Frame, float FrameDeltaTime)
+    {
+        ++GFrameCounter;
+        World->Tick(LEVELTICK_All, FrameDeltaTime);
+        if (bStreaming)
+        {
+            UpdateStreaming(World);
+        }
+
+        for (int32 i = 0; i < Enemies.Num(); ++i)
+        {
+            AEnemyShip* Enemy = Enemies[i].Get();
+            if ((i + Frame) % FireEveryFrames == 0 && Enemy)
+            {
+                Enemy->Fire();
+                ++ShotsFired;
+            }
+        }
+
+        for (int32 m = 0; m < MagnetsPerFrame && NextMagnet < Collectables.Num(); ++m, ++NextMagnet)
+        {
+            ACollectable* Collectable = Collectables[NextMagnet].Get();
+            if (Player && Collectable)
+            {
+                Collectable->ActivateMagnet(Player);
+            }
+        }
+
+        if (GCInterval > 0 && Frame > 0 && Frame % GCInterval == 0)
+        {
+            const uint64 GCStart = FPlatformTime::Cycles64();
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            GCCycles += FPlatformTime::Cycles64() - GCStart;
+        }
+    };
+
+    for (int32 Frame = 0; Frame < WarmupFrames; ++Frame)
+    {
+        RunFrame(Frame, DeltaTime);
+    }
+
+    // Warmup holds the player still; the recorded session starts with the timed run
+    if (bReplay && Player)
+    {
+        Player->StartInputReplay(Recording);
+    }
+
+    UProjectilePoolSubsystem* Pool = World->GetSubsystem<UProjectilePoolSubsystem>();
+    if (Pool)
+    {
+        Pool->ResetStats();
+    }
+    UEffectsSubsystem* Effects = World->GetSubsystem<UEffectsSubsystem>();
+    if (Effects)
+    {
+        Effects->ResetStats();
+    }
+    UStreamingCellSubsystem* Cells = World->GetSubsystem<UStreamingCellSubsystem>();
+    if (Cells)
+    {
+        Cells->ResetPeaks();
+    }
+    ShotsFired = 0;
+    GCCycles = 0;
+    uint64 RunPeakUsedPhysical = 0;
+
+    JoyshipProfiling::Reset();
+    JoyshipProfiling::bEnabled = true;
+
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        const uint64 Start = FPlatformTime::Cycles64();
+        RunFrame(WarmupFrames + Frame, bReplay ? Recording.Frames[Frame].DeltaTime : DeltaTime);
+        const uint64 Cycles = FPlatformTime::Cycles64() - Start;
+        FrameCycles += Cycles;
+        WorstFrameCycles = FMath::Max(WorstFrameCycles, Cycles);
+
+        // Outside the timed frame; cells loading and unloading along the path move this around
+        if (Frame % 30 == 0)
+        {
+            RunPeakUsedPhysical = FMath::Max<uint64>(RunPeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+        }
+    }
+
+    JoyshipProfiling::bEnabled = false;
+
+    /* ---------------- REPORT ---------------- */
+
+    int32 LiveEnemies = 0;
+    int32 LiveCollectables = 0;
+    int32 ProjectileActors = 0;
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        if (It->IsA<AEnemyShip>()) ++LiveEnemies;
+        else if (const ACollectable* Collectable = Cast<ACollectable>(*It)) LiveCollectables += Collectable->IsCollected() ? 0 : 1;
+        else if (It->IsA(ProjectileClass)) ++ProjectileActors;
+    }
+
+    const FProjectilePoolStats PoolStats = Pool ? Pool->GetTotalStats() : FProjectilePoolStats();
+    const FStreamingCellStats CellStats = Cells ? Cells->GetStats() : FStreamingCellStats();
+    const UAssetPreloadSubsystem* Preloader = World->GetSubsystem<UAssetPreloadSubsystem>();
+    const int32 SyncLoads = Preloader ? Preloader->GetNumSyncLoadsDuringPlay() : 0;
+    const FPlatformMemoryStats MemAfter = FPlatformMemory::GetStats();
+    const int32 ObjectsAfter = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+    TArray<TPair<FString, double>> Metrics;
+    Metrics.Emplace(TEXT("Frames"), NumFrames);
+    Metrics.Emplace(TEXT("DeltaTime"), DeltaTime);
+    Metrics.Emplace(TEXT("Seed"), Seed);
+    Metrics.Emplace(TEXT("Replay.Seed"), bReplay ? Recording.RandomSeed : 0);
+    Metrics.Emplace(TEXT("Replay.Seconds"), bReplay ? Recording.GetDuration() : 0.f);
+    Metrics.Emplace(TEXT("SpawnMs"), SpawnMs);
+    Metrics.Emplace(TEXT("FrameMsAvg"), ToMs(FrameCycles) / NumFrames);
+    Metrics.Emplace(TEXT("FrameMsWorst"), ToMs(WorstFrameCycles));
+    Metrics.Emplace(TEXT("GCMsTotal"), ToMs(GCCycles));
+
+    for (int32 SlotIndex = 0; SlotIndex < (int32)JoyshipProfiling::ESlot::Num; ++SlotIndex)
+    {
+        const JoyshipProfiling::ESlot Slot = (JoyshipProfiling::ESlot)SlotIndex;
+        const JoyshipProfiling::FSlotTotals& Totals = JoyshipProfiling::GetTotals(Slot);
+        const FString Name = JoyshipProfiling::GetSlotName(Slot);
+        Metrics.Emplace(Name + TEXT(".MsPerFrame"), ToMs(Totals.Cycles) / NumFrames);
+        Metrics.Emplace(Name + TEXT(".Calls"), (double)Totals.Calls);
+    }
+
+    Metrics.Emplace(TEXT("Spawned.Enemies"), Enemies.Num());
+    Metrics.Emplace(TEXT("Spawned.Turrets"), TurretsSpawned);
+    Metrics.Emplace(TEXT("Spawned.Collectables"), Collectables.Num());
+    Metrics.Emplace(TEXT("Live.Enemies"), LiveEnemies);
+    Metrics.Emplace(TEXT("Live.Collectables"), LiveCollectables);
+    Metrics.Emplace(TEXT("Projectiles.ShotsFired"), (double)ShotsFired);
+    Metrics.Emplace(TEXT("Projectiles.Actors"), ProjectileActors);
+    Metrics.Emplace(TEXT("Projectiles.PoolHits"), PoolStats.Hits);
+    Metrics.Emplace(TEXT("Projectiles.PoolMisses"), PoolStats.Misses);
+    Metrics.Emplace(TEXT("Projectiles.HighWaterMark"), PoolStats.HighWaterMark);
+
+    Metrics.Emplace(TEXT("Effects.Culled"), Effects ? Effects->NumCulled : 0);
+    Metrics.Emplace(TEXT("Effects.Merged"), Effects ? Effects->NumMerged : 0);
+    Metrics.Emplace(TEXT("Effects.OverBudget"), Effects ? Effects->NumOverBudget : 0);
+
+    Metrics.Emplace(TEXT("Streaming.Partitioned"), bStreaming ? 1 : 0);
+    Metrics.Emplace(TEXT("Streaming.PeakActors"), CellStats.PeakActors);
+    Metrics.Emplace(TEXT("Streaming.PeakLoadedCells"), CellStats.PeakLoadedCells);
+    Metrics.Emplace(TEXT("Streaming.LoadedCellsAfter"), CellStats.LoadedCells);
+    Metrics.Emplace(TEXT("Streaming.StreamedOut"), CellStats.StreamedOut);
+    Metrics.Emplace(TEXT("Streaming.Consumed"), CellStats.Consumed);
+
+    Metrics.Emplace(TEXT("Loading.SyncLoadsDuringPlay"), SyncLoads);
+    Metrics.Emplace(TEXT("Loading.MapLoadWaitMs"), Preloader ? Preloader->GetMapLoadWaitSeconds() * 1000.0 : 0.0);
+
+    Metrics.Emplace(TEXT("Memory.UsedPhysicalMBBefore"), MemBefore.UsedPhysical / (1024.0 * 1024.0));
+    Metrics.Emplace(TEXT("Memory.UsedPhysicalMBAfter"), MemAfter.UsedPhysical / (1024.0 * 1024.0));
+    Metrics.Emplace(TEXT("Memory.PeakUsedPhysicalMB"), MemAfter.PeakUsedPhysical / (1024.0 * 1024.0));
+    Metrics.Emplace(TEXT("Memory.RunPeakUsedPhysicalMB"), RunPeakUsedPhysical / (1024.0 * 1024.0));
+    Metrics.Emplace(TEXT("Memory.UObjectsBefore"), ObjectsBefore);
+    Metrics.Emplace(TEXT("Memory.UObjectsAfter"), ObjectsAfter);
+
+    // JSON: flat metric map plus the run settings
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("Map"), MapPath.IsEmpty() ? TEXT("<generated>") : MapPath);
+    Root->SetStringField(TEXT("Replay"), ReplayPath);
+    Root->SetStringField(TEXT("EnemyClass"), EnemyClass->GetPathName());
+    Root->SetStringField(TEXT("TurretClass"), TurretClass->GetPathName());
+    Root->SetStringField(TEXT("CollectableClass"), CollectableClass->GetPathName());
+    Root->SetStringField(TEXT("ProjectileClass"), ProjectileClass->GetPathName());
+    const bool bWrote = WriteResults(OutputBase, Root, Metrics);
+
+    UE_LOG(LogJoyship, Display, TEXT("[Benchmark] %d frames, avg %.3f ms, worst %.3f ms, %lld shots. Results: %s.{json,csv}"),
+        NumFrames, ToMs(FrameCycles) / NumFrames, ToMs(WorstFrameCycles), ShotsFired, *OutputBase);
+
+    // Gate: any synchronous load after BeginPlay is a hitch
+    bool bSyncLoadFailed = false;
+    if (bFailOnSyncLoad && SyncLoads > 0)
+    {
+        for (const FString& Package : Preloader->GetSyncLoadedPackages())
+        {
+            UE_LOG(LogJoyship, Error, TEXT("[Benchmark] Synchronous load during play: %s"), *Package);
+        }
+        UE_LOG(LogJoyship, Error, TEXT("[Benchmark] %d synchronous loads during play"), SyncLoads);
+        bSyncLoadFailed = true;
+    }
+
+    JoyshipHeadlessWorld::Destroy(World);
+
+    return (bWrote && !bSyncLoadFailed) ? 0 : 1;
+}
+
+FVector UJoyshipBenchmarkCommandlet::RandomPlanePoint(FRandomStream& Rng, float MinRadius, float MaxRadius)
+{
+    const float Angle = Rng.FRandRange(0.f, 2.f * PI);
+    const float Radius = Rng.FRandRange(MinRadius, MaxRadius);
+    return FVector(0.f, FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius);
+}
+
+bool UJoyshipBenchmarkCommandlet::WriteResults(const FString& OutputBase, const TSharedRef<FJsonObject>& Root, const TArray<TPair<FString, double>>& Metrics)
+{
+    TSharedRef<FJsonObject> MetricsObject = MakeShared<FJsonObject>();
+    for (const TPair<FString, double>& Metric : Metrics)
+    {
+        MetricsObject->SetNumberField(Metric.Key, Metric.Value);
+    }
+    Root->SetObjectField(TEXT("Metrics"), MetricsObject);
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Root, Writer);
+
+    // CSV: one Metric,Value row per metric so a gate can diff runs line by line
+    FString Csv = TEXT("Metric,Value\n");
+    for (const TPair<FString, double>& Metric : Metrics)
+    {
+        Csv += FString::Printf(TEXT("%s,%.6f\n"), *Metric.Key, Metric.Value);
+    }
+
+    const bool bWroteJson = FFileHelper::SaveStringToFile(Json, *(OutputBase + TEXT(".json")));
+    const bool bWroteCsv = FFileHelper::SaveStringToFile(Csv, *(OutputBase + TEXT(".csv")));
+    return bWroteJson && bWroteCsv;
+}
+
+int32 UJoyshipBenchmarkCommandlet::RunSpawnCost(const FString& Params, const FString& MapPath, TSubclassOf<AEnemyShip> EnemyClass, TSubclassOf<AActor> ProjectileClass, const FString& OutputBase)
+{
+    int32 NumSpawns = 500;
+    int32 WarmupSpawns = 10;
+    int32 Seed = 1;
+    FParse::Value(*Params, TEXT("Spawns="), NumSpawns);
+    FParse::Value(*Params, TEXT("WarmupSpawns="), WarmupSpawns);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    NumSpawns = FMath::Max(NumSpawns, 1);
+
+    TArray<TPair<FString, double>> Metrics;
+    Metrics.Emplace(TEXT("Spawns"), NumSpawns);
+
+    // Fixup: every spawn also runs the baseline BeginPlay physics work (ReplayBaselineBeginPlayPhysics); Fast: the
+    // current BeginPlay alone. Each round is a fresh world and the order is Fixup, Fast, Fast, Fixup, so neither pass
+    // always gets the cold caches.
+    constexpr int32 NumPasses = 2;
+    const TCHAR* PassNames[NumPasses] = { TEXT("Fixup"), TEXT("Fast") };
+    const int32 RoundPasses[] = { 0, 1, 1, 0 };
+    constexpr int32 RoundsPerPass = 2;
+    uint64 PassTotalCycles[NumPasses] = {};
+    uint64 PassWorstCycles[NumPasses] = {};
+    for (const int32 Pass : RoundPasses)
+    {
+        UWorld* World = JoyshipHeadlessWorld::Create(MapPath, TEXT("JoyshipBenchmark"));
+        if (!World)
+        {
+            UE_LOG(LogJoyship, Error, TEXT("[Benchmark] Failed to create world"));
+            return 1;
+        }
+
+        FRandomStream Rng(Seed);
+        for (int32 i = 0; i < WarmupSpawns + NumSpawns; ++i)
+        {
+            const FTransform Transform(RandomPlanePoint(Rng, 1000.f, 6000.f));
+            const uint64 Start = FPlatformTime::Cycles64();
+
+            AEnemyShip* Enemy = World->SpawnActorDeferred<AEnemyShip>(EnemyClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+            if (Enemy)
+            {
+                if (Enemy->ProjectileClass.IsNull())
+                {
+                    Enemy->ProjectileClass = ProjectileClass.Get();
+                }
+                Enemy->FinishSpawning(Transform);
+                if (Pass == 0)
+                {
+                    ReplayBaselineBeginPlayPhysics(Enemy);
+                }
+            }
+
+            // Warmup spawns pay the one-off costs (class validation, pool prewarm, first allocations)
+            if (i < WarmupSpawns) continue;
+            const uint64 Cycles = FPlatformTime::Cycles64() - Start;
+            PassTotalCycles[Pass] += Cycles;
+            PassWorstCycles[Pass] = FMath::Max(PassWorstCycles[Pass], Cycles);
+        }
+
+        JoyshipHeadlessWorld::Destroy(World);
+    }
+
+    double PassTotalMs[NumPasses] = {};
+    for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+    {
+        // Per round, so the totals stay comparable with a single-round run
+        PassTotalMs[Pass] = ToMs(PassTotalCycles[Pass]) / RoundsPerPass;
+        const FString Prefix = FString::Printf(TEXT("SpawnCost.%s."), PassNames[Pass]);
+        Metrics.Emplace(Prefix + TEXT("MsTotal"), PassTotalMs[Pass]);
+        Metrics.Emplace(Prefix + TEXT("MsAvg"), PassTotalMs[Pass] / NumSpawns);
+        Metrics.Emplace(Prefix + TEXT("MsWorst"), ToMs(PassWorstCycles[Pass]));
+        UE_LOG(LogJoyship, Display, TEXT("[Benchmark] %s: %d AEnemyShip spawns per round, %.3f ms total, %.4f ms avg, %.4f ms worst"),
+            PassNames[Pass], NumSpawns, PassTotalMs[Pass], PassTotalMs[Pass] / NumSpawns, ToMs(PassWorstCycles[Pass]));
+    }
+
+    Metrics.Emplace(TEXT("SpawnCost.Speedup"), PassTotalMs[1] > 0.0 ? PassTotalMs[0] / PassTotalMs[1] : 0.0);
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("Mode"), TEXT("SpawnCost"));
+    Root->SetStringField(TEXT("Map"), MapPath.IsEmpty() ? TEXT("<generated>") : MapPath);
+    Root->SetStringField(TEXT("EnemyClass"), EnemyClass->GetPathName());
+    Root->SetStringField(TEXT("ProjectileClass"), ProjectileClass->GetPathName());
+    return WriteResults(OutputBase, Root, Metrics) ? 0 : 1;
+}
+
+UClass* UJoyshipBenchmarkCommandlet::ParseClassParam(const FString& Params, const TCHAR* Name, UClass* BaseClass, UClass* Default)
+{
+    FString Path;
+    if (FParse::Value(*Params, Name, Path))
+    {
+        if (UClass* Loaded = StaticLoadClass(BaseClass, nullptr, *Path))
+        {
+            return Loaded;
+        }
+        UE_LOG(LogJoyship, Warning, TEXT("[Benchmark] Could not load class %s, using %s"), *Path, *Default->GetName());
+    }
+    return Default;
+}
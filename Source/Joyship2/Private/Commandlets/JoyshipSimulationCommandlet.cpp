@@ -0,0 +1,565 @@
+#include "Commandlets/JoyshipSimulationCommandlet.h"
+#include "Joyship2.h"
+#include "JoyshipHeadlessWorld.h"
+#include "Pawns/PlayerShip.h"
+#include "Pawns/EnemyShip.h"
+#include "Actors/Turret.h"
+#include "Actors/Collectable.h"
+#include "Weapons/Projectile.h"
+#include "Components/HealthComponent.h"
+#include "Components/BoxComponent.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/CollectableSubsystem.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "Subsystems/SimulatedProjectileSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+
+namespace
+{
+    // Project asset when it exists (the classes designers balance), native class otherwise
+    UClass* LoadDefaultClass(UClass* BaseClass, const TCHAR* Path)
+    {
+        UClass* Loaded = StaticLoadClass(BaseClass, nullptr, Path, nullptr, LOAD_NoWarn | LOAD_Quiet);
+        return Loaded ? Loaded : BaseClass;
+    }
+
+    // Set a float property by name (works for Blueprint variables and protected C++ properties alike)
+    void OverrideFloat(UObject* Object, const TCHAR* PropertyName, const FString& Params, const TCHAR* ParamName)
+    {
+        float Value = 0.f;
+        if (!Object || !FParse::Value(*Params, ParamName, Value)) return;
+
+        if (FFloatProperty* Property = FindFProperty<FFloatProperty>(Object->GetClass(), PropertyName))
+        {
+            Property->SetPropertyValue_InContainer(Object, Value);
+        }
+        else
+        {
+            UE_LOG(LogJoyship, Warning, TEXT("[Simulation] %s has no float property %s"), *Object->GetClass()->GetName(), PropertyName);
+        }
+    }
+
+    struct FBotSettings
+    {
+        float FireInterval = 0.3f;
+        float FireRange = 4000.f;
+        float SearchRadius = 8000.f;
+        float PickupRadius = 600.f;
+        float RefuelFraction = 0.4f;
+    };
+
+    struct FBotState
+    {
+        FVector Home = FVector::ZeroVector;
+        float StartFuel = 0.f;
+        float TimeSinceFire = 0.f;
+    };
+
+    // Flies the player like a simple human would: refuel when low, otherwise close in on the nearest damageable
+    // actor and shoot when lined up. Input goes through the same calls the input bindings use.
+    void DriveBot(APlayerShip* Player, USpatialGridSubsystem* Grid, const FBotSettings& Settings, FBotState& State, float DeltaTime)
+    {
+        const FVector Location = Player->GetActorLocation();
+        State.TimeSinceFire += DeltaTime;
+
+        AActor* Target = nullptr;
+        bool bHostile = false;
+        if (Grid)
+        {
+            const bool bNeedFuel = State.StartFuel > 0.f && Player->GetCurrentFuel() < State.StartFuel * Settings.RefuelFraction;
+
+            TArray<AActor*> Candidates;
+            if (bNeedFuel)
+            {
+                Grid->QueryRadius(Location, Settings.SearchRadius, ESpatialGridFlags::Collectable, Candidates, Player);
+            }
+            if (Candidates.Num() == 0)
+            {
+                Grid->QueryRadius(Location, Settings.SearchRadius, ESpatialGridFlags::Damageable, Candidates, Player);
+                bHostile = true;
+            }
+
+            float BestDistSq = TNumericLimits<float>::Max();
+            for (AActor* Candidate : Candidates)
+            {
+                const float DistSq = FVector::DistSquared(Candidate->GetActorLocation(), Location);
+                if (DistSq < BestDistSq)
+                {
+                    BestDistSq = DistSq;
+                    Target = Candidate;
+                }
+            }
+        }
+
+        const FVector TargetLocation = Target ? Target->GetActorLocation() : State.Home;
+        FVector ToTarget = TargetLocation - Location;
+        ToTarget.X = 0.f;
+        const float Distance = ToTarget.Size();
+        FVector Dir = Distance > KINDA_SMALL_NUMBER ? ToTarget / Distance : FVector::UpVector;
+
+        // Falling fast: bias toward climbing so the bot does not just drop out of the level
+        if (Player->Velocity.Z < -400.f)
+        {
+            Dir = (Dir + FVector::UpVector).GetSafeNormal();
+        }
+
+        if (!bHostile && Target && Distance < Settings.PickupRadius)
+        {
+            if (ACollectable* Collectable = Cast<ACollectable>(Target))
+            {
+                Collectable->ActivateMagnet(Player);
+            }
+        }
+
+        // Input +1 turns the thrust axis (Up) away from Forward x Up; steer so it swings toward Dir
+        const FVector Up = Player->GetActorUpVector();
+        const float Side = FVector::DotProduct(FVector::CrossProduct(Player->GetActorForwardVector(), Up), Dir);
+        const float Facing = FVector::DotProduct(Up, Dir);
+        float Rotate = FMath::Clamp(-Side * 4.f, -1.f, 1.f);
+        if (Facing < 0.f && FMath::Abs(Rotate) < 0.5f)
+        {
+            Rotate = Rotate < 0.f ? -1.f : 1.f;
+        }
+        Player->RotateInput(Rotate);
+
+        if (Facing > 0.6f)
+        {
+            Player->StartThrust();
+        }
+        else
+        {
+            Player->StopThrust();
+        }
+
+        if (bHostile && Target && Facing > 0.97f && Distance < Settings.FireRange && State.TimeSinceFire >= Settings.FireInterval)
+        {
+            Player->Fire();
+            State.TimeSinceFire = 0.f;
+        }
+    }
+}
+
+/* ---------------- SESSION RESULTS ---------------- */
+
+const TCHAR* FJoyshipSimulationSession::CsvHeader()
+{
+    return TEXT("Session,Seed,SimSeconds,Died,TimeToDeath,FuelConsumed,PlayerShots,TotalShots,Kills,Pickups,WallSeconds");
+}
+
+FString FJoyshipSimulationSession::ToCsvRow() const
+{
+    return FString::Printf(TEXT("%d,%d,%.4f,%d,%.4f,%.4f,%d,%d,%d,%d,%.4f"),
+        Index, Seed, SimSeconds, bPlayerDied ? 1 : 0, TimeToDeath, FuelConsumed, PlayerShots, TotalShots, Kills, Pickups, WallSeconds);
+}
+
+bool FJoyshipSimulationSession::FromCsvRow(const FString& Row)
+{
+    TArray<FString> Fields;
+    if (Row.ParseIntoArray(Fields, TEXT(","), false) != 11 || !Fields[0].IsNumeric()) return false;
+
+    Index = FCString::Atoi(*Fields[0]);
+    Seed = FCString::Atoi(*Fields[1]);
+    SimSeconds = FCString::Atof(*Fields[2]);
+    bPlayerDied = FCString::Atoi(*Fields[3]) != 0;
+    TimeToDeath = FCString::Atof(*Fields[4]);
+    FuelConsumed = FCString::Atof(*Fields[5]);
+    PlayerShots = FCString::Atoi(*Fields[6]);
+    TotalShots = FCString::Atoi(*Fields[7]);
+    Kills = FCString::Atoi(*Fields[8]);
+    Pickups = FCString::Atoi(*Fields[9]);
+    WallSeconds = FCString::Atod(*Fields[10]);
+    return true;
+}
+
+/* ---------------- COMMANDLET ---------------- */
+
+int32 UJoyshipSimulationCommandlet::Main(const FString& Params)
+{
+    int32 NumSessions = 8;
+    int32 NumWorkers = 1;
+    int32 WorkerIndex = INDEX_NONE;
+    int32 Seed = 1;
+    FString OutputBase = FPaths::ProjectSavedDir() / TEXT("Simulation") / TEXT("JoyshipSimulation");
+
+    FParse::Value(*Params, TEXT("Sessions="), NumSessions);
+    FParse::Value(*Params, TEXT("Workers="), NumWorkers);
+    FParse::Value(*Params, TEXT("Worker="), WorkerIndex);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Output="), OutputBase);
+
+    NumSessions = FMath::Max(NumSessions, 1);
+    NumWorkers = FMath::Clamp(NumWorkers, 1, NumSessions);
+
+    const double StartTime = FPlatformTime::Seconds();
+    TArray<FJoyshipSimulationSession> Sessions;
+
+    if (WorkerIndex == INDEX_NONE && NumWorkers > 1)
+    {
+        // Parent: a UWorld only ticks on the game thread, so worlds run in parallel as separate processes
+        if (!RunWorkers(Params, NumWorkers, OutputBase))
+        {
+            UE_LOG(LogJoyship, Error, TEXT("[Simulation] A worker failed"));
+            return 1;
+        }
+
+        for (int32 Worker = 0; Worker < NumWorkers; ++Worker)
+        {
+            TArray<FString> Rows;
+            FFileHelper::LoadFileToStringArray(Rows, *FString::Printf(TEXT("%s_w%d.csv"), *OutputBase, Worker));
+            for (const FString& Row : Rows)
+            {
+                FJoyshipSimulationSession Session;
+                if (Session.FromCsvRow(Row))
+                {
+                    Sessions.Add(Session);
+                }
+            }
+        }
+    }
+    else
+    {
+        // Session s always uses Seed + s, so results do not depend on how sessions are split across workers
+        for (int32 SessionIndex = 0; SessionIndex < NumSessions; ++SessionIndex)
+        {
+            if (WorkerIndex != INDEX_NONE && SessionIndex % NumWorkers != WorkerIndex) continue;
+            Sessions.Add(RunSession(Params, SessionIndex, Seed + SessionIndex));
+        }
+    }
+
+    FString Csv = FString(FJoyshipSimulationSession::CsvHeader()) + TEXT("\n");
+    for (const FJoyshipSimulationSession& Session : Sessions)
+    {
+        Csv += Session.ToCsvRow() + TEXT("\n");
+    }
+
+    if (WorkerIndex != INDEX_NONE)
+    {
+        // Worker: the parent aggregates
+        return FFileHelper::SaveStringToFile(Csv, *FString::Printf(TEXT("%s_w%d.csv"), *OutputBase, WorkerIndex)) ? 0 : 1;
+    }
+
+    /* ---------------- AGGREGATE ---------------- */
+
+    const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+    const int32 Num = FMath::Max(Sessions.Num(), 1);
+
+    double SimSeconds = 0.0, FuelConsumed = 0.0, PlayerShots = 0.0, TotalShots = 0.0, Kills = 0.0, Pickups = 0.0;
+    double DeathTimeSum = 0.0;
+    float DeathTimeMin = 0.f, DeathTimeMax = 0.f;
+    int32 Deaths = 0;
+    for (const FJoyshipSimulationSession& Session : Sessions)
+    {
+        SimSeconds += Session.SimSeconds;
+        FuelConsumed += Session.FuelConsumed;
+        PlayerShots += Session.PlayerShots;
+        TotalShots += Session.TotalShots;
+        Kills += Session.Kills;
+        Pickups += Session.Pickups;
+        if (Session.bPlayerDied)
+        {
+            DeathTimeMin = Deaths == 0 ? Session.TimeToDeath : FMath::Min(DeathTimeMin, Session.TimeToDeath);
+            DeathTimeMax = FMath::Max(DeathTimeMax, Session.TimeToDeath);
+            DeathTimeSum += Session.TimeToDeath;
+            ++Deaths;
+        }
+    }
+
+    TArray<TPair<FString, double>> Metrics;
+    Metrics.Emplace(TEXT("Sessions"), Sessions.Num());
+    Metrics.Emplace(TEXT("Workers"), NumWorkers);
+    Metrics.Emplace(TEXT("SimSecondsTotal"), SimSeconds);
+    Metrics.Emplace(TEXT("WallSeconds"), WallSeconds);
+    Metrics.Emplace(TEXT("SpeedUp"), WallSeconds > 0.0 ? SimSeconds / WallSeconds : 0.0);
+    Metrics.Emplace(TEXT("FuelConsumed.Mean"), FuelConsumed / Num);
+    Metrics.Emplace(TEXT("FuelConsumed.PerMinute"), SimSeconds > 0.0 ? FuelConsumed / (SimSeconds / 60.0) : 0.0);
+    Metrics.Emplace(TEXT("Shots.Player.Mean"), PlayerShots / Num);
+    Metrics.Emplace(TEXT("Shots.Total.Mean"), TotalShots / Num);
+    Metrics.Emplace(TEXT("Kills.Mean"), Kills / Num);
+    Metrics.Emplace(TEXT("Pickups.Mean"), Pickups / Num);
+    Metrics.Emplace(TEXT("Deaths"), Deaths);
+    Metrics.Emplace(TEXT("DeathRate"), (double)Deaths / Num);
+    Metrics.Emplace(TEXT("TimeToDeath.Mean"), Deaths > 0 ? DeathTimeSum / Deaths : 0.0);
+    Metrics.Emplace(TEXT("TimeToDeath.Min"), DeathTimeMin);
+    Metrics.Emplace(TEXT("TimeToDeath.Max"), DeathTimeMax);
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("Params"), Params);
+
+    const bool bWroteResults = WriteResults(OutputBase, Root, Metrics);
+    const bool bWroteSessions = FFileHelper::SaveStringToFile(Csv, *(OutputBase + TEXT("_sessions.csv")));
+
+    UE_LOG(LogJoyship, Display, TEXT("[Simulation] %d sessions, %.0f s simulated in %.1f s (x%.1f), %d deaths, %.1f kills/session. Results: %s.json"),
+        Sessions.Num(), SimSeconds, WallSeconds, WallSeconds > 0.0 ? SimSeconds / WallSeconds : 0.0, Deaths, Kills / Num, *OutputBase);
+
+    return (bWroteResults && bWroteSessions) ? 0 : 1;
+}
+
+bool UJoyshipSimulationCommandlet::RunWorkers(const FString& Params, int32 NumWorkers, const FString& OutputBase)
+{
+    const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+
+    TArray<FProcHandle> Workers;
+    for (int32 Worker = 0; Worker < NumWorkers; ++Worker)
+    {
+        const FString Args = FString::Printf(TEXT("\"%s\" -run=JoyshipSimulation %s -Worker=%d -nullrhi -nosound -unattended"), *ProjectFile, *Params, Worker);
+        FProcHandle Handle = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Args, false, true, true, nullptr, 0, nullptr, nullptr);
+        if (!Handle.IsValid())
+        {
+            UE_LOG(LogJoyship, Error, TEXT("[Simulation] Could not start worker %d"), Worker);
+        }
+        Workers.Add(Handle);
+    }
+
+    bool bAllSucceeded = true;
+    for (int32 Worker = 0; Worker < Workers.Num(); ++Worker)
+    {
+        FProcHandle& Handle = Workers[Worker];
+        if (!Handle.IsValid())
+        {
+            bAllSucceeded = false;
+            continue;
+        }
+
+        FPlatformProcess::WaitForProc(Handle);
+        int32 ReturnCode = 1;
+        FPlatformProcess::GetProcReturnCode(Handle, &ReturnCode);
+        FPlatformProcess::CloseProc(Handle);
+        if (ReturnCode != 0)
+        {
+            UE_LOG(LogJoyship, Error, TEXT("[Simulation] Worker %d exited with %d (see %s_w%d.csv)"), Worker, ReturnCode, *OutputBase, Worker);
+            bAllSucceeded = false;
+        }
+    }
+    return bAllSucceeded;
+}
+
+FJoyshipSimulationSession UJoyshipSimulationCommandlet::RunSession(const FString& Params, int32 SessionIndex, int32 Seed)
+{
+    FJoyshipSimulationSession Session;
+    Session.Index = SessionIndex;
+    Session.Seed = Seed;
+
+    int32 NumEnemies = 20;
+    int32 NumTurrets = 10;
+    int32 NumCollectables = 40;
+    int32 GCInterval = 600;
+    float SpawnRadius = 6000.f;
+    float MaxSeconds = 300.f;
+    float DeltaTime = 1.f / 60.f;
+    FString MapPath = TEXT("/Game/Maps/SandBox");
+    FBotSettings Bot;
+
+    FParse::Value(*Params, TEXT("Enemies="), NumEnemies);
+    FParse::Value(*Params, TEXT("Turrets="), NumTurrets);
+    FParse::Value(*Params, TEXT("Collectables="), NumCollectables);
+    FParse::Value(*Params, TEXT("GCInterval="), GCInterval);
+    FParse::Value(*Params, TEXT("SpawnRadius="), SpawnRadius);
+    FParse::Value(*Params, TEXT("MaxSeconds="), MaxSeconds);
+    FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+    FParse::Value(*Params, TEXT("Map="), MapPath);
+    FParse::Value(*Params, TEXT("BotFireInterval="), Bot.FireInterval);
+    FParse::Value(*Params, TEXT("BotRefuelFraction="), Bot.RefuelFraction);
+
+    const TSubclassOf<APlayerShip> PlayerClass = ParseClassParam<APlayerShip>(Params, TEXT("PlayerClass="), LoadDefaultClass(APlayerShip::StaticClass(), TEXT("/Game/Pawns/BP_PlayerShip.BP_PlayerShip_C")));
+    const TSubclassOf<AEnemyShip> EnemyClass = ParseClassParam<AEnemyShip>(Params, TEXT("EnemyClass="), LoadDefaultClass(AEnemyShip::StaticClass(), TEXT("/Game/Pawns/MyEnemyShip.MyEnemyShip_C")));
+    const TSubclassOf<ATurret> TurretClass = ParseClassParam<ATurret>(Params, TEXT("TurretClass="), LoadDefaultClass(ATurret::StaticClass(), TEXT("/Game/Actors/BP_Turret.BP_Turret_C")));
+    const TSubclassOf<ACollectable> CollectableClass = ParseClassParam<ACollectable>(Params, TEXT("CollectableClass="), LoadDefaultClass(ACollectable::StaticClass(), TEXT("/Game/Actors/Collectables/BP_Fuel.BP_Fuel_C")));
+    const TSubclassOf<AActor> ProjectileClass = ParseClassParam<AActor>(Params, TEXT("ProjectileClass="), LoadDefaultClass(AProjectile::StaticClass(), TEXT("/Game/Actors/BP_Projectile.BP_Projectile_C")));
+
+    DeltaTime = FMath::Max(DeltaTime, 0.0001f);
+    const int32 MaxFrames = FMath::Max(1, FMath::CeilToInt(MaxSeconds / DeltaTime));
+
+    UWorld* World = JoyshipHeadlessWorld::Create(MapPath, TEXT("JoyshipSimulation"));
+    if (!World)
+    {
+        UE_LOG(LogJoyship, Error, TEXT("[Simulation] Session %d: failed to create world"), SessionIndex);
+        return Session;
+    }
+
+    // Kills count every death, including actors the session spawns mid-run (map actors are bound below)
+    const FDelegateHandle SpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UJoyshipSimulationCommandlet::BindDeath));
+
+    FRandomStream Rng(Seed);
+    FMath::RandInit(Seed);
+    FMath::SRandInit(Seed);
+
+    /* ---------------- SPAWN ---------------- */
+
+    APlayerShip* Player = World->SpawnActorDeferred<APlayerShip>(PlayerClass, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    if (Player)
+    {
+        if (Player->ProjectileClass.IsNull())
+        {
+            Player->ProjectileClass = ProjectileClass.Get();
+        }
+        OverrideFloat(Player, TEXT("MaxFuel"), Params, TEXT("MaxFuel="));
+        OverrideFloat(Player, TEXT("FuelConsumptionRate"), Params, TEXT("FuelConsumptionRate="));
+        Player->FinishSpawning(FTransform::Identity);
+    }
+    if (!Player)
+    {
+        UE_LOG(LogJoyship, Error, TEXT("[Simulation] Session %d: failed to spawn %s"), SessionIndex, *PlayerClass->GetName());
+        World->RemoveOnActorSpawnedHandler(SpawnedHandle);
+        JoyshipHeadlessWorld::Destroy(World);
+        return Session;
+    }
+
+    for (int32 i = 0; i < NumEnemies; ++i)
+    {
+        AEnemyShip* Enemy = World->SpawnActorDeferred<AEnemyShip>(EnemyClass, FTransform(RandomPlanePoint(Rng, 1500.f, SpawnRadius)), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        if (!Enemy) continue;
+        if (Enemy->ProjectileClass.IsNull())
+        {
+            Enemy->ProjectileClass = ProjectileClass.Get();
+        }
+        Enemy->FinishSpawning(Enemy->GetTransform());
+    }
+
+    for (int32 i = 0; i < NumTurrets; ++i)
+    {
+        ATurret* Turret = World->SpawnActorDeferred<ATurret>(TurretClass, FTransform(RandomPlanePoint(Rng, 1000.f, SpawnRadius)), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        if (!Turret) continue;
+        if (Turret->ProjectileClass.IsNull())
+        {
+            Turret->ProjectileClass = ProjectileClass.Get();
+        }
+        Turret->FinishSpawning(Turret->GetTransform());
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    for (int32 i = 0; i < NumCollectables; ++i)
+    {
+        World->SpawnActor<ACollectable>(CollectableClass, FTransform(RandomPlanePoint(Rng, 500.f, SpawnRadius)), SpawnParams);
+    }
+
+    // Turret balancing applies to the map's turrets as well as the spawned ones; map actors get their death binding here
+    float TurretFireInterval = 0.f;
+    float TurretLookTime = 0.f;
+    const bool bTurretFireInterval = FParse::Value(*Params, TEXT("TurretFireInterval="), TurretFireInterval);
+    const bool bTurretLookTime = FParse::Value(*Params, TEXT("TurretLookTime="), TurretLookTime);
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        if (ATurret* Turret = Cast<ATurret>(*It))
+        {
+            if (bTurretFireInterval) Turret->FireInterval = TurretFireInterval;
+            if (bTurretLookTime) Turret->LookTimeRequired = TurretLookTime;
+        }
+
+        BindDeath(*It);
+    }
+
+    // Nothing pumps async loads in a commandlet: finish the spawned actors' preloads before the run
+    FlushAsyncLoading();
+
+    /* ---------------- RUN ---------------- */
+
+    UProjectilePoolSubsystem* Pool = World->GetSubsystem<UProjectilePoolSubsystem>();
+    if (Pool)
+    {
+        Pool->ResetStats();
+    }
+    USimulatedProjectileSubsystem* Sim = World->GetSubsystem<USimulatedProjectileSubsystem>();
+    if (Sim)
+    {
+        Sim->ResetStats();
+    }
+    USpatialGridSubsystem* Grid = World->GetSubsystem<USpatialGridSubsystem>();
+
+    FBotState BotState;
+    BotState.Home = Player->GetActorLocation();
+    BotState.StartFuel = Player->GetCurrentFuel();
+
+    CurrentSession = &Session;
+    CurrentPlayer = Player;
+    SessionStartTime = World->GetTimeSeconds();
+
+    const double WallStart = FPlatformTime::Seconds();
+    int32 Frame = 0;
+    for (; Frame < MaxFrames && !Session.bPlayerDied; ++Frame)
+    {
+        if (APlayerShip* Pilot = CurrentPlayer.Get())
+        {
+            DriveBot(Pilot, Grid, Bot, BotState, DeltaTime);
+        }
+
+        ++GFrameCounter;
+        World->Tick(LEVELTICK_All, DeltaTime);
+
+        if (APlayerShip* Pilot = CurrentPlayer.Get())
+        {
+            Session.FuelConsumed = Pilot->GetFuelConsumed();
+            Session.PlayerShots = Pilot->GetFireCount();
+        }
+        else if (!Session.bPlayerDied)
+        {
+            // Destroyed without going through UHealthComponent (e.g. fell out of the world)
+            Session.bPlayerDied = true;
+            Session.TimeToDeath = World->GetTimeSeconds() - SessionStartTime;
+        }
+
+        if (GCInterval > 0 && Frame > 0 && Frame % GCInterval == 0)
+        {
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+    }
+    Session.WallSeconds = FPlatformTime::Seconds() - WallStart;
+    Session.SimSeconds = Frame * DeltaTime;
+
+    // Collected items are pooled (and may respawn), so count collections rather than missing actors
+    if (const UCollectableSubsystem* Collectables = World->GetSubsystem<UCollectableSubsystem>())
+    {
+        Session.Pickups = Collectables->GetTotalStats().Collected;
+    }
+
+    // Counted where shots are launched: every pooled spawn request plus every simulated projectile
+    if (Pool)
+    {
+        const FProjectilePoolStats Stats = Pool->GetTotalStats();
+        Session.TotalShots += Stats.Hits + Stats.Misses;
+    }
+    if (Sim)
+    {
+        Session.TotalShots += Sim->GetTotalFired();
+    }
+
+    CurrentSession = nullptr;
+    CurrentPlayer.Reset();
+    World->RemoveOnActorSpawnedHandler(SpawnedHandle);
+    JoyshipHeadlessWorld::Destroy(World);
+
+    UE_LOG(LogJoyship, Display, TEXT("[Simulation] Session %d (seed %d): %.1f s, %s, fuel %.1f, %d shots, %d kills, %d pickups"),
+        SessionIndex, Seed, Session.SimSeconds, Session.bPlayerDied ? *FString::Printf(TEXT("died at %.1f s"), Session.TimeToDeath) : TEXT("survived"),
+        Session.FuelConsumed, Session.PlayerShots, Session.Kills, Session.Pickups);
+
+    return Session;
+}
+
+void UJoyshipSimulationCommandlet::BindDeath(AActor* Actor)
+{
+    if (UHealthComponent* Health = Actor ? Actor->FindComponentByClass<UHealthComponent>() : nullptr)
+    {
+        Health->OnDeath.AddUniqueDynamic(this, &UJoyshipSimulationCommandlet::HandleDeath);
+    }
+}
+
+void UJoyshipSimulationCommandlet::HandleDeath(UHealthComponent* HealthComp)
+{
+    if (!CurrentSession || !HealthComp) return;
+
+    if (HealthComp->GetOwner() == CurrentPlayer.Get())
+    {
+        CurrentSession->bPlayerDied = true;
+        CurrentSession->TimeToDeath = HealthComp->GetWorld()->GetTimeSeconds() - SessionStartTime;
+    }
+    else
+    {
+        ++CurrentSession->Kills;
+    }
+}
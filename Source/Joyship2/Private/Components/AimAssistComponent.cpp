@@ -0,0 +1,94 @@
+#include "Components/AimAssistComponent.h"
+#include "Pawns/BaseShip.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+
+UAimAssistComponent::UAimAssistComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    // Validate after movement so the cached target matches this frame's positions
+    PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UAimAssistComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    FVector Origin, Axis;
+    GetAimOriginAndAxis(Origin, Axis);
+
+    QueryAccum += DeltaTime;
+    bool bQuery = bForceQuery || QueryAccum >= FullQueryInterval;
+
+    // Cheap per-frame re-validation of the held target
+    AActor* Target = CurrentTarget.Get();
+    if (Target && !IsTargetAcceptable(Target, Origin, Axis))
+    {
+        CurrentTarget.Reset();
+        // Lost the target: look for a new one right away (only once; afterwards the interval applies)
+        bQuery = true;
+    }
+
+    if (bQuery)
+    {
+        QueryAccum = 0.f;
+        bForceQuery = false;
+        CurrentTarget = FindBestTarget(Origin, Axis);
+    }
+}
+
+FVector UAimAssistComponent::GetAimDirection(const FVector& FromLocation, const FVector& Fallback) const
+{
+    const AActor* Target = CurrentTarget.Get();
+    if (!Target) return Fallback;
+
+    const FVector Dir = (Target->GetActorLocation() - FromLocation).GetSafeNormal();
+    return Dir.IsNearlyZero() ? Fallback : Dir;
+}
+
+void UAimAssistComponent::InvalidateTarget()
+{
+    CurrentTarget.Reset();
+    bForceQuery = true;
+}
+
+bool UAimAssistComponent::IsTargetAcceptable(const AActor* Target, const FVector& Origin, const FVector& Axis) const
+{
+    if (!IsValid(Target)) return false;
+
+    // Play plane is ZY; ignore depth
+    FVector To = Target->GetActorLocation() - Origin;
+    To.X = 0.f;
+
+    // Same test as USpatialGridSubsystem::FindFirstAlongRay: distance to the swept segment against both radii
+    const float Along = FMath::Clamp(FVector::DotProduct(To, Axis), 0.f, Range);
+    const float Reach = LateralRadius + Target->GetSimpleCollisionRadius();
+    return (To - Axis * Along).SizeSquared() <= Reach * Reach;
+}
+
+AActor* UAimAssistComponent::FindBestTarget(const FVector& Origin, const FVector& Axis)
+{
+    UWorld* World = GetWorld();
+    USpatialGridSubsystem* Grid = World ? World->GetSubsystem<USpatialGridSubsystem>() : nullptr;
+    if (!Grid) return nullptr;
+
+    // Walks only the cells under the swept sphere, nearest first
+    return Grid->FindFirstAlongRay(Origin, Axis, Range, LateralRadius, ESpatialGridFlags::Damageable, GetOwner());
+}
+
+void UAimAssistComponent::GetAimOriginAndAxis(FVector& OutOrigin, FVector& OutAxis) const
+{
+    const AActor* Owner = GetOwner();
+    if (!Owner)
+    {
+        OutOrigin = FVector::ZeroVector;
+        OutAxis = FVector::UpVector;
+        return;
+    }
+
+    const ABaseShip* Ship = Cast<ABaseShip>(Owner);
+    OutOrigin = Ship ? Ship->GetMuzzleLocation() : Owner->GetActorLocation();
+
+    OutAxis = Owner->GetActorUpVector();
+    OutAxis.X = 0.f;
+    OutAxis = OutAxis.GetSafeNormal(SMALL_NUMBER, FVector::UpVector);
+}
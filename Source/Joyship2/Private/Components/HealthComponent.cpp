@@ -1,43 +1,141 @@
 #include "Components/HealthComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Sound/SoundBase.h"
+#include "Subsystems/AssetPreloadSubsystem.h"
+#include "Subsystems/DamageSubsystem.h"
+#include "Subsystems/EffectsSubsystem.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "Net/UnrealNetwork.h"
 
 UHealthComponent::UHealthComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
+
+    SetIsReplicatedByDefault(true);
+
+    // Queue the explosion assets while the owner is initialized (during map load for placed actors)
+    bWantsInitializeComponent = true;
+}
+
+void UHealthComponent::InitializeComponent()
+{
+    Super::InitializeComponent();
+
+    UAssetPreloadSubsystem::Preload(this, { ExplosionEffect.ToSoftObjectPath(), ExplosionSound.ToSoftObjectPath() });
+}
+
+void UHealthComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(UHealthComponent, CurrentHealth);
 }
 
 void UHealthComponent::BeginPlay()
 {
     Super::BeginPlay();
-    CurrentHealth = MaxHealth;
+    // Clients keep the health that replicated in with the actor
+    if (GetOwnerRole() == ROLE_Authority)
+    {
+        CurrentHealth = MaxHealth;
+    }
+    bDead = false;
+
+    // Owners with health are aim-assist candidates
+    if (USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+    {
+        Grid->Register(GetOwner(), ESpatialGridFlags::Damageable);
+    }
+
+    // Route UGameplayStatics::ApplyDamage / TakeDamage into the batched pipeline
+    if (AActor* Owner = GetOwner())
+    {
+        Owner->OnTakeAnyDamage.AddDynamic(this, &UHealthComponent::HandleTakeAnyDamage);
+    }
+}
+
+void UHealthComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+    {
+        Grid->Unregister(GetOwner());
+    }
+
+    if (AActor* Owner = GetOwner())
+    {
+        Owner->OnTakeAnyDamage.RemoveDynamic(this, &UHealthComponent::HandleTakeAnyDamage);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UHealthComponent::HandleTakeAnyDamage(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser)
+{
+    UDamageSubsystem* DamageSys = GetWorld() ? GetWorld()->GetSubsystem<UDamageSubsystem>() : nullptr;
+    if (DamageSys)
+    {
+        DamageSys->QueueDamage(DamagedActor, Damage, DamageCauser, 0, InstigatedBy);
+    }
+    else
+    {
+        ApplyDamage(Damage);
+    }
 }
 
 void UHealthComponent::ApplyDamage(float DamageAmount)
 {
-    CurrentHealth -= DamageAmount;
+    if (bDead || DamageAmount == 0.f || GetOwnerRole() != ROLE_Authority) return;
+
+    CurrentHealth = FMath::Min(CurrentHealth - DamageAmount, MaxHealth);
+    OnHealthChanged.Broadcast(this, CurrentHealth);
+
     if (CurrentHealth <= 0.f)
     {
         Explode();
     }
 }
 
+void UHealthComponent::OnRep_CurrentHealth()
+{
+    OnHealthChanged.Broadcast(this, CurrentHealth);
+}
+
+void UHealthComponent::MulticastDeath_Implementation()
+{
+    // The server played the effects in Explode; clients only show the death, the destroy replicates
+    if (bDead || GetOwnerRole() == ROLE_Authority) return;
+
+    bDead = true;
+    PlayDeathEffects();
+}
+
 void UHealthComponent::Explode()
 {
+    if (bDead || GetOwnerRole() != ROLE_Authority) return;
     AActor* Owner = GetOwner();
-    if (!Owner) return;
+    if (!Owner || Owner->IsActorBeingDestroyed()) return;
 
-    FVector Loc = Owner->GetActorLocation();
-    FRotator Rot = Owner->GetActorRotation();
+    bDead = true;
 
-    if (ExplosionEffect)
+    PlayDeathEffects();
+    if (GetNetMode() != NM_Standalone)
     {
-        UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplosionEffect, Loc, Rot);
+        MulticastDeath();
     }
 
-    if (ExplosionSound)
-    {
-        UGameplayStatics::PlaySoundAtLocation(GetWorld(), ExplosionSound, Loc);
-    }
+    OnDeath.Broadcast(this);
 
     Owner->Destroy();
 }
+
+void UHealthComponent::PlayDeathEffects()
+{
+    const AActor* Owner = GetOwner();
+    if (!Owner) return;
+
+    // Pooled and budgeted; chain deaths in one spot collapse into a few effects
+    if (UEffectsSubsystem* Effects = GetWorld()->GetSubsystem<UEffectsSubsystem>())
+    {
+        Effects->PlayExplosion(ExplosionEffect.Get(), ExplosionSound.Get(), Owner->GetActorLocation(), Owner->GetActorRotation());
+    }
+}
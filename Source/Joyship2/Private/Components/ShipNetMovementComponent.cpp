@@ -0,0 +1,309 @@
+#include "Components/ShipNetMovementComponent.h"
+#include "Joyship2.h"
+#include "Pawns/BaseShip.h"
+#include "Components/StaticMeshComponent.h"
+#include "Subsystems/ProjectileNetSubsystem.h"
+#include "Net/UnrealNetwork.h"
+
+UShipNetMovementComponent::UShipNetMovementComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    // Capture after the ship (and anything that moved it) has run this frame
+    PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+    SetIsReplicatedByDefault(true);
+}
+
+void UShipNetMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(UShipNetMovementComponent, ServerState);
+}
+
+void UShipNetMovementComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    Ship = Cast<ABaseShip>(GetOwner());
+    if (!Ship || !IsNetworked()) return;
+
+    // Engine physics cannot be rewound and replayed; every machine runs the same kinematic simulation.
+    // This runs inside the ship's Super::BeginPlay, before it initialises the fixed-step state.
+    Ship->bUseFixedStepSimulation = true;
+
+    SetComponentTickEnabled(GetOwnerRole() == ROLE_Authority);
+
+    // Where the ship has been, for lag-compensated hits
+    if (GetOwnerRole() == ROLE_Authority)
+    {
+        if (UProjectileNetSubsystem* ProjectileNet = GetWorld()->GetSubsystem<UProjectileNetSubsystem>())
+        {
+            ProjectileNet->RegisterHistory(Ship);
+        }
+    }
+}
+
+void UShipNetMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UProjectileNetSubsystem* ProjectileNet = GetWorld() ? GetWorld()->GetSubsystem<UProjectileNetSubsystem>() : nullptr)
+    {
+        ProjectileNet->UnregisterHistory(GetOwner());
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+bool UShipNetMovementComponent::IsDrivenByMoves() const
+{
+    if (!Ship || !IsNetworked()) return false;
+
+    if (GetOwnerRole() == ROLE_AutonomousProxy) return true;
+    return GetOwnerRole() == ROLE_Authority && Ship->IsPlayerControlled() && !Ship->IsLocallyControlled();
+}
+
+void UShipNetMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    CaptureServerState();
+}
+
+bool UShipNetMovementComponent::TickNetworkMovement(float DeltaTime)
+{
+    if (!Ship || !IsNetworked()) return false;
+
+    switch (GetOwnerRole())
+    {
+    case ROLE_AutonomousProxy:
+        // Moved by PredictMove
+        UpdateMeshOffset(DeltaTime);
+        return true;
+
+    case ROLE_SimulatedProxy:
+        // Dead-reckon with the replicated steering targets until the next update
+        Ship->StepFixedSimulation(DeltaTime);
+        UpdateMeshOffset(DeltaTime);
+        return true;
+
+    default:
+        // Server: a remote player's ship only moves when its moves arrive
+        return IsDrivenByMoves();
+    }
+}
+
+/* ---------------- OWNING CLIENT ---------------- */
+
+void UShipNetMovementComponent::PredictMove(float DeltaTime, float Rotation, bool bThrust)
+{
+    if (!Ship || DeltaTime <= 0.f) return;
+
+    if (PendingMoves.Num() >= MaxPendingMoves)
+    {
+        PendingMoves.RemoveAt(0, 1, EAllowShrinking::No);
+    }
+
+    FPendingMove& Pending = PendingMoves.AddDefaulted_GetRef();
+    Pending.Move.Set(NextMoveId++, FMath::Min(DeltaTime, MaxMoveDeltaTime), Rotation, bThrust);
+    Ship->SimulateNetMove(Pending.Move);
+    Pending.PredictedLocation = Ship->GetActorLocation();
+
+    const FShipNetMove PreviousMove = PendingMoves.Num() >= 2 ? PendingMoves[PendingMoves.Num() - 2].Move : FShipNetMove();
+    ServerMove(Pending.Move, PreviousMove);
+}
+
+void UShipNetMovementComponent::ReconcileAutonomous()
+{
+    // Not driving the ship yet (state from before possession): take it as is
+    if (!ServerState.bHasAck)
+    {
+        if (PendingMoves.Num() == 0)
+        {
+            const FVector OldLocation = Ship->GetActorLocation();
+            ApplyServerState(ServerState);
+            AddCorrectionOffset(OldLocation);
+        }
+        return;
+    }
+
+    const uint16 Acked = ServerState.AckedMove;
+    const int32 AckIndex = PendingMoves.IndexOfByPredicate([Acked](const FPendingMove& Pending) { return Pending.Move.Id == Acked; });
+
+    bool bCorrect = true;
+    if (AckIndex != INDEX_NONE)
+    {
+        const FVector Predicted = PendingMoves[AckIndex].PredictedLocation;
+        const FVector Server = ServerState.GetLocation(Predicted.X);
+        bCorrect = FVector::DistSquared(Predicted, Server) > FMath::Square(CorrectionTolerance);
+        PendingMoves.RemoveAt(0, AckIndex + 1, EAllowShrinking::No);
+    }
+    else
+    {
+        // The acked move is no longer in the list: drop everything it covers and resync
+        PendingMoves.RemoveAll([Acked](const FPendingMove& Pending) { return !IsNewerShipMove(Pending.Move.Id, Acked); });
+    }
+
+    if (!bCorrect) return;
+
+    // Rewind to the server's state for the acked move and replay the moves still in flight
+    const FVector OldLocation = Ship->GetActorLocation();
+    ApplyServerState(ServerState);
+    for (FPendingMove& Pending : PendingMoves)
+    {
+        Ship->SimulateNetMove(Pending.Move);
+        Pending.PredictedLocation = Ship->GetActorLocation();
+    }
+    AddCorrectionOffset(OldLocation);
+
+    JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, Verbose, 1.0, TEXT("[NetMovement] %s: corrected %.1f uu, replayed %d moves"),
+        *Ship->GetName(), FVector::Dist(OldLocation, Ship->GetActorLocation()), PendingMoves.Num());
+}
+
+/* ---------------- SERVER ---------------- */
+
+void UShipNetMovementComponent::ServerMove_Implementation(const FShipNetMove& Move, const FShipNetMove& PreviousMove)
+{
+    if (PreviousMove.DeltaTime > 0)
+    {
+        ProcessMove(PreviousMove);
+    }
+    ProcessMove(Move);
+}
+
+void UShipNetMovementComponent::ProcessMove(FShipNetMove Move)
+{
+    if (!Ship || !IsDrivenByMoves()) return;
+    if (bHasProcessedMove && !IsNewerShipMove(Move.Id, LastProcessedMove)) return;
+
+    // Never trust the client with more time than a move may cover
+    Move.DeltaTime = FMath::Min<uint16>(Move.DeltaTime, (uint16)FMath::RoundToInt(MaxMoveDeltaTime * 10000.f));
+
+    // Nor with more moves than real time allows: the budget refills with server time and caps at the tolerance,
+    // so a burst of late moves (jitter) still fits but an unthrottled stream of extra moves runs dry
+    const double Now = GetWorld()->GetTimeSeconds();
+    const double Tolerance = FMath::Max(MoveTimeTolerance, 2.f * MaxMoveDeltaTime);
+    MoveTimeBudget = bHasProcessedMove ? FMath::Min(MoveTimeBudget + (Now - LastMoveBudgetTime), Tolerance) : Tolerance;
+    LastMoveBudgetTime = Now;
+
+    const uint16 Allowed = (uint16)FMath::Clamp(FMath::FloorToInt(MoveTimeBudget * 10000.0), 0, (int32)MAX_uint16);
+    if (Move.DeltaTime > Allowed)
+    {
+        JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, Warning, 1.0, TEXT("[NetMovement] %s: move %u cut from %.4f s to %.4f s (client ahead of server time)"),
+            *Ship->GetName(), Move.Id, Move.GetDeltaTime(), Allowed / 10000.f);
+        Move.DeltaTime = Allowed;
+    }
+    MoveTimeBudget -= Move.GetDeltaTime();
+
+    // A move with no time left is still acknowledged, so the client rewinds to the unmoved state
+    if (Move.DeltaTime > 0)
+    {
+        Ship->SimulateNetMove(Move);
+    }
+    LastProcessedMove = Move.Id;
+    bHasProcessedMove = true;
+
+    CaptureServerState();
+}
+
+void UShipNetMovementComponent::CaptureServerState()
+{
+    if (!Ship) return;
+
+    const FVector Forward = Ship->GetActorForwardVector();
+
+    FShipNetState State;
+    State.SetLocation(Ship->GetActorLocation());
+    State.SetRoll((float)Ship->GetActorRotation().Roll);
+    State.SetVelocity(Ship->Velocity);
+    State.RollRate = FShipNetState::QuantizeRollRate(Ship->FixedAngularVelocity, Forward);
+    State.SetTargetVelocity(Ship->TargetLinearVelocity);
+    State.TargetRollRate = FShipNetState::QuantizeRollRate(Ship->TargetAngularVelocity, Forward);
+
+    float Fuel = 0.f;
+    if (Ship->GetNetFuel(Fuel))
+    {
+        State.SetFuel(Fuel);
+    }
+
+    if (bHasProcessedMove)
+    {
+        State.bHasAck = true;
+        State.AckedMove = LastProcessedMove;
+    }
+
+    if (!(State == ServerState))
+    {
+        ServerState = State;
+    }
+}
+
+/* ---------------- CLIENTS ---------------- */
+
+void UShipNetMovementComponent::OnRep_ServerState()
+{
+    if (!Ship) return;
+
+    if (GetOwnerRole() == ROLE_AutonomousProxy)
+    {
+        ReconcileAutonomous();
+    }
+    else if (GetOwnerRole() == ROLE_SimulatedProxy)
+    {
+        CorrectSimulatedProxy();
+    }
+}
+
+void UShipNetMovementComponent::CorrectSimulatedProxy()
+{
+    const FVector OldLocation = Ship->GetActorLocation();
+    ApplyServerState(ServerState);
+    AddCorrectionOffset(OldLocation);
+}
+
+void UShipNetMovementComponent::ApplyServerState(const FShipNetState& State)
+{
+    FRotator Rotation = Ship->GetActorRotation();
+    Rotation.Roll = State.GetRoll();
+    Ship->SetActorLocationAndRotation(State.GetLocation((float)Ship->GetActorLocation().X), Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+
+    const FVector Forward = Ship->GetActorForwardVector();
+    Ship->Velocity = State.GetVelocity();
+    Ship->FixedAngularVelocity = FShipNetState::DequantizeRollRate(State.RollRate, Forward);
+    Ship->TargetLinearVelocity = State.GetTargetVelocity();
+    Ship->TargetAngularVelocity = FShipNetState::DequantizeRollRate(State.TargetRollRate, Forward);
+    if (State.bHasFuel)
+    {
+        Ship->SetNetFuel(State.GetFuel());
+    }
+
+    // Keep the fixed-step interpolation from blending across the correction
+    Ship->PrevStepTransform = Ship->CurrStepTransform = Ship->GetActorTransform();
+}
+
+void UShipNetMovementComponent::AddCorrectionOffset(const FVector& OldLocation)
+{
+    const FVector Delta = OldLocation - Ship->GetActorLocation();
+    MeshOffset = Delta.SizeSquared() > FMath::Square(SnapDistance) ? FVector::ZeroVector : MeshOffset + Delta;
+    UpdateMeshOffset(0.f);
+}
+
+void UShipNetMovementComponent::UpdateMeshOffset(float DeltaTime)
+{
+    if (!Ship->ShipMesh) return;
+
+    if (!MeshOffset.IsZero())
+    {
+        MeshOffset *= FMath::Exp(-SmoothingSpeed * DeltaTime);
+        if (MeshOffset.SizeSquared() < 0.01f)
+        {
+            MeshOffset = FVector::ZeroVector;
+        }
+    }
+
+    const FVector Relative = Ship->MeshRelativeTransform.GetLocation() + Ship->GetActorTransform().InverseTransformVectorNoScale(MeshOffset);
+    if (!Relative.Equals(Ship->ShipMesh->GetRelativeLocation()))
+    {
+        Ship->ShipMesh->SetRelativeLocation(Relative);
+    }
+}
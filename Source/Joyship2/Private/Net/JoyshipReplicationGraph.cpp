@@ -0,0 +1,200 @@
+#include "Net/JoyshipReplicationGraph.h"
+#include "Joyship2.h"
+#include "Net/ProjectileEventRelay.h"
+#include "Pawns/BaseShip.h"
+#include "Pawns/EnemyShip.h"
+#include "Actors/Turret.h"
+#include "Actors/Collectable.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "GameFramework/Info.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "UObject/UObjectIterator.h"
+
+/* ---------------- GRID NODE ---------------- */
+
+void UJoyshipGridReplicationNode::AddActor(AActor* Actor, bool bRateByRange)
+{
+    Actors.Add(Actor, bRateByRange);
+}
+
+bool UJoyshipGridReplicationNode::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+    const bool bRemoved = Actors.Remove(ActorInfo.Actor) > 0;
+    if (!bRemoved && bWarnIfNotFound)
+    {
+        UE_LOG(LogJoyship, Warning, TEXT("[ReplicationGraph] %s was not in the grid node"), *GetNameSafe(ActorInfo.Actor));
+    }
+    return bRemoved;
+}
+
+void UJoyshipGridReplicationNode::NotifyResetAllNetworkActors()
+{
+    Actors.Reset();
+    ConnectionLists.Reset();
+}
+
+void UJoyshipGridReplicationNode::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+    FActorRepListRefView& List = ConnectionLists.FindOrAdd(&Params.ConnectionManager);
+    List.Reset();
+
+    UWorld* World = GraphGlobals.IsValid() ? GraphGlobals->World : nullptr;
+    USpatialGridSubsystem* Grid = World ? World->GetSubsystem<USpatialGridSubsystem>() : nullptr;
+    if (!Grid) return;
+
+    const ESpatialGridFlags Filter = ESpatialGridFlags::Ship | ESpatialGridFlags::Turret | ESpatialGridFlags::Collectable | ESpatialGridFlags::PooledCollectable;
+    for (const FNetViewer& Viewer : Params.Viewers)
+    {
+        QueryResults.Reset();
+        Grid->QueryRadius(Viewer.ViewLocation, RelevancyRadius, Filter, QueryResults);
+
+        for (AActor* Actor : QueryResults)
+        {
+            const bool* bRateByRange = Actors.Find(Actor);
+            if (!bRateByRange) continue;
+
+            // Split-screen connections have several viewers that can find the same actor
+            if (Params.Viewers.Num() > 1 && List.Contains(Actor)) continue;
+            List.Add(Actor);
+
+            if (!*bRateByRange) continue;
+
+            float MinDistSq = TNumericLimits<float>::Max();
+            for (const FNetViewer& Other : Params.Viewers)
+            {
+                MinDistSq = FMath::Min(MinDistSq, (float)FVector::DistSquared(Other.ViewLocation, Actor->GetActorLocation()));
+            }
+
+            uint16 Scale = MinDistSq < FMath::Square(NearDistance) ? 1 : (MinDistSq < FMath::Square(FarDistance) ? MidPeriodScale : FarPeriodScale);
+
+            // Enemies that are not chasing anyone barely change; never send them at the near rate
+            const AEnemyShip* Enemy = Cast<AEnemyShip>(Actor);
+            if (Enemy && !Enemy->GetAggroPlayer())
+            {
+                Scale = FMath::Max(Scale, MidPeriodScale);
+            }
+
+            const uint16 ClassPeriod = GraphGlobals->GlobalActorReplicationInfoMap->Get(Actor).Settings.ReplicationPeriodFrame;
+            Params.ConnectionManager.ActorInfoMap.FindOrAdd(Actor).ReplicationPeriodFrame = FMath::Max<uint16>(1, ClassPeriod * Scale);
+        }
+    }
+
+    if (List.Num() > 0)
+    {
+        Params.OutGatheredReplicationLists.AddReplicationActorList(List);
+    }
+}
+
+/* ---------------- GRAPH ---------------- */
+
+void UJoyshipReplicationGraph::InitGlobalActorClassSettings()
+{
+    Super::InitGlobalActorClassSettings();
+
+    ClassPolicies.Set(AActor::StaticClass(), EJoyshipRepPolicy::Distance);
+    ClassPolicies.Set(AInfo::StaticClass(), EJoyshipRepPolicy::AlwaysRelevant);
+    ClassPolicies.Set(AProjectileEventRelay::StaticClass(), EJoyshipRepPolicy::AlwaysRelevant);
+    ClassPolicies.Set(APlayerController::StaticClass(), EJoyshipRepPolicy::NotRouted);
+    ClassPolicies.Set(ABaseShip::StaticClass(), EJoyshipRepPolicy::Spatialized);
+    ClassPolicies.Set(AEnemyShip::StaticClass(), EJoyshipRepPolicy::SpatializedByRange);
+    ClassPolicies.Set(ATurret::StaticClass(), EJoyshipRepPolicy::Spatialized);
+    ClassPolicies.Set(ACollectable::StaticClass(), EJoyshipRepPolicy::Spatialized);
+
+    // Rate and cull distance from each replicated class's defaults; classes loaded later use their parent's
+    for (TObjectIterator<UClass> It; It; ++It)
+    {
+        UClass* Class = *It;
+        const AActor* CDO = Cast<AActor>(Class->GetDefaultObject(false));
+        if (!CDO || !CDO->GetIsReplicated()) continue;
+
+        const FString ClassName = Class->GetName();
+        if (ClassName.StartsWith(TEXT("SKEL_")) || ClassName.StartsWith(TEXT("REINST_"))) continue;
+
+        FClassReplicationInfo ClassInfo;
+        ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(CDO->GetNetUpdateFrequency());
+        // The grid already limits spatialized actors to RelevancyRadius
+        const EJoyshipRepPolicy Policy = GetPolicy(Class);
+        if (Policy == EJoyshipRepPolicy::Distance)
+        {
+            ClassInfo.SetCullDistanceSquared(CDO->GetNetCullDistanceSquared());
+        }
+        GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+    }
+}
+
+void UJoyshipReplicationGraph::InitGlobalGraphNodes()
+{
+    GridNode = CreateNewNode<UJoyshipGridReplicationNode>();
+    GridNode->RelevancyRadius = RelevancyRadius;
+    GridNode->NearDistance = EnemyNearDistance;
+    GridNode->FarDistance = EnemyFarDistance;
+    AddGlobalGraphNode(GridNode);
+
+    AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+    AddGlobalGraphNode(AlwaysRelevantNode);
+
+    DistanceNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+    AddGlobalGraphNode(DistanceNode);
+}
+
+void UJoyshipReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+    Super::InitConnectionGraphNodes(RepGraphConnection);
+
+    // The connection's own controller and view target (its ship), wherever the grid puts them
+    AddConnectionGraphNode(CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>(), RepGraphConnection);
+}
+
+EJoyshipRepPolicy UJoyshipReplicationGraph::GetPolicy(const UClass* Class)
+{
+    const EJoyshipRepPolicy* Policy = ClassPolicies.Get(Class);
+    return Policy ? *Policy : EJoyshipRepPolicy::Distance;
+}
+
+EJoyshipRepPolicy UJoyshipReplicationGraph::GetActorPolicy(const AActor* Actor)
+{
+    if (Actor->bOnlyRelevantToOwner) return EJoyshipRepPolicy::NotRouted;
+    if (Actor->bAlwaysRelevant) return EJoyshipRepPolicy::AlwaysRelevant;
+    return GetPolicy(Actor->GetClass());
+}
+
+void UJoyshipReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+    switch (GetActorPolicy(ActorInfo.Actor))
+    {
+    case EJoyshipRepPolicy::AlwaysRelevant:
+        AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+        break;
+    case EJoyshipRepPolicy::Spatialized:
+        GridNode->AddActor(ActorInfo.Actor, false);
+        break;
+    case EJoyshipRepPolicy::SpatializedByRange:
+        GridNode->AddActor(ActorInfo.Actor, true);
+        break;
+    case EJoyshipRepPolicy::Distance:
+        DistanceNode->NotifyAddNetworkActor(ActorInfo);
+        break;
+    default:
+        break;
+    }
+}
+
+void UJoyshipReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+    switch (GetActorPolicy(ActorInfo.Actor))
+    {
+    case EJoyshipRepPolicy::AlwaysRelevant:
+        AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+        break;
+    case EJoyshipRepPolicy::Spatialized:
+    case EJoyshipRepPolicy::SpatializedByRange:
+        GridNode->NotifyRemoveNetworkActor(ActorInfo);
+        break;
+    case EJoyshipRepPolicy::Distance:
+        DistanceNode->NotifyRemoveNetworkActor(ActorInfo);
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,48 @@
+#include "Net/ProjectileEventRelay.h"
+#include "Subsystems/ProjectileNetSubsystem.h"
+#include "Engine/World.h"
+
+AProjectileEventRelay::AProjectileEventRelay()
+{
+    PrimaryActorTick.bCanEverTick = false;
+    SetHidden(true);
+    SetCanBeDamaged(false);
+
+    bReplicates = true;
+    bAlwaysRelevant = true;
+    SetReplicatingMovement(false);
+    // Only carries RPCs; there are no properties to poll
+    SetNetUpdateFrequency(1.f);
+}
+
+void AProjectileEventRelay::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Clients find the relay when it replicates in; the server registered it when spawning
+    if (UProjectileNetSubsystem* ProjectileNet = GetWorld()->GetSubsystem<UProjectileNetSubsystem>())
+    {
+        ProjectileNet->RegisterRelay(this);
+    }
+}
+
+void AProjectileEventRelay::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UProjectileNetSubsystem* ProjectileNet = GetWorld() ? GetWorld()->GetSubsystem<UProjectileNetSubsystem>() : nullptr)
+    {
+        ProjectileNet->UnregisterRelay(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AProjectileEventRelay::MulticastFireEvents_Implementation(const TArray<FProjectileFireEvent>& Events)
+{
+    // The server already simulated these
+    if (HasAuthority()) return;
+
+    if (UProjectileNetSubsystem* ProjectileNet = GetWorld()->GetSubsystem<UProjectileNetSubsystem>())
+    {
+        ProjectileNet->SimulateFireEvents(Events);
+    }
+}
@@ -0,0 +1,42 @@
+#include "Net/ProjectileNetTypes.h"
+#include "Engine/NetSerialization.h"
+#include "UObject/CoreNet.h"
+#include "GameFramework/Actor.h"
+
+bool FProjectileFireEvent::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    bOutSuccess = SerializePackedVector<10, 24>(Origin, Ar);
+
+    // Shots have no roll, so two shorts give the direction to 0.0055 degrees
+    uint16 Pitch = 0;
+    uint16 Yaw = 0;
+    if (Ar.IsSaving())
+    {
+        const FRotator Rotation = Direction.Rotation();
+        Pitch = FRotator::CompressAxisToShort(Rotation.Pitch);
+        Yaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+    }
+    Ar << Pitch << Yaw;
+    if (Ar.IsLoading())
+    {
+        Direction = FRotator(FRotator::DecompressAxisFromShort(Pitch), FRotator::DecompressAxisFromShort(Yaw), 0.f).Vector();
+    }
+
+    Ar << Seed << Time;
+
+    UObject* ClassObject = ProjectileClass;
+    UObject* ShooterObject = Shooter;
+    if (Map)
+    {
+        bOutSuccess &= Map->SerializeObject(Ar, UClass::StaticClass(), ClassObject);
+        bOutSuccess &= Map->SerializeObject(Ar, AActor::StaticClass(), ShooterObject);
+    }
+    if (Ar.IsLoading())
+    {
+        ProjectileClass = Cast<UClass>(ClassObject);
+        Shooter = Cast<AActor>(ShooterObject);
+    }
+
+    bOutSuccess &= !Ar.IsError();
+    return true;
+}
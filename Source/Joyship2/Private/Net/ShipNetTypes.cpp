@@ -0,0 +1,153 @@
+#include "Net/ShipNetTypes.h"
+#include "Replay/ShipInputRecording.h"
+
+namespace
+{
+    // Zigzag so small negative values pack as small as small positive ones
+    void SerializeSignedPacked(FArchive& Ar, int32& Value)
+    {
+        uint32 Packed = ((uint32)Value << 1) ^ (uint32)(Value >> 31);
+        Ar.SerializeIntPacked(Packed);
+        if (Ar.IsLoading())
+        {
+            Value = (int32)(Packed >> 1) ^ -(int32)(Packed & 1);
+        }
+    }
+
+    int32 QuantizeSpeed(float Value)
+    {
+        return FMath::RoundToInt(FMath::Clamp(Value, -1.0e6f, 1.0e6f));
+    }
+
+    // Writes the flag; true when the optional field that follows must be serialized
+    bool SerializeOptional(FArchive& Ar, bool bPresent)
+    {
+        uint8 Bit = bPresent ? 1 : 0;
+        Ar.SerializeBits(&Bit, 1);
+        return Bit != 0;
+    }
+}
+
+/* ---------------- MOVE ---------------- */
+
+void FShipNetMove::Set(uint16 InId, float InDeltaTime, float InRotation, bool bInThrust)
+{
+    Id = InId;
+    DeltaTime = (uint16)FMath::Clamp(FMath::RoundToInt(InDeltaTime * 10000.f), 1, (int32)MAX_uint16);
+    Rotation = FShipInputFrame::QuantizeAxis(InRotation);
+    bThrust = bInThrust;
+}
+
+bool FShipNetMove::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    Ar << Id << DeltaTime;
+
+    uint8 Thrust = bThrust ? 1 : 0;
+    Ar.SerializeBits(&Thrust, 1);
+    bThrust = Thrust != 0;
+
+    if (SerializeOptional(Ar, Rotation != 0))
+    {
+        Ar << Rotation;
+    }
+    else if (Ar.IsLoading())
+    {
+        Rotation = 0;
+    }
+
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
+
+/* ---------------- STATE ---------------- */
+
+void FShipNetState::SetLocation(const FVector& Location)
+{
+    PosY = FMath::RoundToInt32(FMath::Clamp(Location.Y * 10.0, -2.0e9, 2.0e9));
+    PosZ = FMath::RoundToInt32(FMath::Clamp(Location.Z * 10.0, -2.0e9, 2.0e9));
+}
+
+void FShipNetState::SetVelocity(const FVector& Velocity)
+{
+    VelY = QuantizeSpeed((float)Velocity.Y);
+    VelZ = QuantizeSpeed((float)Velocity.Z);
+}
+
+void FShipNetState::SetTargetVelocity(const FVector& Velocity)
+{
+    TargetVelY = QuantizeSpeed((float)Velocity.Y);
+    TargetVelZ = QuantizeSpeed((float)Velocity.Z);
+}
+
+int16 FShipNetState::QuantizeRollRate(const FVector& AngularVelocity, const FVector& ForwardAxis)
+{
+    const float DegreesPerSecond = (float)FMath::RadiansToDegrees(FVector::DotProduct(AngularVelocity, ForwardAxis));
+    return (int16)FMath::Clamp(FMath::RoundToInt(DegreesPerSecond), -32767, 32767);
+}
+
+FVector FShipNetState::DequantizeRollRate(int16 DegreesPerSecond, const FVector& ForwardAxis)
+{
+    return ForwardAxis * FMath::DegreesToRadians((float)DegreesPerSecond);
+}
+
+void FShipNetState::SetFuel(float InFuel)
+{
+    bHasFuel = true;
+    Fuel = (uint16)FMath::Clamp(FMath::RoundToInt(InFuel * 10.f), 0, (int32)MAX_uint16);
+}
+
+bool FShipNetState::operator==(const FShipNetState& Other) const
+{
+    return PosY == Other.PosY && PosZ == Other.PosZ && Roll == Other.Roll
+        && VelY == Other.VelY && VelZ == Other.VelZ && RollRate == Other.RollRate
+        && TargetVelY == Other.TargetVelY && TargetVelZ == Other.TargetVelZ && TargetRollRate == Other.TargetRollRate
+        && bHasFuel == Other.bHasFuel && Fuel == Other.Fuel
+        && bHasAck == Other.bHasAck && AckedMove == Other.AckedMove;
+}
+
+bool FShipNetState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    SerializeSignedPacked(Ar, PosY);
+    SerializeSignedPacked(Ar, PosZ);
+    Ar << Roll;
+
+    // Optional groups: a resting ship sends position, roll and five zero bits
+    if (SerializeOptional(Ar, VelY != 0 || VelZ != 0 || RollRate != 0))
+    {
+        SerializeSignedPacked(Ar, VelY);
+        SerializeSignedPacked(Ar, VelZ);
+        Ar << RollRate;
+    }
+    else if (Ar.IsLoading())
+    {
+        VelY = VelZ = 0;
+        RollRate = 0;
+    }
+
+    if (SerializeOptional(Ar, TargetVelY != 0 || TargetVelZ != 0 || TargetRollRate != 0))
+    {
+        SerializeSignedPacked(Ar, TargetVelY);
+        SerializeSignedPacked(Ar, TargetVelZ);
+        Ar << TargetRollRate;
+    }
+    else if (Ar.IsLoading())
+    {
+        TargetVelY = TargetVelZ = 0;
+        TargetRollRate = 0;
+    }
+
+    bHasFuel = SerializeOptional(Ar, bHasFuel);
+    if (bHasFuel)
+    {
+        Ar << Fuel;
+    }
+
+    bHasAck = SerializeOptional(Ar, bHasAck);
+    if (bHasAck)
+    {
+        Ar << AckedMove;
+    }
+
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
@@ -1,11 +1,36 @@
 #include "Pawns/BaseShip.h"
+#include "Joyship2.h"
+#include "JoyshipProfiling.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundBase.h"
 #include "Particles/ParticleSystem.h"
-#include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/HealthComponent.h"
+#include "Components/AimAssistComponent.h"
+#include "Components/ShipNetMovementComponent.h"
+#include "Subsystems/AssetPreloadSubsystem.h"
+#include "Subsystems/ProjectileNetSubsystem.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/SimulatedProjectileSubsystem.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+namespace
+{
+    // Gravity as the nearest native class's constructor set it (players fall, enemies float)
+    bool GetNativeGravity(const UClass* Class)
+    {
+        while (Class && !Class->HasAnyClassFlags(CLASS_Native))
+        {
+            Class = Class->GetSuperClass();
+        }
+        const ABaseShip* NativeDefaults = Class ? Cast<ABaseShip>(Class->GetDefaultObject()) : nullptr;
+        return NativeDefaults && NativeDefaults->Root ? NativeDefaults->Root->IsGravityEnabled() : true;
+    }
+}
 
 ABaseShip::ABaseShip()
 {
@@ -19,6 +44,9 @@ ABaseShip::ABaseShip()
     // Enable physics and gravity by default so Blueprint can simulate physics
     Root->SetSimulatePhysics(true);
     Root->SetEnableGravity(true);
+    // Overlap and hit handlers are bound in BeginPlay
+    Root->SetGenerateOverlapEvents(true);
+    Root->SetNotifyRigidBodyCollision(true);
     SetRootComponent(Root);
 
 	// Ship mesh
@@ -27,101 +55,225 @@ ABaseShip::ABaseShip()
     // Mesh should not simulate physics when the capsule root is the physics body
     ShipMesh->SetSimulatePhysics(false);
     ShipMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+    // Aim assist target cache
+    AimAssist = CreateDefaultSubobject<UAimAssistComponent>(TEXT("AimAssist"));
+
+    // Health
+    HealthComp = CreateDefaultSubobject<UHealthComponent>(TEXT("HealthComp"));
+
+    // Movement is replicated as quantized state by NetMovement, not by the engine's movement replication
+    bReplicates = true;
+    SetReplicatingMovement(false);
+    SetNetUpdateFrequency(30.f);
+    NetMovement = CreateDefaultSubobject<UShipNetMovementComponent>(TEXT("NetMovement"));
 }
 
-void ABaseShip::BeginPlay()
+void ABaseShip::PostInitializeComponents()
 {
-	Super::BeginPlay();
-	CurrentHealth = MaxHealth;
-    if (Root)
+    Super::PostInitializeComponents();
+
+    if (HealthComp)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] BeginPlay: Root=%s Simulating=%s Gravity=%s Mass=%.2f CollisionProfile=%s CollisionEnabled=%d"),
-            *Root->GetName(),
-            Root->IsSimulatingPhysics() ? TEXT("true") : TEXT("false"),
-            Root->IsGravityEnabled() ? TEXT("true") : TEXT("false"),
-            Root->GetMass(),
-            *Root->GetCollisionProfileName().ToString(),
-            (int)Root->GetCollisionEnabled());
-        // Log world gravity
-        if (GetWorld())
+        // Ships used to keep their own health; honour a MaxHealth tuned on the ship unless the component was tuned too
+        if (HealthComp->MaxHealth == GetDefault<UHealthComponent>()->MaxHealth)
         {
-            UE_LOG(LogTemp, Warning, TEXT("[BaseShip] World gravity Z=%.2f"), GetWorld()->GetGravityZ());
+            HealthComp->MaxHealth = MaxHealth;
         }
+        MaxHealth = HealthComp->MaxHealth;
 
-        // List overlapping components (helps detect initial overlap that can block physics)
-        TArray<UPrimitiveComponent*> Overlaps;
-        Root->GetOverlappingComponents(Overlaps);
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] BeginPlay: Overlapping components count=%d"), Overlaps.Num());
-        for (UPrimitiveComponent* Comp : Overlaps)
-        {
-            if (Comp)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[BaseShip]   Overlap: %s (Simulating=%s CollisionEnabled=%d)"), *Comp->GetName(), Comp->IsSimulatingPhysics() ? TEXT("true") : TEXT("false"), (int)Comp->GetCollisionEnabled());
-            }
-        }
+        // One explode path: fall back to the ship's effects when the component has none
+        if (HealthComp->ExplosionEffect.IsNull()) HealthComp->ExplosionEffect = ExplosionEffect;
+        if (HealthComp->ExplosionSound.IsNull()) HealthComp->ExplosionSound = ExplosionSound;
 
-        // If blueprint defaults overrode C++ settings, enforce correct physics settings at runtime
-        if (!Root->IsSimulatingPhysics())
+        HealthComp->OnHealthChanged.AddDynamic(this, &ABaseShip::HandleHealthChanged);
+    }
+
+    UAssetPreloadSubsystem::Preload(this, { ProjectileClass.ToSoftObjectPath(), ExplosionEffect.ToSoftObjectPath(), ExplosionSound.ToSoftObjectPath() });
+}
+
+void ABaseShip::BeginPlay()
+{
+	Super::BeginPlay();
+	CurrentHealth = HealthComp ? HealthComp->CurrentHealth : MaxHealth;
+
+    // Pre-warm the projectile pool so the first volley does not spawn actors (once the class has loaded, for ships spawned during play)
+    if (!ProjectileClass.IsNull() && !bUseSimulatedProjectiles)
+    {
+        UAssetPreloadSubsystem::Preload(this, { ProjectileClass.ToSoftObjectPath() }, FStreamableDelegate::CreateUObject(this, &ABaseShip::PrewarmProjectilePool));
+    }
+
+    if (AimAssist)
+    {
+        AimAssist->Range = AimAssistRange;
+        AimAssist->LateralRadius = AimAssistRadius;
+        // Ships that cannot fire do not need a target
+        AimAssist->SetComponentTickEnabled(bEnableAimAssist && !ProjectileClass.IsNull());
+    }
+
+    // Index the ship for aggro, targeting and aim-assist queries
+    if (USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+    {
+        Grid->Register(this, ESpatialGridFlags::Ship);
+    }
+    if (Root)
+    {
+        // The constructor's physics setup holds unless Blueprint defaults broke it (fix every instance of the class)
+        // or this instance overrides it (level placement, construction script, spawner)
+        if (!IsPhysicsConfigValidForClass() || !IsPhysicsConfigValidForInstance())
         {
-            UE_LOG(LogTemp, Warning, TEXT("[BaseShip] BeginPlay: Enabling SimulatePhysics on Root"));
-            Root->SetSimulatePhysics(true);
+            ApplyPhysicsConfig();
         }
-        Root->SetEnableGravity(true);
-        Root->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-        Root->SetCollisionProfileName(TEXT("PhysicsActor"));
-        Root->SetMobility(EComponentMobility::Movable);
-
-        // Wake physics and apply a tiny impulse to ensure the body wakes and reacts
-        Root->WakeRigidBody();
-        Root->WakeAllRigidBodies();
-        FVector TinyImpulse = FVector(0.f, 0.f, -5.f) * Root->GetMass();
-        Root->AddImpulse(TinyImpulse);
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] BeginPlay: Applied tiny impulse=(%.2f,%.2f,%.2f) to wake body"), TinyImpulse.X, TinyImpulse.Y, TinyImpulse.Z);
-
-        // Bind overlap handler
-        Root->SetGenerateOverlapEvents(true);
+
         Root->OnComponentBeginOverlap.AddDynamic(this, &ABaseShip::OnRootBeginOverlap);
         // Also bind actor-level overlap as backup
         OnActorBeginOverlap.AddDynamic(this, &ABaseShip::OnActorBeginOverlapHandler);
-        // Bind hit handler for blocking collisions
-        Root->SetNotifyRigidBodyCollision(true);
+        // Hit handler for blocking collisions
         Root->OnComponentHit.AddDynamic(this, &ABaseShip::OnRootHit);
+    }
 
-        // Log overlap-related settings for debugging
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] Overlap settings: GenerateOverlapEvents=%d CollisionEnabled=%d ObjectType=%d Response_WorldDynamic=%d Response_PhysicsBody=%d Response_Pawn=%d"),
-            Root->GetGenerateOverlapEvents(),
-            (int)Root->GetCollisionEnabled(),
-            (int)Root->GetCollisionObjectType(),
-            (int)Root->GetCollisionResponseToChannel(ECC_WorldDynamic),
-            (int)Root->GetCollisionResponseToChannel(ECC_PhysicsBody),
-            (int)Root->GetCollisionResponseToChannel(ECC_Pawn));
+    if (bUseFixedStepSimulation)
+    {
+        InitFixedStep();
     }
 }
 
+void ABaseShip::CollectPhysicsConfigProblems(TArray<FString>& OutProblems) const
+{
+    if (!Root)
+    {
+        OutProblems.Add(TEXT("no Root capsule"));
+        return;
+    }
+
+    if (!Root->BodyInstance.bSimulatePhysics) OutProblems.Add(TEXT("Root does not simulate physics"));
+    if (Root->Mobility != EComponentMobility::Movable) OutProblems.Add(TEXT("Root is not Movable"));
+    if (Root->GetCollisionProfileName() != TEXT("PhysicsActor")) OutProblems.Add(FString::Printf(TEXT("Root collision profile is %s, not PhysicsActor"), *Root->GetCollisionProfileName().ToString()));
+    if (Root->GetCollisionEnabled() != ECollisionEnabled::QueryAndPhysics) OutProblems.Add(TEXT("Root collision is not QueryAndPhysics"));
+    if (!Root->GetGenerateOverlapEvents()) OutProblems.Add(TEXT("Root does not generate overlap events"));
+    if (!Root->BodyInstance.bNotifyRigidBodyCollision) OutProblems.Add(TEXT("Root does not notify hits"));
+    if (Root->IsGravityEnabled() != GetNativeGravity(GetClass())) OutProblems.Add(TEXT("Root gravity differs from the native class"));
+}
+
+bool ABaseShip::IsPhysicsConfigValidForClass() const
+{
+    // Cached on the class defaults, so a recompiled or reinstanced Blueprint (new CDO) is checked again
+    ABaseShip* Defaults = GetClass()->GetDefaultObject<ABaseShip>();
+    if (Defaults->PhysicsConfigValid.IsSet())
+    {
+        return Defaults->PhysicsConfigValid.GetValue();
+    }
+
+    TArray<FString> Problems;
+    Defaults->CollectPhysicsConfigProblems(Problems);
+    for (const FString& Problem : Problems)
+    {
+        UE_LOG(LogJoyshipMovement, Warning, TEXT("[BaseShip] %s: %s; fixing it on every spawn"), *GetClass()->GetName(), *Problem);
+    }
+    Defaults->PhysicsConfigValid = Problems.Num() == 0;
+    return Defaults->PhysicsConfigValid.GetValue();
+}
+
+bool ABaseShip::IsPhysicsConfigValidForInstance() const
+{
+    // No strings are built while the setup is intact, so this is a handful of compares per spawn
+    TArray<FString> Problems;
+    CollectPhysicsConfigProblems(Problems);
+    for (const FString& Problem : Problems)
+    {
+        UE_LOG(LogJoyshipMovement, Warning, TEXT("[BaseShip] %s: %s; fixing it"), *GetName(), *Problem);
+    }
+    return Problems.Num() == 0;
+}
+
+void ABaseShip::ApplyPhysicsConfig()
+{
+    // Profile first: it also sets QueryAndPhysics
+    Root->SetCollisionProfileName(TEXT("PhysicsActor"));
+    Root->SetMobility(EComponentMobility::Movable);
+    Root->SetEnableGravity(GetNativeGravity(GetClass()));
+    Root->SetGenerateOverlapEvents(true);
+    Root->SetNotifyRigidBodyCollision(true);
+    Root->SetSimulatePhysics(true);
+}
+
+#if WITH_EDITOR
+EDataValidationResult ABaseShip::IsDataValid(FDataValidationContext& Context) const
+{
+    EDataValidationResult Result = Super::IsDataValid(Context);
+
+    // Only the class defaults; placed instances follow them
+    if (HasAnyFlags(RF_ClassDefaultObject))
+    {
+        TArray<FString> Problems;
+        CollectPhysicsConfigProblems(Problems);
+        for (const FString& Problem : Problems)
+        {
+            Context.AddWarning(FText::FromString(FString::Printf(TEXT("%s: %s (fixed on every spawn at runtime)"), *GetClass()->GetName(), *Problem)));
+        }
+    }
+    return Result;
+}
+#endif
+
+void ABaseShip::PrewarmProjectilePool()
+{
+    UProjectilePoolSubsystem* Pool = GetWorld() ? GetWorld()->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+    if (Pool && GetProjectileClass() && !IsActorBeingDestroyed())
+    {
+        Pool->Prewarm(GetProjectileClass(), ProjectilePoolPrewarm);
+    }
+}
+
+void ABaseShip::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+    {
+        Grid->Unregister(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ABaseShip::OnRootBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[BaseShip] OnRootBeginOverlap: Other=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"));
+    UE_LOG(LogJoyshipCombat, Verbose, TEXT("[BaseShip] OnRootBeginOverlap: Other=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"));
 }
 
 void ABaseShip::OnActorBeginOverlapHandler(AActor* OverlappedActor, AActor* OtherActor)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[BaseShip] OnActorBeginOverlap: Other=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"));
+    UE_LOG(LogJoyshipCombat, Verbose, TEXT("[BaseShip] OnActorBeginOverlap: Other=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"));
 }
 
 void ABaseShip::OnRootHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[BaseShip] OnRootHit: Other=%s Normal=(%.2f,%.2f,%.2f)"), OtherActor ? *OtherActor->GetName() : TEXT("None"), NormalImpulse.X, NormalImpulse.Y, NormalImpulse.Z);
+    UE_LOG(LogJoyshipCombat, Verbose, TEXT("[BaseShip] OnRootHit: Other=%s Normal=(%.2f,%.2f,%.2f)"), OtherActor ? *OtherActor->GetName() : TEXT("None"), NormalImpulse.X, NormalImpulse.Y, NormalImpulse.Z);
 }
 
 void ABaseShip::Tick(float DeltaTime)
 {
+	JOYSHIP_TIMING_SCOPE(ShipTick);
+
 	Super::Tick(DeltaTime);
 
+	// Networked: predicted, proxied or driven by client moves instead of simulated here
+	if (NetMovement && NetMovement->TickNetworkMovement(DeltaTime))
+	{
+		return;
+	}
+
+	if (bUseFixedStepSimulation)
+	{
+		TickFixedStep(DeltaTime);
+		return;
+	}
+
 	// Apply drag
     // If physics is simulating, let the physics system drive movement
     if (Root && !Root->IsSimulatingPhysics())
     {
-        Velocity *= Drag;
+        // Drag is tuned per 60 Hz frame; scale it by DeltaTime so throttled ticks decelerate the same
+        Velocity *= FMath::Pow(Drag, DeltaTime * 60.f);
 
         // Clamp speed
         if (Velocity.SizeSquared() > MaxSpeed * MaxSpeed)
@@ -136,7 +288,7 @@ void ABaseShip::Tick(float DeltaTime)
     {
         // When simulating physics, update stored velocity from the physics body
         Velocity = Root->GetComponentVelocity();
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] Tick: Physics simulated. Velocity=(%.2f,%.2f,%.2f) Mass=%.2f"), Velocity.X, Velocity.Y, Velocity.Z, Root->GetMass());
+        JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, VeryVerbose, 1.0, TEXT("[BaseShip] Tick: Physics simulated. Velocity=(%.2f,%.2f,%.2f) Mass=%.2f"), Velocity.X, Velocity.Y, Velocity.Z, Root->GetMass());
 
         // Smoothly interpolate towards target velocities (set by input handlers)
         FVector CurLin = Root->GetPhysicsLinearVelocity();
@@ -147,10 +299,10 @@ void ABaseShip::Tick(float DeltaTime)
         {
             FVector Boost = TargetLinearVelocity * 0.25f;
             NewLin = FMath::VInterpTo(CurLin, Boost, DeltaTime, FMath::Max(LinearSmooth * 4.f, 10.f));
-            UE_LOG(LogTemp, Warning, TEXT("[BaseShip] Tick: Boosting start movement. Boost=(%.2f,%.2f,%.2f)"), Boost.X, Boost.Y, Boost.Z);
+            JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, VeryVerbose, 1.0, TEXT("[BaseShip] Tick: Boosting start movement. Boost=(%.2f,%.2f,%.2f)"), Boost.X, Boost.Y, Boost.Z);
         }
 
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] Tick: CurLin=(%.2f,%.2f,%.2f) TargetLin=(%.2f,%.2f,%.2f) NewLin=(%.2f,%.2f,%.2f)"),
+        JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, VeryVerbose, 1.0, TEXT("[BaseShip] Tick: CurLin=(%.2f,%.2f,%.2f) TargetLin=(%.2f,%.2f,%.2f) NewLin=(%.2f,%.2f,%.2f)"),
             CurLin.X, CurLin.Y, CurLin.Z,
             TargetLinearVelocity.X, TargetLinearVelocity.Y, TargetLinearVelocity.Z,
             NewLin.X, NewLin.Y, NewLin.Z);
@@ -166,26 +318,30 @@ void ABaseShip::Tick(float DeltaTime)
 
 void ABaseShip::RotateShip(float Input, float DeltaTime)
 {
-    // Log entry so we can see incoming input and physics state
+    // Log entry so we can see incoming input and physics state (throttled; arguments are only evaluated when it prints)
     if (Root)
     {
-        FVector CurAngVel = Root->GetPhysicsAngularVelocityInRadians();
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] RotateShip ENTRY: Input=%.4f Simulating=%s CurAngVel=(%.4f,%.4f,%.4f)"), Input, Root->IsSimulatingPhysics() ? TEXT("true") : TEXT("false"), CurAngVel.X, CurAngVel.Y, CurAngVel.Z);
+        JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, VeryVerbose, 1.0, TEXT("[BaseShip] RotateShip ENTRY: Input=%.4f Simulating=%s CurAngVel=%s"), Input, Root->IsSimulatingPhysics() ? TEXT("true") : TEXT("false"), *Root->GetPhysicsAngularVelocityInRadians().ToString());
     }
 
     // If input is nearly zero, stop any physics angular velocity so the ship stops rotating.
     if (FMath::IsNearlyZero(Input))
     {
-        if (Root && Root->IsSimulatingPhysics())
+        if (bUseFixedStepSimulation)
+        {
+            TargetAngularVelocity = FVector::ZeroVector;
+            FixedAngularVelocity = FVector::ZeroVector;
+        }
+        else if (Root && Root->IsSimulatingPhysics())
         {
             Root->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector, false);
-            UE_LOG(LogTemp, Warning, TEXT("[BaseShip] RotateShip: Input nearly zero  cleared angular velocity"));
+            JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, VeryVerbose, 1.0, TEXT("[BaseShip] RotateShip: Input nearly zero - cleared angular velocity"));
         }
         return;
     }
 
-    // If physics is enabled, directly set angular velocity to avoid unbounded spin.
-    if (Root && Root->IsSimulatingPhysics())
+    // If physics (or the fixed-step simulation) is enabled, set a target angular velocity to avoid unbounded spin.
+    if (UsesTargetVelocities())
     {
         // Desired angular speed in degrees/sec -> convert to radians/sec
         float DesiredDegPerSec = -Input * TurnSpeed;
@@ -200,14 +356,14 @@ void ABaseShip::RotateShip(float Input, float DeltaTime)
 
         FVector AngularVel = RollAxis * DesiredRadPerSec;
         TargetAngularVelocity = AngularVel;
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] RotateShip: Set TargetAngularVelocity=(%.2f,%.2f,%.2f) (rad/s) Input=%.2f"), AngularVel.X, AngularVel.Y, AngularVel.Z, Input);
+        JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, VeryVerbose, 1.0, TEXT("[BaseShip] RotateShip: Set TargetAngularVelocity=(%.2f,%.2f,%.2f) (rad/s) Input=%.2f"), AngularVel.X, AngularVel.Y, AngularVel.Z, Input);
     }
     else
     {
         FRotator Rot = GetActorRotation();
         Rot.Roll += -Input * TurnSpeed * DeltaTime;
         SetActorRotation(Rot);
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] RotateShip: Kinematic rotation applied. NewRoll=%.2f Input=%.2f"), Rot.Roll, Input);
+        JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, VeryVerbose, 1.0, TEXT("[BaseShip] RotateShip: Kinematic rotation applied. NewRoll=%.2f Input=%.2f"), Rot.Roll, Input);
     }
 }
 
@@ -215,137 +371,232 @@ void ABaseShip::ApplyThrust(float DeltaTime)
 {
     FVector Forward = GetActorUpVector();
 
-    if (Root && Root->IsSimulatingPhysics())
+    if (UsesTargetVelocities())
     {
         // Set target linear velocity (smoothed each Tick)
         FVector DesiredVel = Forward * ThrustForce; // treat ThrustForce as target speed for simplicity
         TargetLinearVelocity = DesiredVel;
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] ApplyThrust: Set TargetLinearVelocity=(%.2f,%.2f,%.2f)"), DesiredVel.X, DesiredVel.Y, DesiredVel.Z);
+        JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, VeryVerbose, 1.0, TEXT("[BaseShip] ApplyThrust: Set TargetLinearVelocity=(%.2f,%.2f,%.2f)"), DesiredVel.X, DesiredVel.Y, DesiredVel.Z);
     }
     else
     {
         Velocity += Forward * ThrustForce * DeltaTime;
-        UE_LOG(LogTemp, Warning, TEXT("[BaseShip] ApplyThrust: Kinematic thrust. Velocity=(%.2f,%.2f,%.2f)"), Velocity.X, Velocity.Y, Velocity.Z);
+        JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, VeryVerbose, 1.0, TEXT("[BaseShip] ApplyThrust: Kinematic thrust. Velocity=(%.2f,%.2f,%.2f)"), Velocity.X, Velocity.Y, Velocity.Z);
     }
 }
 
-/* ---------------- HEALTH ---------------- */
+/* ---------------- FIXED-STEP SIMULATION ---------------- */
 
-void ABaseShip::ApplyDamage(float DamageAmount)
+void ABaseShip::InitFixedStep()
 {
-	CurrentHealth -= DamageAmount;
+    if (Root)
+    {
+        // The simulation owns movement from here on; engine physics would fight it
+        Velocity = Root->GetComponentVelocity();
+        Root->SetSimulatePhysics(false);
+    }
 
-	if (CurrentHealth <= 0.f)
-	{
-		OnShipDestroyed();
-	}
+    FixedStepAccumulator = 0.f;
+    FixedAngularVelocity = FVector::ZeroVector;
+    PrevStepTransform = CurrStepTransform = GetActorTransform();
+    MeshRelativeTransform = ShipMesh ? ShipMesh->GetRelativeTransform() : FTransform::Identity;
 }
 
-void ABaseShip::OnShipDestroyed()
+void ABaseShip::TickFixedStep(float DeltaTime)
 {
-    PlayExplosionEffect();
-    Destroy();
+    // Moved by something else since the last step (teleport, batched steering): continue from there
+    const FTransform ActorTransform = GetActorTransform();
+    if (!ActorTransform.GetLocation().Equals(CurrStepTransform.GetLocation()))
+    {
+        PrevStepTransform = CurrStepTransform = ActorTransform;
+    }
+    else if (!ActorTransform.GetRotation().Equals(CurrStepTransform.GetRotation()))
+    {
+        CurrStepTransform.SetRotation(ActorTransform.GetRotation());
+    }
+
+    const float Step = 1.f / FMath::Max(FixedStepRate, 1.f);
+    FixedStepAccumulator += DeltaTime;
+
+    int32 Steps = 0;
+    while (FixedStepAccumulator >= Step && Steps < MaxFixedStepsPerFrame)
+    {
+        PrevStepTransform = CurrStepTransform;
+        PreFixedStep(Step);
+        StepFixedSimulation(Step);
+        CurrStepTransform = GetActorTransform();
+        FixedStepAccumulator -= Step;
+        ++Steps;
+    }
+
+    if (FixedStepAccumulator >= Step)
+    {
+        JOYSHIP_LOG_THROTTLED(LogJoyshipMovement, Warning, 1.0, TEXT("[BaseShip] %s: fixed-step budget exceeded, dropping %.3fs"), *GetName(), FixedStepAccumulator - FMath::Fmod(FixedStepAccumulator, Step));
+        FixedStepAccumulator = FMath::Fmod(FixedStepAccumulator, Step);
+    }
+
+    // Draw the mesh between the last two steps so motion is smooth at any frame rate
+    if (ShipMesh)
+    {
+        FTransform Blended;
+        Blended.Blend(PrevStepTransform, CurrStepTransform, FixedStepAccumulator / Step);
+        ShipMesh->SetWorldTransform(MeshRelativeTransform * Blended);
+    }
 }
 
-void ABaseShip::PlayExplosionEffect()
+void ABaseShip::StepFixedSimulation(float StepSeconds)
 {
-    FVector Loc = GetActorLocation();
-    FRotator Rot = GetActorRotation();
+    // Rotation: angular velocity eases toward the target set by RotateShip (same response as the physics path)
+    FixedAngularVelocity += (TargetAngularVelocity - FixedAngularVelocity) * (1.f - FMath::Exp(-AngularSmooth * StepSeconds));
+
+    FQuat Rotation = GetActorQuat();
+    const float AngularSpeed = FixedAngularVelocity.Size();
+    if (AngularSpeed > KINDA_SMALL_NUMBER)
+    {
+        Rotation = FQuat(FixedAngularVelocity / AngularSpeed, AngularSpeed * StepSeconds) * Rotation;
+        Rotation.Normalize();
+    }
 
-    if (ExplosionEffect)
+    // Gravity, then velocity eases toward the thrust target, then drag
+    if (Root && Root->IsGravityEnabled())
     {
-        UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplosionEffect, Loc, Rot);
+        Velocity.Z -= GravityForce * StepSeconds;
     }
+    Velocity += (TargetLinearVelocity - Velocity) * (1.f - FMath::Exp(-LinearSmooth * StepSeconds));
+    Velocity *= FMath::Pow(Drag, StepSeconds * 60.f);
+
+    // Play plane is ZY
+    Velocity.X = 0.f;
+    if (Velocity.SizeSquared() > MaxSpeed * MaxSpeed)
+    {
+        Velocity = Velocity.GetSafeNormal() * MaxSpeed;
+    }
+
+    // Kinematic move with a sweep; slide along whatever blocks us
+    FHitResult Hit;
+    SetActorLocationAndRotation(GetActorLocation() + Velocity * StepSeconds, Rotation, true, &Hit);
+    if (Hit.bBlockingHit)
+    {
+        Velocity = FVector::VectorPlaneProject(Velocity, Hit.ImpactNormal);
+    }
+}
+
+void ABaseShip::SimulateNetMove(const FShipNetMove& Move)
+{
+    StepFixedSimulation(Move.GetDeltaTime());
+}
 
-    if (ExplosionSound)
+/* ---------------- HEALTH ---------------- */
+
+void ABaseShip::ApplyDamage(float DamageAmount)
+{
+	if (HealthComp)
+	{
+		HealthComp->ApplyDamage(DamageAmount);
+	}
+}
+
+void ABaseShip::OnShipDestroyed()
+{
+    if (HealthComp)
     {
-        UGameplayStatics::PlaySoundAtLocation(GetWorld(), ExplosionSound, Loc);
+        HealthComp->Explode();
     }
 }
 
+void ABaseShip::HandleHealthChanged(UHealthComponent* InHealthComp, float NewHealth)
+{
+	CurrentHealth = NewHealth;
+}
+
+FVector ABaseShip::GetMuzzleLocation() const
+{
+    return GetActorLocation() + GetActorUpVector() * MuzzleOffset.Z + GetActorForwardVector() * MuzzleOffset.X + GetActorRightVector() * MuzzleOffset.Y;
+}
+
 void ABaseShip::Fire()
 {
-    if (!ProjectileClass) return;
+    JOYSHIP_TIMING_SCOPE(Fire);
+
+    ++FireCount;
+
+    UClass* Projectile = GetProjectileClass();
+    if (!Projectile) return;
     UWorld* World = GetWorld();
     if (!World) return;
 
+    // Proxies on other clients draw the server's fire events instead
+    const bool bNetworked = GetNetMode() != NM_Standalone;
+    if (bNetworked && !HasAuthority() && !IsLocallyControlled()) return;
+
     // Spawn at the ship's muzzle using the ship's up/forward/right offsets
-    FVector SpawnLoc = GetActorLocation() + GetActorUpVector() * MuzzleOffset.Z + GetActorForwardVector() * MuzzleOffset.X + GetActorRightVector() * MuzzleOffset.Y;
+    FVector SpawnLoc = GetMuzzleLocation();
     FRotator SpawnRot = GetActorRotation();
 
-    // Aim assist: trace forward and, if we hit an actor with a HealthComponent, adjust spawn rotation to aim at it
-    if (bEnableAimAssist)
+    // Aim assist: aim at the cached target (no query here; the component keeps it up to date)
+    if (bEnableAimAssist && AimAssist && AimAssist->GetCurrentTarget())
     {
-        FVector TraceStart = SpawnLoc;
-        FVector TraceDir = GetActorUpVector();
-        FVector TraceEnd = TraceStart + TraceDir * AimAssistRange;
-
-        FHitResult Hit;
-        FCollisionQueryParams Params;
-        Params.AddIgnoredActor(this);
-
-        bool bHitSomething = false;
-        AActor* BestTarget = nullptr;
-
-        // Use object type queries so we hit actors whose components overlap pawns
-        FCollisionObjectQueryParams ObjParams;
-        ObjParams.AddObjectTypesToQuery(ECC_Pawn);
-        ObjParams.AddObjectTypesToQuery(ECC_PhysicsBody);
-        ObjParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+        SpawnRot = AimAssist->GetAimDirection(SpawnLoc, GetActorUpVector()).Rotation();
+    }
 
-        if (AimAssistRadius > 0.f)
-        {
-            // Sphere sweep by object type to find candidates
-            TArray<FHitResult> Hits;
-            bool bHit = World->SweepMultiByObjectType(Hits, TraceStart, TraceEnd, FQuat::Identity, ObjParams, FCollisionShape::MakeSphere(AimAssistRadius), Params);
-            if (bHit)
-            {
-                for (const FHitResult& H : Hits)
-                {
-                    if (H.GetActor() && H.GetActor() != this)
-                    {
-                        if (H.GetActor()->FindComponentByClass<UHealthComponent>())
-                        {
-                            BestTarget = H.GetActor();
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-        else
+    UProjectileNetSubsystem* ProjectileNet = bNetworked ? World->GetSubsystem<UProjectileNetSubsystem>() : nullptr;
+    if (ProjectileNet)
+    {
+        FProjectileFireEvent Event;
+        Event.Origin = SpawnLoc;
+        Event.Direction = GetActorUpVector();
+        Event.Seed = (uint16)FireCount;
+        Event.ProjectileClass = Projectile;
+        Event.Shooter = this;
+
+        if (!HasAuthority())
         {
-            // Line trace by object type
-            if (World->LineTraceSingleByObjectType(Hit, TraceStart, TraceEnd, ObjParams, Params))
+            // Owning client: show the shot now, the server decides what it hits
+            Event.Time = (float)ProjectileNet->GetViewTime();
+            if (USimulatedProjectileSubsystem* Sim = World->GetSubsystem<USimulatedProjectileSubsystem>())
             {
-                if (Hit.GetActor() && Hit.GetActor()->FindComponentByClass<UHealthComponent>())
-                {
-                    BestTarget = Hit.GetActor();
-                }
+                Sim->Fire(Projectile, SpawnLoc, Event.Direction, this, nullptr);
             }
+            ServerFire(Event);
+            return;
         }
 
-        if (BestTarget)
-        {
-            FVector AimLoc = BestTarget->GetActorLocation();
-            FVector AimDir = (AimLoc - SpawnLoc).GetSafeNormal();
-            SpawnRot = AimDir.Rotation();
-        }
+        Event.Time = (float)ProjectileNet->GetServerTime();
+        ProjectileNet->QueueFireEvent(Event);
     }
 
-    FActorSpawnParameters Params;
-    Params.Owner = this;
-    Params.Instigator = Cast<APawn>(GetInstigator());
+    // Force the projectile to travel along the ship's up vector
+    LaunchProjectile(SpawnLoc, SpawnRot, GetActorUpVector());
+}
 
-    AActor* Projectile = World->SpawnActor<AActor>(ProjectileClass, SpawnLoc, SpawnRot, Params);
-    if (Projectile)
+void ABaseShip::LaunchProjectile(const FVector& Location, const FRotator& Rotation, const FVector& Direction)
+{
+    UWorld* World = GetWorld();
+    UClass* Projectile = GetProjectileClass();
+    if (!Projectile || !World) return;
+
+    // Simulated mode: no actor, just an entry in the projectile arrays
+    if (bUseSimulatedProjectiles)
     {
-        // Try to set initial velocity if it has a ProjectileMovementComponent
-        UProjectileMovementComponent* PM = Projectile->FindComponentByClass<UProjectileMovementComponent>();
-        if (PM)
+        USimulatedProjectileSubsystem* Sim = World->GetSubsystem<USimulatedProjectileSubsystem>();
+        if (Sim && Sim->Fire(Projectile, Location, Direction, this, Cast<APawn>(GetInstigator())))
         {
-            // Force the projectile to travel along the ship's up vector
-            PM->Velocity = GetActorUpVector() * PM->InitialSpeed;
+            return;
         }
     }
+
+    // Projectiles come from the world pool; non-AProjectile classes fall back to SpawnActor inside the pool
+    UProjectilePoolSubsystem* Pool = World->GetSubsystem<UProjectilePoolSubsystem>();
+    if (Pool)
+    {
+        Pool->SpawnProjectile(Projectile, Location, Rotation, Direction, this, Cast<APawn>(GetInstigator()));
+    }
+}
+
+void ABaseShip::ServerFire_Implementation(const FProjectileFireEvent& Event)
+{
+    if (UProjectileNetSubsystem* ProjectileNet = GetWorld()->GetSubsystem<UProjectileNetSubsystem>())
+    {
+        ProjectileNet->ResolveClientShot(this, Event);
+    }
 }
@@ -1,10 +1,15 @@
 #include "Pawns/EnemyShip.h"
+#include "Joyship2.h"
+#include "JoyshipProfiling.h"
 #include "Components/SphereComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/Actor.h"
 #include "Kismet/GameplayStatics.h"
-#include "Components/HealthComponent.h"
 #include "Pawns/PlayerShip.h"
+#include "Subsystems/EnemySteeringSubsystem.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "Subsystems/StreamingCellSubsystem.h"
+#include "Subsystems/TickSignificanceSubsystem.h"
 
 AEnemyShip::AEnemyShip()
 {
@@ -18,9 +23,6 @@ AEnemyShip::AEnemyShip()
     // Use a simple overlap profile so it reliably generates overlaps for pawns
     AggroSphere->SetCollisionProfileName(TEXT("OverlapOnlyPawn"));
 
-    // Health component
-    HealthComp = CreateDefaultSubobject<UHealthComponent>(TEXT("HealthComp"));
-
     // Ensure the enemy is not affected by gravity
     if (Root)
     {
@@ -30,21 +32,83 @@ AEnemyShip::AEnemyShip()
     }
 }
 
+void AEnemyShip::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    // A placed enemy killed before its cell streamed out stays dead
+    UStreamingCellSubsystem::DiscardIfConsumed(this);
+}
+
 void AEnemyShip::BeginPlay()
 {
     Super::BeginPlay();
 
-    // Reinforce gravity disable in case Blueprints or defaults changed it
-    if (Root)
+    JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveEnemies, 1);
+
+    if (UStreamingCellSubsystem* Cells = GetWorld()->GetSubsystem<UStreamingCellSubsystem>())
     {
-        Root->SetEnableGravity(false);
+        Cells->AddCellActor(this);
+    }
+
+    // Hand steering over to the batched manager (server only; clients get the result through NetMovement)
+    UEnemySteeringSubsystem* Steering = (GetWorld() && HasAuthority()) ? GetWorld()->GetSubsystem<UEnemySteeringSubsystem>() : nullptr;
+    if (Steering)
+    {
+        Steering->RegisterEnemy(this);
+        bSteeringBatched = true;
     }
 
     if (AggroSphere)
     {
-        AggroSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemyShip::OnAggroBeginOverlap);
-        AggroSphere->OnComponentEndOverlap.AddDynamic(this, &AEnemyShip::OnAggroEndOverlap);
+        if (!HasAuthority() || (bUseSpatialAggro && Steering && GetWorld()->GetSubsystem<USpatialGridSubsystem>()))
+        {
+            // The steering manager checks aggro against the spatial grid (server only); the sphere only defines the radius
+            AggroSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+            AggroSphere->SetGenerateOverlapEvents(false);
+        }
+        else
+        {
+            bUseSpatialAggro = false;
+            AggroSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemyShip::OnAggroBeginOverlap);
+            AggroSphere->OnComponentEndOverlap.AddDynamic(this, &AEnemyShip::OnAggroEndOverlap);
+        }
     }
+
+    if (UTickSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UTickSignificanceSubsystem>())
+    {
+        Significance->Register(this, [this](ESignificanceTier Tier)
+        {
+            SignificanceTier = Tier;
+            RefreshTickState();
+        });
+    }
+}
+
+void AEnemyShip::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveEnemies, -1);
+
+    if (bSteeringBatched)
+    {
+        if (UEnemySteeringSubsystem* Steering = GetWorld() ? GetWorld()->GetSubsystem<UEnemySteeringSubsystem>() : nullptr)
+        {
+            Steering->UnregisterEnemy(this);
+        }
+        bSteeringBatched = false;
+    }
+
+    if (UTickSignificanceSubsystem* Significance = GetWorld() ? GetWorld()->GetSubsystem<UTickSignificanceSubsystem>() : nullptr)
+    {
+        Significance->Unregister(this);
+    }
+
+    if (UStreamingCellSubsystem* Cells = GetWorld() ? GetWorld()->GetSubsystem<UStreamingCellSubsystem>() : nullptr)
+    {
+        Cells->RemoveCellActor(this, EndPlayReason, EndPlayReason == EEndPlayReason::Destroyed);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AEnemyShip::StartFollowing(AActor* Target)
@@ -52,91 +116,109 @@ void AEnemyShip::StartFollowing(AActor* Target)
     if (!Target) return;
     FollowTarget = Target;
     bFollowing = true;
-    UE_LOG(LogTemp, Warning, TEXT("[EnemyShip] StartFollowing called for %s"), *Target->GetName());
+    RefreshTickState();
+    UE_LOG(LogJoyshipMovement, Verbose, TEXT("[EnemyShip] StartFollowing called for %s"), *Target->GetName());
 }
 
 void AEnemyShip::StopFollowing()
 {
-    FollowTarget = nullptr;
+    FollowTarget.Reset();
     bFollowing = false;
     TargetLinearVelocity = FVector::ZeroVector;
-    UE_LOG(LogTemp, Warning, TEXT("[EnemyShip] StopFollowing called"));
+    RefreshTickState();
+    UE_LOG(LogJoyshipMovement, Verbose, TEXT("[EnemyShip] StopFollowing called"));
+}
+
+void AEnemyShip::RefreshTickState()
+{
+    // A follower keeps ticking (its velocity smoothing runs in ABaseShip::Tick), at worst at the dormant rate
+    const bool bShouldTick = bFollowing || SignificanceTier != ESignificanceTier::Dormant;
+    if (bShouldTick)
+    {
+        const UTickSignificanceSubsystem* Significance = GetWorld() ? GetWorld()->GetSubsystem<UTickSignificanceSubsystem>() : nullptr;
+        SetActorTickInterval(Significance ? Significance->GetTierTickInterval(SignificanceTier) : 0.f);
+    }
+    if (IsActorTickEnabled() != bShouldTick)
+    {
+        SetActorTickEnabled(bShouldTick);
+    }
 }
 
 void AEnemyShip::Tick(float DeltaTime)
 {
+    JOYSHIP_TIMING_SCOPE(EnemyTick);
+
     Super::Tick(DeltaTime);
 
-    if (bFollowing && FollowTarget)
+    // Followers are normally steered in one pass by UEnemySteeringSubsystem; proxies are moved by NetMovement
+    if (bSteeringBatched || !HasAuthority()) return;
+
+    const AActor* Target = FollowTarget.Get();
+    if (bFollowing && Target)
     {
-        FVector ToTarget = FollowTarget->GetActorLocation() - GetActorLocation();
-        ToTarget.X = 0.f; // keep movement in ZY plane
-        float Dist = ToTarget.Size();
-        if (Dist > KINDA_SMALL_NUMBER)
-        {
-            FVector Dir = ToTarget.GetSafeNormal();
-
-            // Compute rotation so that the actor's Up vector points toward the target direction
-            FVector CurrentUp = GetActorUpVector();
-            FVector DesiredUp = Dir;
-
-            // Build quaternions from the two directions and slerp between them for smooth turning
-            FQuat CurQuat = GetActorQuat();
-            FQuat FromTo = FQuat::FindBetweenNormals(CurrentUp, DesiredUp);
-            FQuat TargetQuat = FromTo * CurQuat;
-
-            // Slerp toward target quaternion
-            FQuat NewQuat = FQuat::Slerp(CurQuat, TargetQuat, FMath::Clamp(RotationSpeed * DeltaTime, 0.f, 1.f));
-            FRotator NewRot = NewQuat.Rotator();
-            // Apply the full rotation so the actor's Up vector aligns with the desired direction
-            SetActorRotation(NewRot);
-
-            // Move forward along actor up vector (matching ABaseShip thrust axis)
-            // Project movement onto the ZY plane so the enemy does not move along X
-            FVector MoveDir = GetActorUpVector();
-            MoveDir.X = 0.f;
-            if (MoveDir.SizeSquared() > KINDA_SMALL_NUMBER)
-            {
-                MoveDir = MoveDir.GetSafeNormal();
-                TargetLinearVelocity = MoveDir * ThrustForce;
-            }
-            else
-            {
-                TargetLinearVelocity = FVector::ZeroVector;
-            }
-        }
-        else
-        {
-            TargetLinearVelocity = FVector::ZeroVector;
-        }
+        FQuat NewQuat;
+        FVector NewVelocity;
+        UEnemySteeringSubsystem::ComputeSteering(GetActorLocation(), GetActorQuat(), Target->GetActorLocation(), RotationSpeed, ThrustForce, DeltaTime, NewQuat, NewVelocity);
+        ApplySteering(NewQuat, NewVelocity);
     }
 }
 
+void AEnemyShip::ApplySteering(const FQuat& NewRotation, const FVector& NewTargetVelocity)
+{
+    // Apply the full rotation so the actor's Up vector aligns with the desired direction
+    if (!NewRotation.Equals(GetActorQuat()))
+    {
+        SetActorRotation(NewRotation);
+    }
+    TargetLinearVelocity = NewTargetVelocity;
+}
+
 void AEnemyShip::OnAggroBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[EnemyShip] OnAggroBeginOverlap Other=%s Comp=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"), OtherComp ? *OtherComp->GetName() : TEXT("None"));
+    UE_LOG(LogJoyshipCombat, VeryVerbose, TEXT("[EnemyShip] OnAggroBeginOverlap Other=%s Comp=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"), OtherComp ? *OtherComp->GetName() : TEXT("None"));
     if (!OtherActor) return;
 
     // If player pawn, start following
-    APlayerShip* PS = Cast<APlayerShip>(OtherActor);
-    if (PS)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("[EnemyShip] Player entered aggro sphere: %s"), *PS->GetName());
-        FollowTarget = PS;
-        bFollowing = true;
-    }
+    NotifyAggroEnter(Cast<APlayerShip>(OtherActor));
 }
 
 void AEnemyShip::OnAggroEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[EnemyShip] OnAggroEndOverlap Other=%s Comp=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"), OtherComp ? *OtherComp->GetName() : TEXT("None"));
+    UE_LOG(LogJoyshipCombat, VeryVerbose, TEXT("[EnemyShip] OnAggroEndOverlap Other=%s Comp=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"), OtherComp ? *OtherComp->GetName() : TEXT("None"));
     if (!OtherActor) return;
-    APlayerShip* PS = Cast<APlayerShip>(OtherActor);
-    if (PS && PS == FollowTarget)
+    NotifyAggroExit(Cast<APlayerShip>(OtherActor));
+}
+
+float AEnemyShip::GetAggroRadius() const
+{
+    return AggroSphere ? AggroSphere->GetScaledSphereRadius() : 0.f;
+}
+
+void AEnemyShip::NotifyAggroEnter(APlayerShip* Player)
+{
+    if (!Player) return;
+
+    UE_LOG(LogJoyshipCombat, Verbose, TEXT("[EnemyShip] Player entered aggro sphere: %s"), *Player->GetName());
+    AggroPlayer = Player;
+    FollowTarget = Player;
+    bFollowing = true;
+    RefreshTickState();
+}
+
+void AEnemyShip::NotifyAggroExit(APlayerShip* Player)
+{
+    if (!Player) return;
+    if (Player == AggroPlayer.Get())
+    {
+        AggroPlayer.Reset();
+    }
+
+    if (Player == FollowTarget.Get())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[EnemyShip] Player left aggro sphere: %s"), *PS->GetName());
-        FollowTarget = nullptr;
+        UE_LOG(LogJoyshipCombat, Verbose, TEXT("[EnemyShip] Player left aggro sphere: %s"), *Player->GetName());
+        FollowTarget.Reset();
         bFollowing = false;
         TargetLinearVelocity = FVector::ZeroVector;
+        RefreshTickState();
     }
 }
@@ -1,6 +1,17 @@
 #include "Pawns/PlayerShip.h"
+#include "Joyship2.h"
 #include "GameFramework/PlayerController.h"
 #include "Components/InputComponent.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputMappingContext.h"
+#include "InputAction.h"
+#include "Engine/LocalPlayer.h"
+#include "UObject/ConstructorHelpers.h"
+#include "Components/HealthComponent.h"
+#include "Components/ShipNetMovementComponent.h"
+#include "Misc/Paths.h"
+#include "Subsystems/SpatialGridSubsystem.h"
 
 APlayerShip::APlayerShip()
 {
@@ -20,6 +31,16 @@ APlayerShip::APlayerShip()
 	// Camera
 	Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
 	Camera->SetupAttachment(SpringArm);
+
+	// Project input assets as defaults (Blueprints can override)
+	static ConstructorHelpers::FObjectFinder<UInputMappingContext> MappingContextFinder(TEXT("/Game/Input/IMC_Joyship.IMC_Joyship"));
+	static ConstructorHelpers::FObjectFinder<UInputAction> ThrustActionFinder(TEXT("/Game/Input/InputActions/IA_Thrust.IA_Thrust"));
+	static ConstructorHelpers::FObjectFinder<UInputAction> FireActionFinder(TEXT("/Game/Input/InputActions/IA_Fire.IA_Fire"));
+	static ConstructorHelpers::FObjectFinder<UInputAction> RotateActionFinder(TEXT("/Game/Input/InputActions/IA_Rotate.IA_Rotate"));
+	DefaultMappingContext = MappingContextFinder.Object;
+	ThrustAction = ThrustActionFinder.Object;
+	FireAction = FireActionFinder.Object;
+	RotateAction = RotateActionFinder.Object;
 }
 
 void APlayerShip::BeginPlay()
@@ -28,13 +49,72 @@ void APlayerShip::BeginPlay()
 
     // initialize fuel
     CurrentFuel = MaxFuel;
+
+    // Enemies and turrets look for players through the spatial grid
+    if (USpatialGridSubsystem* Grid = GetWorld() ? GetWorld()->GetSubsystem<USpatialGridSubsystem>() : nullptr)
+    {
+        Grid->Register(this, ESpatialGridFlags::Player);
+    }
 }
 
 void APlayerShip::Tick(float DeltaTime)
 {
+	// Controls are applied before Super::Tick integrates movement, so input moves the ship on the frame it arrives.
+	// The fixed-step simulation takes its input step by step instead (PreFixedStep).
+	const bool bPerStepInput = ConsumesInputPerStep();
+	if (!bPerStepInput)
+	{
+		ConsumeBufferedInput();
+	}
+
+	// Replayed shots happen where recorded ones did (input runs before pawns tick)
+	if (bRecordingInput || IsReplayingInput())
+	{
+		ProcessRecordedInput(DeltaTime);
+	}
+
+	if (NetMovement && NetMovement->IsDrivenByMoves())
+	{
+		// Owning client predicts (controls and movement in one move); the server applies moves as they arrive
+		if (IsLocallyControlled())
+		{
+			NetMovement->PredictMove(DeltaTime, RotationInput, bThrusting);
+		}
+	}
+	else if (!bPerStepInput)
+	{
+		ApplyShipControls(DeltaTime);
+	}
+
 	Super::Tick(DeltaTime);
+}
+
+bool APlayerShip::ConsumesInputPerStep() const
+{
+	// Recording and replay keep whole-frame input so a session replays exactly
+	return bUseFixedStepSimulation && !(NetMovement && NetMovement->IsDrivenByMoves()) && !bRecordingInput && !IsReplayingInput();
+}
+
+void APlayerShip::PreFixedStep(float StepSeconds)
+{
+	if (!ConsumesInputPerStep()) return;
 
-	// Apply rotation every frame
+	ConsumeBufferedInput(true);
+	ApplyShipControls(StepSeconds);
+}
+
+void APlayerShip::SimulateNetMove(const FShipNetMove& Move)
+{
+	RotationInput = Move.GetRotation();
+	bThrusting = Move.bThrust;
+
+	const float MoveDeltaTime = Move.GetDeltaTime();
+	ApplyShipControls(MoveDeltaTime);
+	StepFixedSimulation(MoveDeltaTime);
+}
+
+void APlayerShip::ApplyShipControls(float DeltaTime)
+{
     // Apply rotation every frame (call even when input is nearly zero so physics can be cleared)
     RotateShip(RotationInput, DeltaTime);
 
@@ -47,8 +127,9 @@ void APlayerShip::Tick(float DeltaTime)
 		{
 			ApplyThrust(DeltaTime);
 			// Consume fuel
-			float FuelUsed = FuelConsumptionRate * DeltaTime;
-			CurrentFuel = FMath::Max(0.f, CurrentFuel - FuelUsed);
+			float FuelUsed = FMath::Min(FuelConsumptionRate * DeltaTime, CurrentFuel);
+			CurrentFuel -= FuelUsed;
+			FuelConsumed += FuelUsed;
 			// If fuel ran out this frame, stop thrusting next frame
 			if (CurrentFuel <= 0.f)
 			{
@@ -73,12 +154,113 @@ void APlayerShip::SetupPlayerInputComponent(UInputComponent* PlayerInputComponen
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
 
-	// Axis binding (keyboard, controller, or touch axis)
-	PlayerInputComponent->BindAxis("Rotate", this, &APlayerShip::RotateInput);
+	// Handlers only push a sample into InputBuffer; Tick applies them
+	UEnhancedInputComponent* EnhancedInput = Cast<UEnhancedInputComponent>(PlayerInputComponent);
+	if (EnhancedInput && RotateAction && ThrustAction)
+	{
+		EnhancedInput->BindAction(RotateAction, ETriggerEvent::Triggered, this, &APlayerShip::OnRotateAction);
+		EnhancedInput->BindAction(RotateAction, ETriggerEvent::Completed, this, &APlayerShip::OnRotateCompleted);
+		EnhancedInput->BindAction(ThrustAction, ETriggerEvent::Started, this, &APlayerShip::OnThrustStarted);
+		EnhancedInput->BindAction(ThrustAction, ETriggerEvent::Completed, this, &APlayerShip::OnThrustCompleted);
+		if (FireAction)
+		{
+			// Triggered repeats while held; TryFire's cooldown sets the rate
+			EnhancedInput->BindAction(FireAction, ETriggerEvent::Triggered, this, &APlayerShip::OnFireTriggered);
+		}
+		return;
+	}
+
+	// Legacy axis/action mappings (no Enhanced Input component or actions not set)
+	PlayerInputComponent->BindAxis("Rotate", this, &APlayerShip::OnRotateAxis);
+	PlayerInputComponent->BindAction("Thrust", IE_Pressed, this, &APlayerShip::OnThrustStarted);
+	PlayerInputComponent->BindAction("Thrust", IE_Released, this, &APlayerShip::OnThrustCompleted);
+	PlayerInputComponent->BindAction("Fire", IE_Pressed, this, &APlayerShip::OnFireTriggered);
+	PlayerInputComponent->BindAction("Fire", IE_Repeat, this, &APlayerShip::OnFireTriggered);
+}
+
+void APlayerShip::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	APlayerController* PC = Cast<APlayerController>(GetController());
+	ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+	UEnhancedInputLocalPlayerSubsystem* InputSubsystem = LocalPlayer ? LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() : nullptr;
+	if (InputSubsystem && DefaultMappingContext && !InputSubsystem->HasMappingContext(DefaultMappingContext))
+	{
+		InputSubsystem->AddMappingContext(DefaultMappingContext, MappingContextPriority);
+	}
+
+	// Nothing sampled for the previous controller should leak into this one
+	InputBuffer.Reset();
+}
+
+void APlayerShip::OnRotateAction(const FInputActionValue& Value)
+{
+	InputBuffer.Push(EShipInputEvent::Rotate, Value.Get<float>());
+}
+
+void APlayerShip::OnRotateCompleted()
+{
+	InputBuffer.Push(EShipInputEvent::Rotate, 0.f);
+}
+
+void APlayerShip::OnRotateAxis(float Value)
+{
+	// Axis bindings fire every frame; only changes need buffering
+	if (Value != LastBufferedRotation)
+	{
+		LastBufferedRotation = Value;
+		InputBuffer.Push(EShipInputEvent::Rotate, Value);
+	}
+}
+
+void APlayerShip::OnThrustStarted()
+{
+	InputBuffer.Push(EShipInputEvent::ThrustStart);
+}
+
+void APlayerShip::OnThrustCompleted()
+{
+	InputBuffer.Push(EShipInputEvent::ThrustStop);
+}
+
+void APlayerShip::OnFireTriggered()
+{
+	InputBuffer.Push(EShipInputEvent::Fire);
+}
+
+void APlayerShip::ConsumeBufferedInput(bool bStopAtThrustChange)
+{
+	bool bFire = false;
+	FShipInputSample Sample;
+	while (InputBuffer.Pop(Sample))
+	{
+		const bool bWasThrusting = bThrusting;
+		switch (Sample.Event)
+		{
+		case EShipInputEvent::Rotate:      RotateInput(Sample.Value); break;
+		case EShipInputEvent::ThrustStart: StartThrust(); break;
+		case EShipInputEvent::ThrustStop:  StopThrust(); break;
+		case EShipInputEvent::Fire:        bFire = true; break;
+		}
+		if (bStopAtThrustChange && bThrusting != bWasThrusting) break;
+	}
+
+	// At most one shot per drain, however many Triggered events arrived
+	if (bFire)
+	{
+		TryFire();
+	}
+}
+
+bool APlayerShip::TryFire()
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetTimeSeconds() < NextFireTime) return false;
 
-	// Thrust button
-	PlayerInputComponent->BindAction("Thrust", IE_Pressed, this, &APlayerShip::StartThrust);
-	PlayerInputComponent->BindAction("Thrust", IE_Released, this, &APlayerShip::StopThrust);
+	NextFireTime = World->GetTimeSeconds() + FireCooldown;
+	Fire();
+	return true;
 }
 
 /* ------------ INPUT HANDLERS ------------ */
@@ -106,5 +288,156 @@ void APlayerShip::RefillFuel(float Amount)
 {
     if (Amount <= 0.f) return;
     CurrentFuel = FMath::Clamp(CurrentFuel + Amount, 0.f, MaxFuel);
-    UE_LOG(LogTemp, Warning, TEXT("[PlayerShip] RefillFuel: NewFuel=%.2f"), CurrentFuel);
+    UE_LOG(LogJoyshipPickup, Verbose, TEXT("[PlayerShip] RefillFuel: NewFuel=%.2f"), CurrentFuel);
+}
+
+/* ------------ RECORD / REPLAY ------------ */
+
+FString APlayerShip::GetReplayPath(const FString& FileName)
+{
+    FString Path = FPaths::IsRelative(FileName) ? FPaths::ProjectSavedDir() / TEXT("Replays") / FileName : FileName;
+    if (FPaths::GetExtension(Path).IsEmpty())
+    {
+        Path += TEXT(".jsreplay");
+    }
+    return Path;
+}
+
+void APlayerShip::StartInputRecording(int32 Seed)
+{
+    StopInputReplay();
+
+    if (Seed == 0)
+    {
+        Seed = (int32)(FPlatformTime::Cycles() | 1);
+    }
+    FMath::RandInit(Seed);
+    FMath::SRandInit(Seed);
+
+    InputRecording.Reset();
+    InputRecording.RandomSeed = Seed;
+    InputRecording.MapName = GetWorld() ? UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName()) : FString();
+    InputRecording.StartLocation = GetActorLocation();
+    InputRecording.StartRotation = GetActorRotation();
+    InputRecording.StartVelocity = (Root && Root->IsSimulatingPhysics()) ? Root->GetPhysicsLinearVelocity() : Velocity;
+    InputRecording.StartFuel = CurrentFuel;
+    InputRecording.StartHealth = HealthComp ? HealthComp->CurrentHealth : CurrentHealth;
+
+    LastRecordedFireCount = GetFireCount();
+    bRecordingInput = true;
+
+    UE_LOG(LogJoyship, Log, TEXT("[Replay] Recording input (seed %d)"), Seed);
+}
+
+void APlayerShip::StopInputRecording(const FString& FileName)
+{
+    if (!bRecordingInput) return;
+    bRecordingInput = false;
+
+    const FString Path = GetReplayPath(FileName);
+    if (InputRecording.SaveToFile(Path))
+    {
+        UE_LOG(LogJoyship, Log, TEXT("[Replay] Wrote %d frames (%.1f s) to %s"), InputRecording.Frames.Num(), InputRecording.GetDuration(), *Path);
+    }
+    else
+    {
+        UE_LOG(LogJoyship, Warning, TEXT("[Replay] Could not write %s"), *Path);
+    }
+    InputRecording.Reset();
+}
+
+void APlayerShip::ReplayInput(const FString& FileName)
+{
+    FShipInputRecording Recording;
+    if (Recording.LoadFromFile(GetReplayPath(FileName)))
+    {
+        StartInputReplay(Recording);
+    }
+}
+
+bool APlayerShip::StartInputReplay(const FShipInputRecording& Recording)
+{
+    if (Recording.Frames.Num() == 0) return false;
+    if (!Recording.MatchesWorld(GetWorld()))
+    {
+        UE_LOG(LogJoyship, Warning, TEXT("[Replay] Recording was made in %s, not this map; not replaying"), *Recording.MapName);
+        return false;
+    }
+
+    bRecordingInput = false;
+    InputRecording = Recording;
+    ReplayFrame = 0;
+
+    FMath::RandInit(Recording.RandomSeed);
+    FMath::SRandInit(Recording.RandomSeed);
+
+    SetActorLocationAndRotation(Recording.StartLocation, Recording.StartRotation, false, nullptr, ETeleportType::TeleportPhysics);
+    Velocity = Recording.StartVelocity;
+    if (Root && Root->IsSimulatingPhysics())
+    {
+        Root->SetPhysicsLinearVelocity(Recording.StartVelocity);
+        Root->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
+    }
+    CurrentFuel = FMath::Clamp(Recording.StartFuel, 0.f, MaxFuel);
+    if (HealthComp)
+    {
+        HealthComp->CurrentHealth = Recording.StartHealth;
+    }
+    CurrentHealth = Recording.StartHealth;
+
+    // Live input must not mix with the recorded stream
+    if (APlayerController* PC = Cast<APlayerController>(GetController()))
+    {
+        DisableInput(PC);
+    }
+    InputBuffer.Reset();
+    RotationInput = 0.f;
+    bThrusting = false;
+
+    UE_LOG(LogJoyship, Log, TEXT("[Replay] Replaying %d frames (seed %d)"), Recording.Frames.Num(), Recording.RandomSeed);
+    return true;
+}
+
+void APlayerShip::StopInputReplay()
+{
+    if (!IsReplayingInput()) return;
+
+    ReplayFrame = INDEX_NONE;
+    InputRecording.Reset();
+    RotationInput = 0.f;
+    bThrusting = false;
+
+    if (APlayerController* PC = Cast<APlayerController>(GetController()))
+    {
+        EnableInput(PC);
+    }
+}
+
+void APlayerShip::ProcessRecordedInput(float DeltaTime)
+{
+    if (bRecordingInput)
+    {
+        FShipInputFrame& Frame = InputRecording.Frames.AddDefaulted_GetRef();
+        Frame.Set(DeltaTime, RotationInput, bThrusting, GetFireCount() - LastRecordedFireCount);
+        LastRecordedFireCount = GetFireCount();
+
+        // Fly on the quantized value so the live session matches its replay
+        RotationInput = Frame.GetRotation();
+        return;
+    }
+
+    if (!InputRecording.Frames.IsValidIndex(ReplayFrame))
+    {
+        UE_LOG(LogJoyship, Log, TEXT("[Replay] Finished"));
+        StopInputReplay();
+        return;
+    }
+
+    const FShipInputFrame& Frame = InputRecording.Frames[ReplayFrame++];
+    RotationInput = Frame.GetRotation();
+    bThrusting = Frame.IsThrusting();
+    for (int32 i = 0; i < Frame.GetFireCount(); ++i)
+    {
+        Fire();
+    }
 }
@@ -0,0 +1,89 @@
+#include "Replay/ShipInputRecording.h"
+#include "Joyship2.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+float FShipInputRecording::GetDuration() const
+{
+    float Duration = 0.f;
+    for (const FShipInputFrame& Frame : Frames)
+    {
+        Duration += Frame.DeltaTime;
+    }
+    return Duration;
+}
+
+bool FShipInputRecording::MatchesWorld(const UWorld* World) const
+{
+    return World && UWorld::RemovePIEPrefix(MapName) == UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+}
+
+bool FShipInputRecording::Serialize(FArchive& Ar)
+{
+    uint32 FileMagic = Magic;
+    uint32 Version = CurrentVersion;
+    Ar << FileMagic << Version;
+    if (FileMagic != Magic || Version > CurrentVersion)
+    {
+        UE_LOG(LogJoyship, Warning, TEXT("[Replay] Not an input recording (magic %08x, version %u)"), FileMagic, Version);
+        Ar.SetError();
+        return false;
+    }
+
+    Ar << RandomSeed << MapName;
+    Ar << StartLocation << StartRotation << StartVelocity << StartFuel << StartHealth;
+
+    // Frames are written field by field (not as a bulk array) so the layout does not depend on struct padding
+    int32 NumFrames = Frames.Num();
+    Ar << NumFrames;
+    if (Ar.IsLoading())
+    {
+        // A corrupt count must not drive a huge allocation: every frame needs SerializedSize bytes of what is left
+        const int64 MaxFrames = Ar.TotalSize() >= 0 ? (Ar.TotalSize() - Ar.Tell()) / FShipInputFrame::SerializedSize : MAX_int32;
+        if (NumFrames < 0 || NumFrames > MaxFrames)
+        {
+            UE_LOG(LogJoyship, Warning, TEXT("[Replay] Bad frame count %d (archive holds at most %lld)"), NumFrames, MaxFrames);
+            Ar.SetError();
+            return false;
+        }
+        Frames.SetNum(NumFrames);
+    }
+    for (FShipInputFrame& Frame : Frames)
+    {
+        Ar << Frame;
+    }
+
+    return !Ar.IsError();
+}
+
+bool FShipInputRecording::SaveToFile(const FString& Path) const
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    if (!const_cast<FShipInputRecording*>(this)->Serialize(Writer))
+    {
+        return false;
+    }
+    return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+bool FShipInputRecording::LoadFromFile(const FString& Path)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+    {
+        UE_LOG(LogJoyship, Warning, TEXT("[Replay] Could not read %s"), *Path);
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+    Reset();
+    if (!Serialize(Reader))
+    {
+        Reset();
+        return false;
+    }
+    return true;
+}
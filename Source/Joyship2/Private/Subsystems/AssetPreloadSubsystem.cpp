@@ -0,0 +1,97 @@
+#include "Subsystems/AssetPreloadSubsystem.h"
+#include "Joyship2.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+    // Enough to find the culprits without growing through a long hitchy session
+    constexpr int32 MaxReportedSyncLoads = 32;
+}
+
+bool UAssetPreloadSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UAssetPreloadSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Still part of the map load: finish what the level's actors queued before any of them begins play
+    const double Start = FPlatformTime::Seconds();
+    for (const TSharedPtr<FStreamableHandle>& Handle : Handles)
+    {
+        if (Handle.IsValid() && Handle->IsLoadingInProgress())
+        {
+            Handle->WaitUntilComplete();
+        }
+    }
+    MapLoadWaitSeconds = (float)(FPlatformTime::Seconds() - Start);
+    UE_LOG(LogJoyship, Log, TEXT("[Preload] %d assets preloaded, waited %.1f ms at BeginPlay"), Requested.Num(), MapLoadWaitSeconds * 1000.f);
+
+    SyncLoadHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddUObject(this, &UAssetPreloadSubsystem::HandleSyncLoad);
+}
+
+void UAssetPreloadSubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadHandle);
+    for (const TSharedPtr<FStreamableHandle>& Handle : Handles)
+    {
+        if (Handle.IsValid())
+        {
+            Handle->ReleaseHandle();
+        }
+    }
+    Handles.Empty();
+    Requested.Empty();
+    Super::Deinitialize();
+}
+
+void UAssetPreloadSubsystem::RequestPreload(TArray<FSoftObjectPath>&& Paths, FStreamableDelegate&& OnLoaded)
+{
+    // A caller waiting on the result needs its own handle even for paths another request is already loading
+    const bool bNeedsHandle = OnLoaded.IsBound();
+    Paths.RemoveAll([this, bNeedsHandle](const FSoftObjectPath& Path)
+    {
+        return Path.IsNull() || (!bNeedsHandle && Requested.Contains(Path)) || Path.ResolveObject() != nullptr;
+    });
+    if (Paths.Num() == 0)
+    {
+        OnLoaded.ExecuteIfBound();
+        return;
+    }
+
+    Requested.Append(Paths);
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths), MoveTemp(OnLoaded), FStreamableManager::AsyncLoadHighPriority);
+    if (Handle.IsValid())
+    {
+        Handles.Add(Handle);
+    }
+}
+
+void UAssetPreloadSubsystem::Preload(const UObject* Owner, TArray<FSoftObjectPath>&& Paths, FStreamableDelegate&& OnLoaded)
+{
+    UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+    if (UAssetPreloadSubsystem* Preloader = World ? World->GetSubsystem<UAssetPreloadSubsystem>() : nullptr)
+    {
+        Preloader->RequestPreload(MoveTemp(Paths), MoveTemp(OnLoaded));
+    }
+}
+
+void UAssetPreloadSubsystem::HandleSyncLoad(const FString& PackageName)
+{
+    // The delegate is process-wide: skip loads from other threads and from other worlds (editor, other PIE instances)
+    const UWorld* World = GetWorld();
+    if (!IsInGameThread() || !World || !World->bInTick) return;
+
+    ++NumSyncLoadsDuringPlay;
+    if (SyncLoadedPackages.Num() < MaxReportedSyncLoads)
+    {
+        SyncLoadedPackages.Add(PackageName);
+    }
+    JOYSHIP_LOG_THROTTLED(LogJoyship, Warning, 1.0, TEXT("[Preload] Synchronous load during play: %s (%d so far)"), *PackageName, NumSyncLoadsDuringPlay);
+}
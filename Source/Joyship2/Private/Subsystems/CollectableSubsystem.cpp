@@ -0,0 +1,336 @@
+#include "Subsystems/CollectableSubsystem.h"
+#include "Joyship2.h"
+#include "JoyshipProfiling.h"
+#include "Actors/Collectable.h"
+#include "Pawns/PlayerShip.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+void FCollectableMagnetTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->UpdateCollectables(DeltaTime);
+    }
+}
+
+FString FCollectableMagnetTickFunction::DiagnosticMessage()
+{
+    return TEXT("UCollectableSubsystem::UpdateCollectables");
+}
+
+bool UCollectableSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UCollectableSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    TickFunction.Target = this;
+    TickFunction.bCanEverTick = true;
+    TickFunction.bStartWithTickEnabled = true;
+    TickFunction.TickGroup = TG_PostPhysics;
+    TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UCollectableSubsystem::Deinitialize()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.UnRegisterTickFunction();
+    }
+    TickFunction.Target = nullptr;
+    Magnets.Empty();
+    PendingCollect.Empty();
+    PendingOverlap.Empty();
+    Respawns.Empty();
+    Pools.Empty();
+    Super::Deinitialize();
+}
+
+void UCollectableSubsystem::UpdateCollectables(float DeltaTime)
+{
+    UpdateRespawns(DeltaTime);
+    UpdateMagnets(DeltaTime);
+}
+
+void UCollectableSubsystem::AddMagnet(ACollectable* Collectable, APawn* Pawn)
+{
+    if (!Collectable || !Pawn) return;
+
+    FActiveMagnet* Magnet = Magnets.FindByPredicate([Collectable](const FActiveMagnet& M) { return M.Collectable == Collectable; });
+    if (!Magnet)
+    {
+        Magnet = &Magnets.AddDefaulted_GetRef();
+        Magnet->Collectable = Collectable;
+    }
+
+    Magnet->Pawn = Pawn;
+    Magnet->MagnetRadiusSq = FMath::Square(Collectable->MagnetRadius);
+    Magnet->AttractionSpeed = Collectable->AttractionSpeed;
+    // Without range collection the pickup parks at CollectDistance and waits for an overlap or the fail-safe
+    Magnet->StopDistance = Collectable->bAllowRangeCollect ? 0.f : Collectable->CollectDistance;
+    Magnet->CollectDistanceSq = FMath::Square(Collectable->CollectDistance);
+    Magnet->bRangeCollect = Collectable->bAllowRangeCollect;
+    Magnet->OverlapReachSq = FMath::Square(Collectable->GetSimpleCollisionRadius() + Pawn->GetSimpleCollisionRadius());
+    Magnet->bFailSafe = Collectable->MagnetFailSafeDelay > 0.f;
+    Magnet->FailSafeRemaining = Collectable->MagnetFailSafeDelay;
+    Magnet->bCanCollect = Collectable->HasAuthority();
+}
+
+void UCollectableSubsystem::RemoveMagnet(ACollectable* Collectable)
+{
+    const int32 Index = Magnets.IndexOfByPredicate([Collectable](const FActiveMagnet& M) { return M.Collectable == Collectable; });
+    if (Index != INDEX_NONE)
+    {
+        Magnets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    }
+}
+
+void UCollectableSubsystem::MoveCollectable(ACollectable* Collectable, const FVector& Location)
+{
+    USceneComponent* Root = Collectable->GetRootComponent();
+    if (!Root) return;
+
+    if (Root->GetAttachParent())
+    {
+        Root->SetWorldLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+        return;
+    }
+
+    // Unattached root: relative is world. Moves the bodies and render state, but sweeps and overlap updates are
+    // skipped; UpdateMagnets runs the overlap update for the pickups that have reached their pawn.
+    Root->SetRelativeLocation_Direct(Location);
+    Root->UpdateComponentToWorld(EUpdateTransformFlags::None, ETeleportType::TeleportPhysics);
+}
+
+void UCollectableSubsystem::UpdateMagnets(float DeltaTime)
+{
+    if (Magnets.Num() == 0)
+    {
+        TimeSinceUpdate = 0.f;
+        return;
+    }
+
+    TimeSinceUpdate += DeltaTime;
+    if (UpdateRate > 0.f && TimeSinceUpdate < 1.f / UpdateRate) return;
+
+    JOYSHIP_TIMING_SCOPE(CollectableTick);
+
+    const float StepTime = TimeSinceUpdate;
+    TimeSinceUpdate = 0.f;
+
+    PendingCollect.Reset();
+    for (int32 i = Magnets.Num() - 1; i >= 0; --i)
+    {
+        FActiveMagnet& Magnet = Magnets[i];
+        ACollectable* Collectable = Magnet.Collectable.Get();
+        const APawn* Pawn = Magnet.Pawn.Get();
+        if (!Collectable || !Pawn || Collectable->bCollected)
+        {
+            Magnets.RemoveAtSwap(i, 1, EAllowShrinking::No);
+            continue;
+        }
+
+        const FVector Location = Collectable->GetActorLocation();
+        const FVector PawnLocation = Pawn->GetActorLocation();
+        const FVector ToPawn = PawnLocation - Location;
+        const float DistSq = ToPawn.SizeSquared();
+
+        if (Magnet.bCanCollect)
+        {
+            Magnet.FailSafeRemaining -= StepTime;
+            if ((Magnet.bRangeCollect && DistSq <= Magnet.CollectDistanceSq) || (Magnet.bFailSafe && Magnet.FailSafeRemaining <= 0.f))
+            {
+                PendingCollect.Add(Magnet);
+                continue;
+            }
+        }
+
+        if (DistSq <= Magnet.MagnetRadiusSq && DistSq > KINDA_SMALL_NUMBER)
+        {
+            const FVector Dir = ToPawn / FMath::Sqrt(DistSq);
+            const FVector Desired = PawnLocation - Dir * Magnet.StopDistance;
+            const FVector NewLocation = FMath::VInterpTo(Location, Desired, StepTime, Magnet.AttractionSpeed);
+            MoveCollectable(Collectable, NewLocation);
+
+            // The direct move skipped the overlap update SetActorLocation used to make; run it once the shapes can touch
+            if (FVector::DistSquared(NewLocation, PawnLocation) <= Magnet.OverlapReachSq)
+            {
+                PendingOverlap.Add(Collectable);
+            }
+        }
+    }
+
+    for (const FActiveMagnet& Magnet : PendingCollect)
+    {
+        if (ACollectable* Collectable = Magnet.Collectable.Get())
+        {
+            UE_LOG(LogJoyshipPickup, Verbose, TEXT("[Collectables] Collecting %s for %s"), *Collectable->GetName(), *GetNameSafe(Magnet.Pawn.Get()));
+            Collectable->Collect(Cast<APlayerShip>(Magnet.Pawn.Get()));
+        }
+    }
+    PendingCollect.Reset();
+
+    // After the pass too: a Blueprint overlap pickup collects, which removes pairs
+    for (const TWeakObjectPtr<ACollectable>& Collectable : PendingOverlap)
+    {
+        if (Collectable.IsValid() && !Collectable->bCollected)
+        {
+            Collectable->UpdateOverlaps(true);
+        }
+    }
+    PendingOverlap.Reset();
+}
+
+/* ---------------- POOLING ---------------- */
+
+FCollectablePool& UCollectableSubsystem::GetPool(const ACollectable* Collectable)
+{
+    return Pools.FindOrAdd(Collectable->GetClass());
+}
+
+void UCollectableSubsystem::NotifyBeginPlay(ACollectable* Collectable)
+{
+    if (!Collectable) return;
+    GetPool(Collectable).Stats.Active++;
+}
+
+void UCollectableSubsystem::NotifyEndPlay(ACollectable* Collectable)
+{
+    if (!Collectable) return;
+
+    FCollectablePool& Pool = GetPool(Collectable);
+    switch (Collectable->PoolState)
+    {
+    case ECollectableState::Active:
+        Pool.Stats.Active--;
+        break;
+    case ECollectableState::Pooled:
+        Pool.FreeList.RemoveSingleSwap(Collectable, EAllowShrinking::No);
+        Pool.Stats.Pooled--;
+        break;
+    case ECollectableState::Respawning:
+        Respawns.RemoveAllSwap([Collectable](const FPendingRespawn& R) { return R.Collectable == Collectable; }, EAllowShrinking::No);
+        Pool.Stats.Respawning--;
+        break;
+    }
+    RemoveMagnet(Collectable);
+}
+
+void UCollectableSubsystem::Release(ACollectable* Collectable)
+{
+    if (!Collectable || Collectable->PoolState != ECollectableState::Active) return;
+
+    FCollectablePool& Pool = GetPool(Collectable);
+    Pool.Stats.Collected++;
+
+    // EndPlay takes it off the active count
+    if (!Collectable->bReturnToPoolOnCollect)
+    {
+        Collectable->ReleaseInstancedMesh();
+        Collectable->Destroy();
+        return;
+    }
+
+    Collectable->DeactivateCollectable();
+    Pool.Stats.Active--;
+    if (Collectable->RespawnDelay > 0.f)
+    {
+        Collectable->PoolState = ECollectableState::Respawning;
+        Respawns.Add({ Collectable, Collectable->RespawnDelay });
+        Pool.Stats.Respawning++;
+    }
+    else
+    {
+        Collectable->PoolState = ECollectableState::Pooled;
+        Pool.FreeList.Add(Collectable);
+        Pool.Stats.Pooled++;
+    }
+}
+
+ACollectable* UCollectableSubsystem::SpawnCollectable(TSubclassOf<ACollectable> CollectableClass, const FTransform& Transform)
+{
+    UWorld* World = GetWorld();
+    if (!CollectableClass || !World || World->GetNetMode() == NM_Client) return nullptr;
+
+    FCollectablePool& Pool = Pools.FindOrAdd(CollectableClass.Get());
+    while (Pool.FreeList.Num() > 0)
+    {
+        ACollectable* Collectable = Pool.FreeList.Pop(EAllowShrinking::No);
+        Pool.Stats.Pooled--;
+        if (!IsValid(Collectable)) continue;
+
+        Collectable->PoolState = ECollectableState::Active;
+        Collectable->HomeTransform = Transform;
+        Collectable->ActivateCollectable(Transform);
+        Pool.Stats.Active++;
+        Pool.Stats.Reused++;
+        return Collectable;
+    }
+
+    // BeginPlay counts it as active
+    ACollectable* Collectable = World->SpawnActor<ACollectable>(CollectableClass, Transform);
+    if (Collectable)
+    {
+        Pools.FindOrAdd(CollectableClass.Get()).Stats.Spawned++;
+    }
+    return Collectable;
+}
+
+void UCollectableSubsystem::UpdateRespawns(float DeltaTime)
+{
+    for (int32 i = Respawns.Num() - 1; i >= 0; --i)
+    {
+        FPendingRespawn& Respawn = Respawns[i];
+        Respawn.Remaining -= DeltaTime;
+        if (Respawn.Remaining > 0.f) continue;
+
+        ACollectable* Collectable = Respawn.Collectable.Get();
+        Respawns.RemoveAtSwap(i, 1, EAllowShrinking::No);
+        if (!Collectable) continue;
+
+        FCollectablePool& Pool = GetPool(Collectable);
+        Pool.Stats.Respawning--;
+        Pool.Stats.Active++;
+        Collectable->PoolState = ECollectableState::Active;
+        Collectable->ActivateCollectable(Collectable->HomeTransform);
+
+        UE_LOG(LogJoyshipPickup, Verbose, TEXT("[Collectables] Respawned %s"), *Collectable->GetName());
+    }
+}
+
+FCollectablePoolStats UCollectableSubsystem::GetStatsForClass(TSubclassOf<ACollectable> CollectableClass) const
+{
+    const FCollectablePool* Pool = Pools.Find(CollectableClass.Get());
+    return Pool ? Pool->Stats : FCollectablePoolStats();
+}
+
+FCollectablePoolStats UCollectableSubsystem::GetTotalStats() const
+{
+    FCollectablePoolStats Total;
+    for (const TPair<UClass*, FCollectablePool>& Pair : Pools)
+    {
+        const FCollectablePoolStats& Stats = Pair.Value.Stats;
+        Total.Active += Stats.Active;
+        Total.Pooled += Stats.Pooled;
+        Total.Respawning += Stats.Respawning;
+        Total.Collected += Stats.Collected;
+        Total.Reused += Stats.Reused;
+        Total.Spawned += Stats.Spawned;
+    }
+    return Total;
+}
+
+void UCollectableSubsystem::ResetStats()
+{
+    for (TPair<UClass*, FCollectablePool>& Pair : Pools)
+    {
+        Pair.Value.Stats.Collected = 0;
+        Pair.Value.Stats.Reused = 0;
+        Pair.Value.Stats.Spawned = 0;
+    }
+}
@@ -0,0 +1,108 @@
+#include "Subsystems/DamageSubsystem.h"
+#include "Joyship2.h"
+#include "JoyshipProfiling.h"
+#include "Components/HealthComponent.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+void FDamageResolveTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->ResolveDamage();
+    }
+}
+
+FString FDamageResolveTickFunction::DiagnosticMessage()
+{
+    return TEXT("UDamageSubsystem::ResolveDamage");
+}
+
+bool UDamageSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UDamageSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    TickFunction.Target = this;
+    TickFunction.bCanEverTick = true;
+    TickFunction.bStartWithTickEnabled = true;
+    TickFunction.TickGroup = TG_PostUpdateWork;
+    TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UDamageSubsystem::Deinitialize()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.UnRegisterTickFunction();
+    }
+    TickFunction.Target = nullptr;
+    Pending.Empty();
+    PendingKeys.Empty();
+    Totals.Empty();
+    Super::Deinitialize();
+}
+
+bool UDamageSubsystem::QueueDamage(AActor* Victim, float Amount, const UObject* Causer, uint32 ShotId, AController* Instigator)
+{
+    if (!Victim || Amount == 0.f) return false;
+
+    // Health is server-authoritative; a client's copy of a replicated actor only hears about changes
+    if (!Victim->HasAuthority()) return false;
+
+    UHealthComponent* Health = Victim->FindComponentByClass<UHealthComponent>();
+    if (!Health || Health->IsDead()) return false;
+
+    // Only a real shot can arrive twice (hit plus overlap); generic damage has no identity to compare
+    bool bDuplicate = false;
+    if (ShotId != 0)
+    {
+        PendingKeys.Add(FDamageKey{ Victim, Causer, ShotId }, &bDuplicate);
+    }
+    if (bDuplicate)
+    {
+        UE_LOG(LogJoyshipCombat, VeryVerbose, TEXT("[Damage] Dropped duplicate event %s -> %s"), Causer ? *Causer->GetName() : TEXT("None"), *Victim->GetName());
+        return false;
+    }
+
+    Pending.Add(FPendingDamage{ Health, Amount });
+    if (Instigator)
+    {
+        Health->LastInstigator = Instigator;
+    }
+    return true;
+}
+
+void UDamageSubsystem::ResolveDamage()
+{
+    if (Pending.Num() == 0) return;
+
+    JOYSHIP_TIMING_SCOPE(DamageResolve);
+
+    // Sum per victim so each health component sees one change (and at most one death) per frame
+    Totals.Reset();
+    for (const FPendingDamage& Event : Pending)
+    {
+        if (UHealthComponent* Health = Event.Health.Get())
+        {
+            Totals.FindOrAdd(Health) += Event.Amount;
+        }
+    }
+    Pending.Reset();
+    PendingKeys.Reset();
+
+    // Deaths raised here may destroy actors and queue more damage; that lands in the next frame's batch
+    for (const TPair<UHealthComponent*, float>& Total : Totals)
+    {
+        if (IsValid(Total.Key))
+        {
+            Total.Key->ApplyDamage(Total.Value);
+        }
+    }
+    Totals.Reset();
+}
@@ -0,0 +1,209 @@
+#include "Subsystems/EffectsSubsystem.h"
+#include "Joyship2.h"
+#include "Pawns/PlayerShip.h"
+#include "Camera/CameraComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/AudioComponent.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Sound/SoundBase.h"
+#include "Engine/World.h"
+
+bool UEffectsSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UEffectsSubsystem::Deinitialize()
+{
+    Emitters.Empty();
+    AudioComponents.Empty();
+    Recent.Empty();
+    HostActor = nullptr;
+    Super::Deinitialize();
+}
+
+bool UEffectsSubsystem::IsNearAnyCamera(const FVector& Location) const
+{
+    const UWorld* World = GetWorld();
+
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PC = It->Get();
+        if (!PC || !PC->IsLocalController()) continue;
+
+        FVector ViewLocation;
+        if (const APlayerShip* Ship = Cast<APlayerShip>(PC->GetPawn()); Ship && Ship->Camera)
+        {
+            ViewLocation = Ship->Camera->GetComponentLocation();
+        }
+        else if (PC->PlayerCameraManager)
+        {
+            ViewLocation = PC->PlayerCameraManager->GetCameraLocation();
+        }
+        else
+        {
+            continue;
+        }
+
+        if (FVector::DistSquared(ViewLocation, Location) <= CullRadius * CullRadius)
+        {
+            return true;
+        }
+    }
+
+    // No local view in range (or none at all: dedicated server, headless benchmark)
+    return false;
+}
+
+bool UEffectsSubsystem::EnsureHost()
+{
+    if (HostActor) return true;
+
+    UWorld* World = GetWorld();
+    if (!World) return false;
+
+    FActorSpawnParameters Params;
+    Params.Name = TEXT("EffectsHost");
+    Params.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+    HostActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+    if (!HostActor) return false;
+
+    USceneComponent* HostRoot = NewObject<USceneComponent>(HostActor, TEXT("Root"));
+    HostActor->SetRootComponent(HostRoot);
+    HostRoot->RegisterComponent();
+    return true;
+}
+
+UParticleSystemComponent* UEffectsSubsystem::AcquireEmitter()
+{
+    for (UParticleSystemComponent* PSC : Emitters)
+    {
+        if (PSC && !PSC->IsActive())
+        {
+            return PSC;
+        }
+    }
+
+    if (Emitters.Num() >= MaxEmitters || !EnsureHost()) return nullptr;
+
+    UParticleSystemComponent* PSC = NewObject<UParticleSystemComponent>(HostActor);
+    PSC->bAutoActivate = false;
+    PSC->bAutoDestroy = false;
+    PSC->SetUsingAbsoluteLocation(true);
+    PSC->SetUsingAbsoluteRotation(true);
+    PSC->SetupAttachment(HostActor->GetRootComponent());
+    PSC->RegisterComponent();
+    Emitters.Add(PSC);
+    return PSC;
+}
+
+UAudioComponent* UEffectsSubsystem::AcquireAudio()
+{
+    for (UAudioComponent* AC : AudioComponents)
+    {
+        if (AC && !AC->IsPlaying())
+        {
+            return AC;
+        }
+    }
+
+    if (AudioComponents.Num() >= MaxAudioComponents || !EnsureHost()) return nullptr;
+
+    UAudioComponent* AC = NewObject<UAudioComponent>(HostActor);
+    AC->bAutoActivate = false;
+    AC->bAutoDestroy = false;
+    AC->SetUsingAbsoluteLocation(true);
+    AC->SetupAttachment(HostActor->GetRootComponent());
+    AC->RegisterComponent();
+    AudioComponents.Add(AC);
+    return AC;
+}
+
+bool UEffectsSubsystem::PlayExplosion(UParticleSystem* Effect, USoundBase* Sound, const FVector& Location, const FRotator& Rotation)
+{
+    if (!Effect && !Sound) return false;
+
+    UWorld* World = GetWorld();
+    if (!World) return false;
+
+    if (!IsNearAnyCamera(Location))
+    {
+        ++NumCulled;
+        return false;
+    }
+
+    // Per-frame budget
+    if (BudgetFrame != GFrameCounter)
+    {
+        BudgetFrame = GFrameCounter;
+        PlayedThisFrame = 0;
+    }
+    if (PlayedThisFrame >= MaxExplosionsPerFrame)
+    {
+        ++NumOverBudget;
+        return false;
+    }
+
+    const float Now = World->GetTimeSeconds();
+    const float Horizon = FMath::Max(AreaWindow, MergeWindow);
+    Recent.RemoveAllSwap([Now, Horizon](const FRecentExplosion& R) { return Now - R.Time > Horizon; }, EAllowShrinking::No);
+
+    // Merge into an identical explosion that just played here, and count the area budget
+    int32 InArea = 0;
+    for (const FRecentExplosion& R : Recent)
+    {
+        const float DistSq = FVector::DistSquared(R.Location, Location);
+        if (R.Effect == Effect && R.Sound == Sound && Now - R.Time <= MergeWindow && DistSq <= MergeRadius * MergeRadius)
+        {
+            ++NumMerged;
+            return false;
+        }
+        if (Now - R.Time <= AreaWindow && DistSq <= AreaRadius * AreaRadius)
+        {
+            ++InArea;
+        }
+    }
+    if (InArea >= MaxExplosionsPerArea)
+    {
+        ++NumOverBudget;
+        return false;
+    }
+
+    bool bPlayed = false;
+
+    if (Effect)
+    {
+        if (UParticleSystemComponent* PSC = AcquireEmitter())
+        {
+            PSC->SetTemplate(Effect);
+            PSC->SetWorldLocationAndRotation(Location, Rotation);
+            PSC->ActivateSystem(true);
+            bPlayed = true;
+        }
+    }
+
+    if (Sound)
+    {
+        if (UAudioComponent* AC = AcquireAudio())
+        {
+            AC->SetSound(Sound);
+            AC->SetWorldLocation(Location);
+            AC->Play();
+            bPlayed = true;
+        }
+    }
+
+    if (!bPlayed)
+    {
+        ++NumOverBudget;
+        return false;
+    }
+
+    ++PlayedThisFrame;
+    Recent.Add(FRecentExplosion{ Location, Now, Effect, Sound });
+    return true;
+}
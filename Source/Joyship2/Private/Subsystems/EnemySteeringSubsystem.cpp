@@ -0,0 +1,204 @@
+#include "Subsystems/EnemySteeringSubsystem.h"
+#include "JoyshipProfiling.h"
+#include "Pawns/EnemyShip.h"
+#include "Pawns/PlayerShip.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Async/ParallelFor.h"
+
+void FEnemySteeringTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->UpdateSteering(DeltaTime);
+    }
+}
+
+FString FEnemySteeringTickFunction::DiagnosticMessage()
+{
+    return TEXT("UEnemySteeringSubsystem::UpdateSteering");
+}
+
+bool UEnemySteeringSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UEnemySteeringSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Same tick group the per-enemy Tick used, so steering lands before physics
+    TickFunction.Target = this;
+    TickFunction.bCanEverTick = true;
+    TickFunction.bStartWithTickEnabled = true;
+    TickFunction.TickGroup = TG_PrePhysics;
+    TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UEnemySteeringSubsystem::Deinitialize()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.UnRegisterTickFunction();
+    }
+    TickFunction.Target = nullptr;
+    Enemies.Empty();
+    Super::Deinitialize();
+}
+
+void UEnemySteeringSubsystem::RegisterEnemy(AEnemyShip* Enemy)
+{
+    if (!Enemy) return;
+    Enemies.AddUnique(Enemy);
+    MaxAggroRadius = FMath::Max(MaxAggroRadius, Enemy->GetAggroRadius());
+}
+
+void UEnemySteeringSubsystem::UnregisterEnemy(AEnemyShip* Enemy)
+{
+    Enemies.RemoveSwap(Enemy);
+}
+
+void UEnemySteeringSubsystem::ComputeSteering(const FVector& Location, const FQuat& Rotation, const FVector& TargetLocation, float RotationSpeed, float ThrustForce, float DeltaTime, FQuat& OutRotation, FVector& OutVelocity)
+{
+    OutRotation = Rotation;
+    OutVelocity = FVector::ZeroVector;
+
+    FVector ToTarget = TargetLocation - Location;
+    ToTarget.X = 0.f; // keep movement in ZY plane
+    const float DistSq = ToTarget.SizeSquared();
+    if (DistSq <= KINDA_SMALL_NUMBER * KINDA_SMALL_NUMBER) return;
+
+    const FVector DesiredUp = ToTarget * FMath::InvSqrt(DistSq);
+
+    // Rotate so that the Up vector turns toward the target, slerping for smooth turning
+    const FQuat FromTo = FQuat::FindBetweenNormals(Rotation.GetUpVector(), DesiredUp);
+    const FQuat TargetQuat = FromTo * Rotation;
+    OutRotation = FQuat::Slerp(Rotation, TargetQuat, FMath::Clamp(RotationSpeed * DeltaTime, 0.f, 1.f));
+
+    // Move along the new Up vector (ABaseShip thrust axis), projected onto the ZY plane
+    FVector MoveDir = OutRotation.GetUpVector();
+    MoveDir.X = 0.f;
+    const float MoveSq = MoveDir.SizeSquared();
+    if (MoveSq > KINDA_SMALL_NUMBER)
+    {
+        OutVelocity = MoveDir * (FMath::InvSqrt(MoveSq) * ThrustForce);
+    }
+}
+
+void UEnemySteeringSubsystem::UpdateAggro()
+{
+    UWorld* World = GetWorld();
+    USpatialGridSubsystem* Grid = World ? World->GetSubsystem<USpatialGridSubsystem>() : nullptr;
+    if (!Grid) return;
+
+    // Exits: enemies whose player has left their radius
+    for (AEnemyShip* Enemy : Enemies)
+    {
+        if (!IsValid(Enemy) || !Enemy->bUseSpatialAggro) continue;
+
+        APlayerShip* Player = Enemy->GetAggroPlayer();
+        if (!Player) continue;
+
+        const float Reach = Enemy->GetAggroRadius() + Player->GetSimpleCollisionRadius();
+        FVector Delta = Player->GetActorLocation() - Enemy->GetActorLocation();
+        Delta.X = 0.f;
+        if (Delta.SizeSquared() > Reach * Reach)
+        {
+            Enemy->NotifyAggroExit(Player);
+        }
+    }
+
+    // Enters: one grid query per player rather than one overlap test per enemy
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController* PC = It->Get();
+        APlayerShip* Player = PC ? Cast<APlayerShip>(PC->GetPawn()) : nullptr;
+        if (!Player) continue;
+
+        const FVector PlayerLoc = Player->GetActorLocation();
+        const float PlayerRadius = Player->GetSimpleCollisionRadius();
+
+        AggroCandidates.Reset();
+        Grid->QueryRadius(PlayerLoc, MaxAggroRadius + PlayerRadius, ESpatialGridFlags::Ship, AggroCandidates, Player);
+
+        for (AActor* Candidate : AggroCandidates)
+        {
+            AEnemyShip* Enemy = Cast<AEnemyShip>(Candidate);
+            if (!Enemy || !Enemy->bUseSpatialAggro || Enemy->GetAggroPlayer() == Player) continue;
+
+            const float Reach = Enemy->GetAggroRadius() + PlayerRadius;
+            FVector Delta = PlayerLoc - Enemy->GetActorLocation();
+            Delta.X = 0.f;
+            if (Delta.SizeSquared() <= Reach * Reach)
+            {
+                Enemy->NotifyAggroEnter(Player);
+            }
+        }
+    }
+}
+
+void UEnemySteeringSubsystem::UpdateSteering(float DeltaTime)
+{
+    JOYSHIP_TIMING_SCOPE(EnemySteering);
+
+    AggroAccum += DeltaTime;
+    if (AggroAccum >= AggroUpdateInterval)
+    {
+        AggroAccum = 0.f;
+        UpdateAggro();
+    }
+
+    // Gather: only enemies that are actively following a valid target
+    Followers.Reset();
+    Locations.Reset();
+    Rotations.Reset();
+    TargetLocations.Reset();
+    RotationSpeeds.Reset();
+    ThrustForces.Reset();
+
+    for (int32 i = Enemies.Num() - 1; i >= 0; --i)
+    {
+        AEnemyShip* Enemy = Enemies[i];
+        if (!IsValid(Enemy))
+        {
+            Enemies.RemoveAtSwap(i, 1, EAllowShrinking::No);
+            continue;
+        }
+
+        AActor* Target = Enemy->GetFollowTarget();
+        if (!Enemy->IsFollowing() || !IsValid(Target)) continue;
+
+        Followers.Add(Enemy);
+        Locations.Add(Enemy->GetActorLocation());
+        Rotations.Add(Enemy->GetActorQuat());
+        TargetLocations.Add(Target->GetActorLocation());
+        RotationSpeeds.Add(Enemy->GetRotationSpeed());
+        ThrustForces.Add(Enemy->ThrustForce);
+    }
+
+    const int32 Num = Followers.Num();
+    if (Num == 0) return;
+
+    OutRotations.SetNumUninitialized(Num, EAllowShrinking::No);
+    OutVelocities.SetNumUninitialized(Num, EAllowShrinking::No);
+
+    SET_MEMORY_STAT(STAT_JoyshipSteeringMemory, Followers.GetAllocatedSize() + Locations.GetAllocatedSize() + Rotations.GetAllocatedSize()
+        + TargetLocations.GetAllocatedSize() + RotationSpeeds.GetAllocatedSize() + ThrustForces.GetAllocatedSize()
+        + OutRotations.GetAllocatedSize() + OutVelocities.GetAllocatedSize());
+
+    // Solve: pure math on the flat arrays, safe to run off the game thread
+    ParallelFor(Num, [this, DeltaTime](int32 Index)
+    {
+        ComputeSteering(Locations[Index], Rotations[Index], TargetLocations[Index], RotationSpeeds[Index], ThrustForces[Index], DeltaTime, OutRotations[Index], OutVelocities[Index]);
+    }, Num < MinFollowersForParallel);
+
+    // Write back on the game thread
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Followers[i]->ApplySteering(OutRotations[i], OutVelocities[i]);
+    }
+}
@@ -0,0 +1,221 @@
+#include "Subsystems/InstancedMeshSubsystem.h"
+#include "Algo/StableSort.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+bool UInstancedMeshSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UInstancedMeshSubsystem::Deinitialize()
+{
+    Tracked.Empty();
+    TrackedIndex.Empty();
+    Meshes.Empty();
+    MeshIndexMap.Empty();
+    Components.Empty();
+    HostActor = nullptr;
+    Super::Deinitialize();
+}
+
+TStatId UInstancedMeshSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UInstancedMeshSubsystem, STATGROUP_Tickables);
+}
+
+void UInstancedMeshSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Copy tracked actor transforms, dropping actors that went away without untracking
+    for (int32 i = Tracked.Num() - 1; i >= 0; --i)
+    {
+        AActor* Actor = Tracked[i].Actor.Get();
+        if (!Actor)
+        {
+            FInstancedMeshHandle Handle = Tracked[i].Handle;
+            TrackedIndex.Remove(Tracked[i].Key);
+            Tracked.RemoveAtSwap(i, 1, EAllowShrinking::No);
+            if (i < Tracked.Num())
+            {
+                TrackedIndex.Add(Tracked[i].Key, i);
+            }
+            RemoveInstance(Handle);
+            continue;
+        }
+        SetInstanceTransform(Tracked[i].Handle, Tracked[i].RelativeTransform * Actor->GetActorTransform());
+    }
+
+    FlushPending();
+}
+
+int32 UInstancedMeshSubsystem::FindOrAddMesh(UStaticMesh* Mesh)
+{
+    if (const int32* Existing = MeshIndexMap.Find(Mesh))
+    {
+        return *Existing;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World) return INDEX_NONE;
+
+    if (!HostActor)
+    {
+        FActorSpawnParameters Params;
+        Params.Name = TEXT("InstancedMeshHost");
+        Params.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+        HostActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+        if (!HostActor) return INDEX_NONE;
+
+        USceneComponent* HostRoot = NewObject<USceneComponent>(HostActor, TEXT("Root"));
+        HostActor->SetRootComponent(HostRoot);
+        HostRoot->RegisterComponent();
+    }
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(HostActor);
+    ISM->SetStaticMesh(Mesh);
+    ISM->SetMobility(EComponentMobility::Movable);
+    // Gameplay collision stays on the actors (or their simulation); the instances are visual only
+    ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ISM->SetGenerateOverlapEvents(false);
+    ISM->SetupAttachment(HostActor->GetRootComponent());
+    ISM->RegisterComponent();
+
+    FMeshBatch& Batch = Meshes.AddDefaulted_GetRef();
+    Batch.Component = ISM;
+    Components.Add(ISM);
+
+    const int32 Index = Meshes.Num() - 1;
+    MeshIndexMap.Add(Mesh, Index);
+    return Index;
+}
+
+FInstancedMeshHandle UInstancedMeshSubsystem::AddInstance(UStaticMesh* Mesh, const FTransform& WorldTransform)
+{
+    FInstancedMeshHandle Handle;
+    if (!Mesh) return Handle;
+
+    Handle.MeshIndex = FindOrAddMesh(Mesh);
+    if (Handle.MeshIndex == INDEX_NONE) return Handle;
+
+    FMeshBatch& Batch = Meshes[Handle.MeshIndex];
+    if (Batch.FreeInstances.Num() > 0)
+    {
+        Handle.InstanceIndex = Batch.FreeInstances.Pop(EAllowShrinking::No);
+        SetInstanceTransform(Handle, WorldTransform);
+    }
+    else
+    {
+        Handle.InstanceIndex = Batch.Component->AddInstance(WorldTransform, true);
+    }
+    return Handle;
+}
+
+void UInstancedMeshSubsystem::RemoveInstance(FInstancedMeshHandle& Handle)
+{
+    if (!Handle.IsValid() || !Meshes.IsValidIndex(Handle.MeshIndex))
+    {
+        Handle.Reset();
+        return;
+    }
+
+    // Zero scale hides the instance without shifting the indices other handles refer to
+    FTransform Hidden = FTransform::Identity;
+    Hidden.SetScale3D(FVector::ZeroVector);
+    SetInstanceTransform(Handle, Hidden);
+
+    Meshes[Handle.MeshIndex].FreeInstances.Add(Handle.InstanceIndex);
+    Handle.Reset();
+}
+
+void UInstancedMeshSubsystem::SetInstanceTransform(const FInstancedMeshHandle& Handle, const FTransform& WorldTransform)
+{
+    if (!Handle.IsValid() || !Meshes.IsValidIndex(Handle.MeshIndex)) return;
+
+    FMeshBatch& Batch = Meshes[Handle.MeshIndex];
+    Batch.PendingIndices.Add(Handle.InstanceIndex);
+    Batch.PendingTransforms.Add(WorldTransform);
+}
+
+void UInstancedMeshSubsystem::TrackActor(AActor* Actor, const FInstancedMeshHandle& Handle, const FTransform& RelativeTransform)
+{
+    if (!Actor || !Handle.IsValid()) return;
+
+    if (const int32* Existing = TrackedIndex.Find(Actor))
+    {
+        Tracked[*Existing].Handle = Handle;
+        Tracked[*Existing].RelativeTransform = RelativeTransform;
+        return;
+    }
+
+    FTrackedActor& Entry = Tracked.AddDefaulted_GetRef();
+    Entry.Actor = Actor;
+    Entry.Key = Actor;
+    Entry.Handle = Handle;
+    Entry.RelativeTransform = RelativeTransform;
+    TrackedIndex.Add(Actor, Tracked.Num() - 1);
+}
+
+void UInstancedMeshSubsystem::UntrackActor(AActor* Actor)
+{
+    int32 Index = INDEX_NONE;
+    if (!TrackedIndex.RemoveAndCopyValue(Actor, Index)) return;
+
+    // Final transform so the instance is left where the actor stopped
+    const FTrackedActor& Entry = Tracked[Index];
+    SetInstanceTransform(Entry.Handle, Entry.RelativeTransform * Actor->GetActorTransform());
+
+    Tracked.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    if (Index < Tracked.Num())
+    {
+        TrackedIndex.Add(Tracked[Index].Key, Index);
+    }
+}
+
+void UInstancedMeshSubsystem::FlushPending()
+{
+    for (FMeshBatch& Batch : Meshes)
+    {
+        if (Batch.PendingIndices.Num() == 0 || !Batch.Component) continue;
+
+        // Order by instance (stable, so the last transform queued for an instance wins)
+        FlushOrder.Reset();
+        for (int32 i = 0; i < Batch.PendingIndices.Num(); ++i)
+        {
+            FlushOrder.Add(i);
+        }
+        Algo::StableSort(FlushOrder, [&Batch](int32 A, int32 B) { return Batch.PendingIndices[A] < Batch.PendingIndices[B]; });
+
+        // One batch update per run of consecutive instances; only the last one dirties the render state
+        int32 RunStart = INDEX_NONE;
+        FlushRun.Reset();
+        for (const int32 Pending : FlushOrder)
+        {
+            const int32 Index = Batch.PendingIndices[Pending];
+            if (RunStart != INDEX_NONE && Index == RunStart + FlushRun.Num() - 1)
+            {
+                FlushRun.Last() = Batch.PendingTransforms[Pending];
+                continue;
+            }
+            if (RunStart != INDEX_NONE && Index != RunStart + FlushRun.Num())
+            {
+                Batch.Component->BatchUpdateInstancesTransforms(RunStart, FlushRun, true, false, true);
+                FlushRun.Reset();
+                RunStart = INDEX_NONE;
+            }
+            if (RunStart == INDEX_NONE)
+            {
+                RunStart = Index;
+            }
+            FlushRun.Add(Batch.PendingTransforms[Pending]);
+        }
+        Batch.Component->BatchUpdateInstancesTransforms(RunStart, FlushRun, true, true, true);
+
+        Batch.PendingIndices.Reset();
+        Batch.PendingTransforms.Reset();
+    }
+}
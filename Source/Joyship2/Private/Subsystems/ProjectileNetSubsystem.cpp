@@ -0,0 +1,387 @@
+#include "Subsystems/ProjectileNetSubsystem.h"
+#include "Joyship2.h"
+#include "JoyshipProfiling.h"
+#include "Net/ProjectileEventRelay.h"
+#include "Pawns/BaseShip.h"
+#include "Components/HealthComponent.h"
+#include "Subsystems/DamageSubsystem.h"
+#include "Subsystems/SimulatedProjectileSubsystem.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+void FProjectileNetTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->TickNetwork(DeltaTime);
+    }
+}
+
+FString FProjectileNetTickFunction::DiagnosticMessage()
+{
+    return TEXT("UProjectileNetSubsystem::TickNetwork");
+}
+
+bool UProjectileNetSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UProjectileNetSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (!IsNetworked()) return;
+
+    // Only the server has history to record and events to send
+    if (InWorld.GetNetMode() == NM_Client) return;
+
+    TickFunction.Target = this;
+    TickFunction.bCanEverTick = true;
+    TickFunction.bStartWithTickEnabled = true;
+    TickFunction.TickGroup = TG_PostUpdateWork;
+    TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+
+    FActorSpawnParameters Params;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    Params.ObjectFlags |= RF_Transient;
+    RegisterRelay(InWorld.SpawnActor<AProjectileEventRelay>(Params));
+}
+
+void UProjectileNetSubsystem::Deinitialize()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.UnRegisterTickFunction();
+    }
+    TickFunction.Target = nullptr;
+
+    Tracks.Empty();
+    QueuedEvents.Empty();
+    LastClientShotTime.Empty();
+    Relay = nullptr;
+    Super::Deinitialize();
+}
+
+bool UProjectileNetSubsystem::IsNetworked() const
+{
+    const UWorld* World = GetWorld();
+    return World && World->GetNetMode() != NM_Standalone;
+}
+
+double UProjectileNetSubsystem::GetServerTime() const
+{
+    const UWorld* World = GetWorld();
+    if (!World) return 0.0;
+
+    const AGameStateBase* GameState = World->GetGameState();
+    return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+}
+
+double UProjectileNetSubsystem::GetViewTime() const
+{
+    // Other ships are drawn from state that left the server about half a round trip ago
+    const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+    const APlayerState* PlayerState = PC ? PC->PlayerState : nullptr;
+    const double OneWay = PlayerState ? PlayerState->GetPingInMilliseconds() * 0.0005 : 0.0;
+    return GetServerTime() - OneWay;
+}
+
+void UProjectileNetSubsystem::RegisterRelay(AProjectileEventRelay* InRelay)
+{
+    Relay = InRelay;
+}
+
+void UProjectileNetSubsystem::UnregisterRelay(AProjectileEventRelay* InRelay)
+{
+    if (Relay == InRelay)
+    {
+        Relay = nullptr;
+    }
+}
+
+/* ---------------- EVENTS ---------------- */
+
+void UProjectileNetSubsystem::QueueFireEvent(const FProjectileFireEvent& Event)
+{
+    if (Relay)
+    {
+        QueuedEvents.Add(Event);
+    }
+}
+
+void UProjectileNetSubsystem::FlushEvents()
+{
+    if (QueuedEvents.Num() == 0) return;
+
+    if (Relay)
+    {
+        const int32 BatchSize = FMath::Max(MaxEventsPerBatch, 1);
+        if (QueuedEvents.Num() <= BatchSize)
+        {
+            Relay->MulticastFireEvents(QueuedEvents);
+        }
+        else
+        {
+            TArray<FProjectileFireEvent> Batch;
+            for (int32 First = 0; First < QueuedEvents.Num(); First += BatchSize)
+            {
+                Batch.Reset();
+                Batch.Append(QueuedEvents.GetData() + First, FMath::Min(BatchSize, QueuedEvents.Num() - First));
+                Relay->MulticastFireEvents(Batch);
+            }
+        }
+    }
+    QueuedEvents.Reset();
+}
+
+void UProjectileNetSubsystem::SimulateFireEvents(const TArray<FProjectileFireEvent>& Events)
+{
+    USimulatedProjectileSubsystem* Sim = GetWorld() ? GetWorld()->GetSubsystem<USimulatedProjectileSubsystem>() : nullptr;
+    if (!Sim) return;
+
+    const double Now = GetServerTime();
+    for (const FProjectileFireEvent& Event : Events)
+    {
+        // The owning client drew its own shot when it fired
+        const APawn* ShooterPawn = Cast<APawn>(Event.Shooter);
+        if (!Event.ProjectileClass || (ShooterPawn && ShooterPawn->IsLocallyControlled())) continue;
+
+        // Catch up with where the server's projectile is by now
+        const float Age = (float)FMath::Clamp(Now - Event.Time, 0.0, 2.0 * MaxRewindTime);
+        Sim->Fire(Event.ProjectileClass, Event.Origin, Event.Direction, Event.Shooter, nullptr, Age);
+    }
+}
+
+/* ---------------- LAG COMPENSATION ---------------- */
+
+void UProjectileNetSubsystem::ResolveClientShot(ABaseShip* Shooter, FProjectileFireEvent Event)
+{
+    UWorld* World = GetWorld();
+    if (!World || !IsValid(Shooter) || !Shooter->GetProjectileClass()) return;
+    if (Shooter->HealthComp && Shooter->HealthComp->IsDead()) return;
+
+    const double Now = GetServerTime();
+
+    // The weapon's own cooldown, less what jitter can take off the gap between two arrivals
+    const float MinInterval = FMath::Max(Shooter->GetFireCooldown() - ClientFireJitter, 0.f);
+    double& LastShot = LastClientShotTime.FindOrAdd(Shooter, -UE_BIG_NUMBER);
+    if (Now - LastShot < MinInterval)
+    {
+        JOYSHIP_LOG_THROTTLED(LogJoyshipCombat, Warning, 1.0, TEXT("[ProjectileNet] %s fires faster than %.2fs; dropping shots"), *Shooter->GetName(), MinInterval);
+        return;
+    }
+    LastShot = Now;
+
+    // Only where and when come from the client, and only within limits
+    Event.Shooter = Shooter;
+    Event.ProjectileClass = Shooter->GetProjectileClass();
+    const FVector Muzzle = Shooter->GetMuzzleLocation();
+    if (FVector::DistSquared(Event.Origin, Muzzle) > FMath::Square(MaxOriginError))
+    {
+        Event.Origin = Muzzle;
+    }
+    // Shots leave along the ship's up vector; the client's may only differ by the rotation the server has not seen yet
+    const FVector Up = Shooter->GetActorUpVector();
+    const FVector ClientDirection = Event.Direction.GetSafeNormal();
+    Event.Direction = Up;
+    if (!ClientDirection.IsZero())
+    {
+        const float Angle = FMath::Acos(FMath::Clamp((float)FVector::DotProduct(Up, ClientDirection), -1.f, 1.f));
+        const float MaxAngle = FMath::DegreesToRadians(FMath::Max(MaxDirectionError, 0.f));
+        const FQuat Turn = FQuat::FindBetweenNormals(Up, ClientDirection);
+        Event.Direction = Angle <= MaxAngle ? ClientDirection : FQuat::Slerp(FQuat::Identity, Turn, MaxAngle / Angle).RotateVector(Up);
+    }
+    const double Rewind = FMath::Clamp(Now - Event.Time, 0.0, (double)MaxRewindTime);
+    Event.Time = (float)(Now - Rewind);
+
+    // Other clients see the shot from where and when it was fired
+    QueueFireEvent(Event);
+
+    USimulatedProjectileSubsystem* Sim = World->GetSubsystem<USimulatedProjectileSubsystem>();
+    const USimulatedProjectileSubsystem::FProjectileDesc* Desc = Sim ? Sim->FindOrAddDesc(Event.ProjectileClass) : nullptr;
+    if (!Desc || Rewind <= 0.0)
+    {
+        Shooter->LaunchProjectile(Event.Origin, Event.Direction.Rotation(), Event.Direction);
+        return;
+    }
+
+    JOYSHIP_TIMING_SCOPE(ProjectileHit);
+
+    // Sweep the flight the server missed one history step at a time, against ships where the client saw them.
+    // Turrets do not move, so they are tested where they are.
+    USpatialGridSubsystem* Grid = World->GetSubsystem<USpatialGridSubsystem>();
+    FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(RewoundProjectile), false);
+    FVector Position = Event.Origin;
+    double Time = Event.Time;
+    while (Time < Now)
+    {
+        const float Step = (float)FMath::Min(Now - Time, (double)HistoryInterval);
+        float Length = Desc->Speed * Step;
+        bool bBlocked = false;
+
+        FHitResult WorldHit;
+        if (Sim->bCollideWithWorld && World->LineTraceSingleByObjectType(WorldHit, Position, Position + Event.Direction * Length, FCollisionObjectQueryParams(ECC_WorldStatic), TraceParams))
+        {
+            Length = WorldHit.Distance;
+            bBlocked = true;
+        }
+
+        float HitDistance = 0.f;
+        AActor* Victim = TraceRewound(Position, Event.Direction, Length, Desc->Radius, Time + Step * 0.5f, Shooter, HitDistance);
+        if (!Victim && Grid)
+        {
+            Victim = Grid->FindFirstAlongRay(Position, Event.Direction, Length, Desc->Radius, ESpatialGridFlags::Turret, Shooter);
+        }
+
+        if (Victim)
+        {
+            UE_LOG(LogJoyshipCombat, VeryVerbose, TEXT("[ProjectileNet] %s hit %s rewound %.0f ms"), *Shooter->GetName(), *Victim->GetName(), Rewind * 1000.0);
+            if (UDamageSubsystem* DamageSys = World->GetSubsystem<UDamageSubsystem>())
+            {
+                DamageSys->QueueDamage(Victim, Desc->Damage, Shooter, DamageSys->NextShotId(), Shooter->GetController());
+            }
+            return;
+        }
+        if (bBlocked) return;
+
+        Position += Event.Direction * Length;
+        Time += Step;
+    }
+
+    // Missed everything so far: the server's projectile carries on from where it is by now
+    if (Rewind < Desc->LifeTime)
+    {
+        Shooter->LaunchProjectile(Position, Event.Direction.Rotation(), Event.Direction);
+    }
+}
+
+void UProjectileNetSubsystem::RegisterHistory(AActor* Actor)
+{
+    if (!Actor) return;
+    for (const FHistoryTrack& Track : Tracks)
+    {
+        if (Track.Actor == Actor) return;
+    }
+
+    FHistoryTrack& Track = Tracks.AddDefaulted_GetRef();
+    Track.Actor = Actor;
+    Track.Radius = Actor->GetSimpleCollisionRadius();
+    Track.Samples.SetNum(FMath::CeilToInt(FMath::Max(HistorySeconds, MaxRewindTime) / HistoryInterval) + 2);
+}
+
+void UProjectileNetSubsystem::UnregisterHistory(AActor* Actor)
+{
+    for (int32 i = 0; i < Tracks.Num(); ++i)
+    {
+        if (Tracks[i].Actor == Actor)
+        {
+            Tracks.RemoveAtSwap(i);
+            return;
+        }
+    }
+}
+
+void UProjectileNetSubsystem::RecordHistory()
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (LastHistoryTime >= 0.0 && Now - LastHistoryTime < HistoryInterval * 0.99) return;
+    LastHistoryTime = Now;
+
+    for (int32 i = Tracks.Num() - 1; i >= 0; --i)
+    {
+        FHistoryTrack& Track = Tracks[i];
+        const AActor* Actor = Track.Actor.Get();
+        if (!Actor)
+        {
+            Tracks.RemoveAtSwap(i);
+            continue;
+        }
+
+        Track.Samples[Track.Head] = FHistorySample{ Now, Actor->GetActorLocation() };
+        Track.Head = (Track.Head + 1) % Track.Samples.Num();
+        Track.Num = FMath::Min(Track.Num + 1, Track.Samples.Num());
+    }
+}
+
+const UProjectileNetSubsystem::FHistorySample& UProjectileNetSubsystem::GetSample(const FHistoryTrack& Track, int32 Age) const
+{
+    const int32 Capacity = Track.Samples.Num();
+    return Track.Samples[(Track.Head - 1 - Age + Capacity * 2) % Capacity];
+}
+
+bool UProjectileNetSubsystem::GetTrackLocation(const FHistoryTrack& Track, double Time, FVector& OutLocation) const
+{
+    if (Track.Num == 0) return false;
+
+    // Newest first; blend the two samples around Time, clamping to the ends of the history
+    for (int32 Age = 0; Age < Track.Num; ++Age)
+    {
+        const FHistorySample& Sample = GetSample(Track, Age);
+        if (Sample.Time <= Time)
+        {
+            if (Age == 0)
+            {
+                OutLocation = Sample.Location;
+            }
+            else
+            {
+                const FHistorySample& Newer = GetSample(Track, Age - 1);
+                const double Alpha = (Time - Sample.Time) / FMath::Max(Newer.Time - Sample.Time, UE_SMALL_NUMBER);
+                OutLocation = FMath::Lerp(Sample.Location, Newer.Location, Alpha);
+            }
+            return true;
+        }
+    }
+
+    OutLocation = GetSample(Track, Track.Num - 1).Location;
+    return true;
+}
+
+bool UProjectileNetSubsystem::GetHistoricalLocation(const AActor* Actor, double Time, FVector& OutLocation) const
+{
+    for (const FHistoryTrack& Track : Tracks)
+    {
+        if (Track.Actor == Actor)
+        {
+            return GetTrackLocation(Track, Time, OutLocation);
+        }
+    }
+    return false;
+}
+
+AActor* UProjectileNetSubsystem::TraceRewound(const FVector& Start, const FVector& Direction, float Length, float Radius, double Time, const AActor* Ignore, float& OutDistance) const
+{
+    AActor* Best = nullptr;
+    OutDistance = Length;
+
+    for (const FHistoryTrack& Track : Tracks)
+    {
+        AActor* Actor = Track.Actor.Get();
+        if (!Actor || Actor == Ignore) continue;
+
+        FVector Center;
+        if (!GetTrackLocation(Track, Time, Center)) continue;
+
+        // Closest point of the segment to the ship, against both radii
+        const float Along = FMath::Clamp((float)FVector::DotProduct(Center - Start, Direction), 0.f, Length);
+        const float Reach = Track.Radius + Radius;
+        if (Along <= OutDistance && FVector::DistSquared(Start + Direction * Along, Center) <= Reach * Reach)
+        {
+            OutDistance = Along;
+            Best = Actor;
+        }
+    }
+    return Best;
+}
+
+void UProjectileNetSubsystem::TickNetwork(float DeltaTime)
+{
+    RecordHistory();
+    FlushEvents();
+}
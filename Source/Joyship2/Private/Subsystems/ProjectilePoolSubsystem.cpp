@@ -0,0 +1,176 @@
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "JoyshipProfiling.h"
+#include "Weapons/Projectile.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Engine/World.h"
+
+bool UProjectilePoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    // Only game worlds fire projectiles; skip editor preview worlds
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+    for (const TPair<UClass*, FProjectilePool>& Pair : Pools)
+    {
+        DEC_MEMORY_STAT_BY(STAT_JoyshipProjectilePoolMemory, Pair.Key->GetStructureSize() * (Pair.Value.Stats.Free + Pair.Value.Stats.Active));
+    }
+    Pools.Empty();
+    TotalActive = 0;
+    TotalHighWaterMark = 0;
+    Super::Deinitialize();
+}
+
+void UProjectilePoolSubsystem::Prewarm(TSubclassOf<AActor> ProjectileClass, int32 Count)
+{
+    if (!ProjectileClass || !ProjectileClass->IsChildOf(AProjectile::StaticClass())) return;
+
+    FProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass.Get());
+    const int32 Missing = Count - (Pool.FreeList.Num() + Pool.Stats.Active);
+    for (int32 i = 0; i < Missing; ++i)
+    {
+        AProjectile* Projectile = SpawnPooledProjectile(ProjectileClass.Get());
+        if (!Projectile) break;
+        Pool.FreeList.Add(Projectile);
+    }
+    Pool.Stats.Free = Pool.FreeList.Num();
+}
+
+AActor* UProjectilePoolSubsystem::SpawnProjectile(TSubclassOf<AActor> ProjectileClass, const FVector& Location, const FRotator& Rotation, const FVector& Direction, AActor* Owner, APawn* Instigator)
+{
+    if (!ProjectileClass) return nullptr;
+    UWorld* World = GetWorld();
+    if (!World) return nullptr;
+
+    if (ProjectileClass->IsChildOf(AProjectile::StaticClass()))
+    {
+        AProjectile* Projectile = Acquire(ProjectileClass.Get());
+        if (Projectile)
+        {
+            Projectile->SetOwner(Owner);
+            Projectile->SetInstigator(Instigator);
+            Projectile->ActivateProjectile(Location, Rotation, Direction);
+        }
+        return Projectile;
+    }
+
+    // Not a pooled class: spawn it the old way
+    FActorSpawnParameters Params;
+    Params.Owner = Owner;
+    Params.Instigator = Instigator;
+
+    AActor* Spawned = World->SpawnActor<AActor>(ProjectileClass, Location, Rotation, Params);
+    if (Spawned)
+    {
+        UProjectileMovementComponent* PM = Spawned->FindComponentByClass<UProjectileMovementComponent>();
+        if (PM)
+        {
+            PM->Velocity = Direction * PM->InitialSpeed;
+        }
+    }
+    return Spawned;
+}
+
+AProjectile* UProjectilePoolSubsystem::Acquire(TSubclassOf<AProjectile> ProjectileClass)
+{
+    if (!ProjectileClass) return nullptr;
+
+    FProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass.Get());
+
+    AProjectile* Projectile = nullptr;
+    while (!Projectile && Pool.FreeList.Num() > 0)
+    {
+        // Entries can go stale if something destroyed a pooled projectile directly
+        AProjectile* Candidate = Pool.FreeList.Pop(EAllowShrinking::No);
+        if (IsValid(Candidate))
+        {
+            Projectile = Candidate;
+        }
+    }
+
+    if (Projectile)
+    {
+        ++Pool.Stats.Hits;
+    }
+    else
+    {
+        ++Pool.Stats.Misses;
+        Projectile = SpawnPooledProjectile(ProjectileClass);
+        if (!Projectile) return nullptr;
+    }
+
+    ++Pool.Stats.Active;
+    Pool.Stats.Free = Pool.FreeList.Num();
+    Pool.Stats.HighWaterMark = FMath::Max(Pool.Stats.HighWaterMark, Pool.Stats.Active);
+
+    ++TotalActive;
+    TotalHighWaterMark = FMath::Max(TotalHighWaterMark, TotalActive);
+
+    return Projectile;
+}
+
+void UProjectilePoolSubsystem::Release(AProjectile* Projectile)
+{
+    if (!IsValid(Projectile)) return;
+    // Already back in the pool (e.g. hit and overlap in the same frame)
+    if (!Projectile->bActive) return;
+
+    Projectile->DeactivateProjectile();
+
+    FProjectilePool& Pool = Pools.FindOrAdd(Projectile->GetClass());
+    Pool.FreeList.Add(Projectile);
+    Pool.Stats.Active = FMath::Max(0, Pool.Stats.Active - 1);
+    Pool.Stats.Free = Pool.FreeList.Num();
+    TotalActive = FMath::Max(0, TotalActive - 1);
+}
+
+AProjectile* UProjectilePoolSubsystem::SpawnPooledProjectile(TSubclassOf<AProjectile> ProjectileClass)
+{
+    UWorld* World = GetWorld();
+    if (!World) return nullptr;
+
+    // Mark as pooled before BeginPlay so the projectile does not arm its own lifespan
+    AProjectile* Projectile = World->SpawnActorDeferred<AProjectile>(ProjectileClass, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    if (!Projectile) return nullptr;
+
+    Projectile->bPooled = true;
+    Projectile->FinishSpawning(FTransform::Identity);
+    Projectile->DeactivateProjectile();
+
+    // Shallow size: the actor object itself, not its components
+    INC_MEMORY_STAT_BY(STAT_JoyshipProjectilePoolMemory, ProjectileClass->GetStructureSize());
+    return Projectile;
+}
+
+FProjectilePoolStats UProjectilePoolSubsystem::GetStatsForClass(TSubclassOf<AActor> ProjectileClass) const
+{
+    const FProjectilePool* Pool = Pools.Find(ProjectileClass.Get());
+    return Pool ? Pool->Stats : FProjectilePoolStats();
+}
+
+FProjectilePoolStats UProjectilePoolSubsystem::GetTotalStats() const
+{
+    FProjectilePoolStats Total;
+    for (const TPair<UClass*, FProjectilePool>& Pair : Pools)
+    {
+        Total.Hits += Pair.Value.Stats.Hits;
+        Total.Misses += Pair.Value.Stats.Misses;
+        Total.Active += Pair.Value.Stats.Active;
+        Total.Free += Pair.Value.Stats.Free;
+    }
+    Total.HighWaterMark = TotalHighWaterMark;
+    return Total;
+}
+
+void UProjectilePoolSubsystem::ResetStats()
+{
+    for (TPair<UClass*, FProjectilePool>& Pair : Pools)
+    {
+        Pair.Value.Stats.Hits = 0;
+        Pair.Value.Stats.Misses = 0;
+        Pair.Value.Stats.HighWaterMark = Pair.Value.Stats.Active;
+    }
+    TotalHighWaterMark = TotalActive;
+}
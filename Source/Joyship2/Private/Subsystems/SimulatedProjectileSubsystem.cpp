@@ -0,0 +1,244 @@
+#include "Subsystems/SimulatedProjectileSubsystem.h"
+#include "Joyship2.h"
+#include "JoyshipProfiling.h"
+#include "Weapons/Projectile.h"
+#include "Components/SphereComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "Subsystems/DamageSubsystem.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Async/ParallelFor.h"
+
+void FSimulatedProjectileTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->UpdateProjectiles(DeltaTime);
+    }
+}
+
+FString FSimulatedProjectileTickFunction::DiagnosticMessage()
+{
+    return TEXT("USimulatedProjectileSubsystem::UpdateProjectiles");
+}
+
+bool USimulatedProjectileSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void USimulatedProjectileSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    TickFunction.Target = this;
+    TickFunction.bCanEverTick = true;
+    TickFunction.bStartWithTickEnabled = true;
+    TickFunction.TickGroup = TG_PrePhysics;
+    TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void USimulatedProjectileSubsystem::Deinitialize()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.UnRegisterTickFunction();
+    }
+    TickFunction.Target = nullptr;
+
+    JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveProjectiles, -Positions.Num());
+
+    Positions.Empty();
+    Velocities.Empty();
+    RemainingLife.Empty();
+    Damages.Empty();
+    Radii.Empty();
+    Owners.Empty();
+    InstigatorControllers.Empty();
+    ShotIds.Empty();
+    MeshHandles.Empty();
+    MeshTransforms.Empty();
+    Descs.Empty();
+    DescClasses.Empty();
+    Super::Deinitialize();
+}
+
+const USimulatedProjectileSubsystem::FProjectileDesc* USimulatedProjectileSubsystem::FindOrAddDesc(UClass* ProjectileClass)
+{
+    if (const FProjectileDesc* Existing = Descs.Find(ProjectileClass))
+    {
+        return Existing;
+    }
+
+    const AProjectile* CDO = ProjectileClass ? Cast<AProjectile>(ProjectileClass->GetDefaultObject()) : nullptr;
+    if (!CDO) return nullptr;
+
+    FProjectileDesc Desc;
+    Desc.Damage = CDO->Damage;
+    if (CDO->LifeTime > 0.f) Desc.LifeTime = CDO->LifeTime;
+    if (CDO->ProjectileMovement) Desc.Speed = CDO->ProjectileMovement->InitialSpeed;
+    if (CDO->CollisionComp) Desc.Radius = CDO->CollisionComp->GetUnscaledSphereRadius();
+    Desc.Mesh = CDO->InstancedMesh;
+    Desc.MeshTransform = CDO->InstancedMeshTransform;
+
+    DescClasses.Add(ProjectileClass);
+    return &Descs.Add(ProjectileClass, Desc);
+}
+
+bool USimulatedProjectileSubsystem::Fire(TSubclassOf<AActor> ProjectileClass, const FVector& Location, const FVector& Direction, AActor* Owner, APawn* Instigator, float ElapsedTime)
+{
+    const FProjectileDesc* Desc = FindOrAddDesc(ProjectileClass);
+    if (!Desc) return false;
+    ++TotalFired;
+
+    // Already expired: handled, nothing to simulate
+    ElapsedTime = FMath::Max(ElapsedTime, 0.f);
+    if (ElapsedTime >= Desc->LifeTime) return true;
+
+    const FVector Dir = Direction.GetSafeNormal();
+    const FVector Start = Location + Dir * Desc->Speed * ElapsedTime;
+    Positions.Add(Start);
+    Velocities.Add(Dir * Desc->Speed);
+    RemainingLife.Add(Desc->LifeTime - ElapsedTime);
+    Damages.Add(Desc->Damage);
+    Radii.Add(Desc->Radius);
+    Owners.Add(Owner);
+    InstigatorControllers.Add(Instigator ? Instigator->GetController() : nullptr);
+    UDamageSubsystem* DamageSys = GetWorld()->GetSubsystem<UDamageSubsystem>();
+    ShotIds.Add(DamageSys ? DamageSys->NextShotId() : 0);
+    MeshTransforms.Add(Desc->MeshTransform);
+
+    FInstancedMeshHandle Handle;
+    if (Desc->Mesh)
+    {
+        if (UInstancedMeshSubsystem* Instanced = GetWorld()->GetSubsystem<UInstancedMeshSubsystem>())
+        {
+            Handle = Instanced->AddInstance(Desc->Mesh, Desc->MeshTransform * FTransform(Dir.Rotation(), Start));
+        }
+    }
+    MeshHandles.Add(Handle);
+
+    JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveProjectiles, 1);
+    return true;
+}
+
+void USimulatedProjectileSubsystem::RemoveProjectile(int32 Index)
+{
+    if (MeshHandles[Index].IsValid())
+    {
+        if (UInstancedMeshSubsystem* Instanced = GetWorld()->GetSubsystem<UInstancedMeshSubsystem>())
+        {
+            Instanced->RemoveInstance(MeshHandles[Index]);
+        }
+    }
+
+    Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    RemainingLife.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Damages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Radii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Owners.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    InstigatorControllers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    ShotIds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    MeshHandles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    MeshTransforms.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    PrevPositions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+    JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveProjectiles, -1);
+}
+
+void USimulatedProjectileSubsystem::ApplyHit(int32 Index, AActor* Victim)
+{
+    JOYSHIP_TIMING_SCOPE(ProjectileHit);
+
+    UE_LOG(LogJoyshipCombat, VeryVerbose, TEXT("[SimulatedProjectile] Hit %s for %.1f"), *Victim->GetName(), Damages[Index]);
+
+    // Clients only draw shots; the server resolves the hits
+    if (GetWorld()->GetNetMode() == NM_Client) return;
+
+    if (UDamageSubsystem* DamageSys = GetWorld()->GetSubsystem<UDamageSubsystem>())
+    {
+        DamageSys->QueueDamage(Victim, Damages[Index], Owners[Index].Get(), ShotIds[Index], InstigatorControllers[Index].Get());
+    }
+    else
+    {
+        UGameplayStatics::ApplyDamage(Victim, Damages[Index], InstigatorControllers[Index].Get(), Owners[Index].Get(), UDamageType::StaticClass());
+    }
+}
+
+void USimulatedProjectileSubsystem::UpdateProjectiles(float DeltaTime)
+{
+    JOYSHIP_TIMING_SCOPE(ProjectileSim);
+
+    const int32 Num = Positions.Num();
+    if (Num == 0) return;
+
+    UWorld* World = GetWorld();
+    if (!World) return;
+
+    // Integrate
+    PrevPositions.SetNumUninitialized(Num, EAllowShrinking::No);
+    ParallelFor(Num, [this, DeltaTime](int32 i)
+    {
+        PrevPositions[i] = Positions[i];
+        Positions[i] += Velocities[i] * DeltaTime;
+        RemainingLife[i] -= DeltaTime;
+    }, Num < MinProjectilesForParallel ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    // Hit-test each swept segment; backwards so RemoveAtSwap never skips an entry
+    USpatialGridSubsystem* Grid = World->GetSubsystem<USpatialGridSubsystem>();
+    FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(SimulatedProjectile), false);
+    const FCollisionObjectQueryParams WorldStatic(ECC_WorldStatic);
+
+    for (int32 i = Num - 1; i >= 0; --i)
+    {
+        const FVector Start = PrevPositions[i];
+        FVector Segment = Positions[i] - Start;
+        float Length = Segment.Size();
+        bool bStopped = false;
+
+        if (bCollideWithWorld && Length > KINDA_SMALL_NUMBER)
+        {
+            FHitResult Hit;
+            if (World->LineTraceSingleByObjectType(Hit, Start, Positions[i], WorldStatic, TraceParams))
+            {
+                // Only things in front of the wall can be hit
+                Length = Hit.Distance;
+                Positions[i] = Hit.Location;
+                bStopped = true;
+            }
+        }
+
+        if (Grid && Length > KINDA_SMALL_NUMBER)
+        {
+            const ESpatialGridFlags Filter = ESpatialGridFlags::Ship | ESpatialGridFlags::Damageable;
+            if (AActor* Victim = Grid->FindFirstAlongRay(Start, Segment, Length, Radii[i], Filter, Owners[i].Get()))
+            {
+                ApplyHit(i, Victim);
+                bStopped = true;
+            }
+        }
+
+        if (bStopped || RemainingLife[i] <= 0.f)
+        {
+            RemoveProjectile(i);
+        }
+    }
+
+    // Push surviving positions to the instanced renderer in one batch
+    if (UInstancedMeshSubsystem* Instanced = World->GetSubsystem<UInstancedMeshSubsystem>())
+    {
+        for (int32 i = 0; i < Positions.Num(); ++i)
+        {
+            if (MeshHandles[i].IsValid())
+            {
+                Instanced->SetInstanceTransform(MeshHandles[i], MeshTransforms[i] * FTransform(Velocities[i].Rotation(), Positions[i]));
+            }
+        }
+    }
+}
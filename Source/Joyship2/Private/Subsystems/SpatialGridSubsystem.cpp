@@ -0,0 +1,411 @@
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "JoyshipProfiling.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+
+bool USpatialGridSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void USpatialGridSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Turrets target any pawn, as their trigger overlap did, so pawns are indexed without opting in
+    ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &USpatialGridSubsystem::HandleActorSpawned));
+}
+
+void USpatialGridSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Pawns placed in the level were not spawned through the handler
+    for (TActorIterator<APawn> It(&InWorld); It; ++It)
+    {
+        Register(*It, ESpatialGridFlags::Pawn);
+    }
+}
+
+void USpatialGridSubsystem::HandleActorSpawned(AActor* Actor)
+{
+    if (Actor && Actor->IsA<APawn>())
+    {
+        Register(Actor, ESpatialGridFlags::Pawn);
+    }
+}
+
+void USpatialGridSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+    }
+    ActorSpawnedHandle.Reset();
+    Entries.Empty();
+    EntryIndex.Empty();
+    FreeSlots.Empty();
+    ReleasedSlots.Empty();
+    AddedSinceBuild.Empty();
+    BucketStart.Empty();
+    SortedEntries.Empty();
+    SortedCells.Empty();
+    SortedPositions.Empty();
+    Super::Deinitialize();
+}
+
+void USpatialGridSubsystem::Register(AActor* Actor, ESpatialGridFlags Flags, float Radius)
+{
+    if (!Actor) return;
+
+    const TObjectKey<AActor> Key(Actor);
+    if (int32* Existing = EntryIndex.Find(Key))
+    {
+        FEntry& Entry = Entries[*Existing];
+        Entry.Flags |= Flags;
+        if (Radius >= 0.f || !Entry.bExplicitRadius)
+        {
+            // A pawn indexed at spawn may not have had its collision registered yet
+            Entry.Radius = Radius >= 0.f ? Radius : Actor->GetSimpleCollisionRadius();
+            Entry.bExplicitRadius |= Radius >= 0.f;
+            MaxEntryRadius = FMath::Max(MaxEntryRadius, Entry.Radius);
+        }
+        return;
+    }
+
+    const int32 Slot = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+    FEntry& Entry = Entries[Slot];
+    Entry.Actor = Actor;
+    Entry.Key = Key;
+    Entry.Radius = Radius >= 0.f ? Radius : Actor->GetSimpleCollisionRadius();
+    Entry.Flags = Flags;
+    Entry.bExplicitRadius = Radius >= 0.f;
+    EntryIndex.Add(Key, Slot);
+
+    MaxEntryRadius = FMath::Max(MaxEntryRadius, Entry.Radius);
+
+    // Already built this frame: queries pick the entry up from the added list until the next build
+    if (IsBuilt())
+    {
+        AddedSinceBuild.Add({ Slot, ToPlane(Actor->GetActorLocation()) });
+    }
+}
+
+void USpatialGridSubsystem::Unregister(AActor* Actor)
+{
+    if (const int32* Slot = EntryIndex.Find(TObjectKey<AActor>(Actor)))
+    {
+        ReleaseSlot(*Slot);
+    }
+}
+
+void USpatialGridSubsystem::ReleaseSlot(int32 Slot)
+{
+    EntryIndex.Remove(Entries[Slot].Key);
+    Entries[Slot] = FEntry();
+    (IsBuilt() ? ReleasedSlots : FreeSlots).Add(Slot);
+}
+
+bool USpatialGridSubsystem::GetFlags(const AActor* Actor, ESpatialGridFlags& OutFlags) const
+{
+    const int32* Slot = EntryIndex.Find(TObjectKey<AActor>(Actor));
+    if (!Slot) return false;
+    OutFlags = Entries[*Slot].Flags;
+    return true;
+}
+
+bool USpatialGridSubsystem::GetRadius(const AActor* Actor, float& OutRadius) const
+{
+    const int32* Slot = EntryIndex.Find(TObjectKey<AActor>(Actor));
+    if (!Slot) return false;
+    OutRadius = Entries[*Slot].Radius;
+    return true;
+}
+
+void USpatialGridSubsystem::SetCellSize(float NewCellSize)
+{
+    CellSize = FMath::Max(NewCellSize, 1.f);
+    BuiltFrame = MAX_uint64;
+}
+
+FIntPoint USpatialGridSubsystem::CellOf(const FVector2D& P) const
+{
+    return FIntPoint(FMath::FloorToInt(P.X / CellSize), FMath::FloorToInt(P.Y / CellSize));
+}
+
+int32 USpatialGridSubsystem::BucketOf(const FIntPoint& Cell) const
+{
+    // Bucket count is a power of two
+    const uint32 Hash = (uint32)Cell.X * 73856093u ^ (uint32)Cell.Y * 19349663u;
+    return (int32)(Hash & BucketMask);
+}
+
+void USpatialGridSubsystem::EnsureBuilt()
+{
+    if (IsBuilt()) return;
+
+    // Nothing refers to these slots once the old build is dropped
+    FreeSlots.Append(ReleasedSlots);
+    ReleasedSlots.Reset();
+    AddedSinceBuild.Reset();
+
+    // Drop anything destroyed without unregistering
+    for (int32 Slot = 0; Slot < Entries.Num(); ++Slot)
+    {
+        if (IsSlotUsed(Slot) && !Entries[Slot].Actor.IsValid())
+        {
+            ReleaseSlot(Slot);
+        }
+    }
+    BuiltFrame = GFrameCounter;
+
+    const int32 Num = EntryIndex.Num();
+    const int32 NumBuckets = (int32)FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(64, Num * 2));
+    BucketMask = (uint32)NumBuckets - 1;
+
+    // Counting sort of live slots by bucket
+    BucketStart.Reset();
+    BucketStart.SetNumZeroed(NumBuckets + 1);
+
+    SortedPositions.SetNumUninitialized(Num, EAllowShrinking::No);
+    SortedCells.SetNumUninitialized(Num, EAllowShrinking::No);
+    SortedEntries.SetNumUninitialized(Num, EAllowShrinking::No);
+
+    TArray<int32> LiveSlots;
+    LiveSlots.Reserve(Num);
+    TArray<int32> EntryBucket;
+    EntryBucket.Reserve(Num);
+    TArray<FVector2D> EntryPos;
+    EntryPos.Reserve(Num);
+
+    for (int32 Slot = 0; Slot < Entries.Num(); ++Slot)
+    {
+        if (!IsSlotUsed(Slot)) continue;
+
+        const FVector2D P = ToPlane(Entries[Slot].Actor->GetActorLocation());
+        const int32 Bucket = BucketOf(CellOf(P));
+        LiveSlots.Add(Slot);
+        EntryPos.Add(P);
+        EntryBucket.Add(Bucket);
+        ++BucketStart[Bucket + 1];
+    }
+    for (int32 b = 0; b < NumBuckets; ++b)
+    {
+        BucketStart[b + 1] += BucketStart[b];
+    }
+
+    TArray<int32> Cursor(BucketStart.GetData(), NumBuckets);
+    for (int32 i = 0; i < LiveSlots.Num(); ++i)
+    {
+        const int32 Index = Cursor[EntryBucket[i]]++;
+        SortedEntries[Index] = LiveSlots[i];
+        SortedPositions[Index] = EntryPos[i];
+        SortedCells[Index] = CellOf(EntryPos[i]);
+    }
+
+    SET_MEMORY_STAT(STAT_JoyshipSpatialGridMemory, Entries.GetAllocatedSize() + EntryIndex.GetAllocatedSize() + FreeSlots.GetAllocatedSize()
+        + BucketStart.GetAllocatedSize() + SortedEntries.GetAllocatedSize() + SortedCells.GetAllocatedSize() + SortedPositions.GetAllocatedSize());
+}
+
+template<typename FuncType>
+void USpatialGridSubsystem::ForEachInCell(const FIntPoint& Cell, ESpatialGridFlags Filter, const AActor* IgnoreActor, FuncType&& Func)
+{
+    const int32 Bucket = BucketOf(Cell);
+    for (int32 k = BucketStart[Bucket]; k < BucketStart[Bucket + 1]; ++k)
+    {
+        // Buckets are shared by hash collisions; only take entries from this cell
+        if (SortedCells[k] != Cell) continue;
+
+        // Unregistered since the build: the slot has no flags left
+        const FEntry& Entry = Entries[SortedEntries[k]];
+        if (!EnumHasAnyFlags(Entry.Flags, Filter)) continue;
+
+        // Destroyed since the build: skipped now, pruned on the next build
+        AActor* Actor = Entry.Actor.Get();
+        if (!Actor || Actor == IgnoreActor) continue;
+
+        Func(Entry, Actor, SortedPositions[k]);
+    }
+}
+
+template<typename FuncType>
+void USpatialGridSubsystem::ForEachAdded(ESpatialGridFlags Filter, const AActor* IgnoreActor, FuncType&& Func)
+{
+    for (const FAddedEntry& Added : AddedSinceBuild)
+    {
+        const FEntry& Entry = Entries[Added.Slot];
+        if (!EnumHasAnyFlags(Entry.Flags, Filter)) continue;
+
+        AActor* Actor = Entry.Actor.Get();
+        if (!Actor || Actor == IgnoreActor) continue;
+
+        Func(Entry, Actor, Added.Position);
+    }
+}
+
+template<typename FuncType>
+void USpatialGridSubsystem::ForEachInCells(const FIntPoint& MinCell, const FIntPoint& MaxCell, ESpatialGridFlags Filter, const AActor* IgnoreActor, FuncType&& Func)
+{
+    for (int32 CY = MinCell.Y; CY <= MaxCell.Y; ++CY)
+    {
+        for (int32 CX = MinCell.X; CX <= MaxCell.X; ++CX)
+        {
+            ForEachInCell(FIntPoint(CX, CY), Filter, IgnoreActor, Func);
+        }
+    }
+    // Few of these, and the callers' own distance tests reject any outside the range
+    ForEachAdded(Filter, IgnoreActor, Func);
+}
+
+void USpatialGridSubsystem::QueryRadius(const FVector& Center, float Radius, ESpatialGridFlags Filter, TArray<AActor*>& OutActors, const AActor* IgnoreActor)
+{
+    EnsureBuilt();
+
+    const FVector2D C = ToPlane(Center);
+    const float Pad = Radius + MaxEntryRadius;
+    const FIntPoint MinCell = CellOf(C - FVector2D(Pad));
+    const FIntPoint MaxCell = CellOf(C + FVector2D(Pad));
+
+    ForEachInCells(MinCell, MaxCell, Filter, IgnoreActor, [&](const FEntry& Entry, AActor* Actor, const FVector2D& P)
+    {
+        const float Reach = Radius + Entry.Radius;
+        if (FVector2D::DistSquared(P, C) <= Reach * Reach)
+        {
+            OutActors.Add(Actor);
+        }
+    });
+}
+
+void USpatialGridSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, ESpatialGridFlags Filter, TArray<AActor*>& OutActors, const AActor* IgnoreActor)
+{
+    EnsureBuilt();
+
+    const FVector2D O = ToPlane(Origin);
+    const FVector2D Dir = ToPlane(Direction).GetSafeNormal();
+    if (Dir.IsNearlyZero()) return;
+
+    const float HalfAngle = FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.f, 180.f));
+    const float CosHalfAngle = FMath::Cos(HalfAngle);
+    const float SinHalfAngle = FMath::Sin(HalfAngle);
+
+    // Ends of the cone's two straight edges
+    const FVector2D EdgeA = O + FVector2D(Dir.X * CosHalfAngle - Dir.Y * SinHalfAngle, Dir.X * SinHalfAngle + Dir.Y * CosHalfAngle) * Range;
+    const FVector2D EdgeB = O + FVector2D(Dir.X * CosHalfAngle + Dir.Y * SinHalfAngle, -Dir.X * SinHalfAngle + Dir.Y * CosHalfAngle) * Range;
+    const float Pad = Range + MaxEntryRadius;
+    const FIntPoint MinCell = CellOf(O - FVector2D(Pad));
+    const FIntPoint MaxCell = CellOf(O + FVector2D(Pad));
+
+    ForEachInCells(MinCell, MaxCell, Filter, IgnoreActor, [&](const FEntry& Entry, AActor* Actor, const FVector2D& P)
+    {
+        const FVector2D To = P - O;
+        const float DistSq = To.SizeSquared();
+        const float Reach = Range + Entry.Radius;
+        if (DistSq > Reach * Reach) return;
+
+        // The origin is inside the actor's circle
+        const float Dist = FMath::Sqrt(DistSq);
+        if (Dist <= Entry.Radius || Dist <= KINDA_SMALL_NUMBER)
+        {
+            OutActors.Add(Actor);
+            return;
+        }
+
+        // Centre within the cone's angle (compare cosines instead of computing the angle): the range test above is exact
+        if (FVector2D::DotProduct(To, Dir) >= CosHalfAngle * Dist)
+        {
+            OutActors.Add(Actor);
+            return;
+        }
+
+        // Outside the angle the nearest point of the cone is on one of its straight edges
+        const float RadiusSq = Entry.Radius * Entry.Radius;
+        if (FVector2D::DistSquared(P, FMath::ClosestPointOnSegment2D(P, O, EdgeA)) <= RadiusSq
+            || FVector2D::DistSquared(P, FMath::ClosestPointOnSegment2D(P, O, EdgeB)) <= RadiusSq)
+        {
+            OutActors.Add(Actor);
+        }
+    });
+}
+
+AActor* USpatialGridSubsystem::FindFirstAlongRay(const FVector& Origin, const FVector& Direction, float Range, float Radius, ESpatialGridFlags Filter, const AActor* IgnoreActor)
+{
+    EnsureBuilt();
+
+    const FVector2D O = ToPlane(Origin);
+    const FVector2D Dir = ToPlane(Direction).GetSafeNormal();
+    if (Dir.IsNearlyZero()) return nullptr;
+    Range = FMath::Max(Range, 0.f);
+
+    AActor* Best = nullptr;
+    float BestAlong = TNumericLimits<float>::Max();
+
+    auto TestEntry = [&](const FEntry& Entry, AActor* Actor, const FVector2D& P)
+    {
+        const FVector2D To = P - O;
+        const float Along = FMath::Clamp(FVector2D::DotProduct(To, Dir), 0.f, Range);
+        const float Reach = Radius + Entry.Radius;
+        if ((To - Dir * Along).SizeSquared() <= Reach * Reach && Along < BestAlong)
+        {
+            BestAlong = Along;
+            Best = Actor;
+        }
+    };
+
+    // Walk the cells under the ray in order (2D DDA), visiting every cell within Pad of each one the ray crosses
+    const float Pad = Radius + MaxEntryRadius;
+    const int32 PadCells = FMath::CeilToInt(Pad / CellSize);
+    // Everything first visited from a cell the ray enters at T lies at least T - Slack along the ray
+    const float Slack = (2 * PadCells + 1) * CellSize * UE_SQRT_2;
+
+    const FVector2D End = O + Dir * Range;
+    const FIntPoint EndCell = CellOf(End);
+    FIntPoint Cell = CellOf(O);
+    const int32 NumSteps = FMath::Abs(EndCell.X - Cell.X) + FMath::Abs(EndCell.Y - Cell.Y);
+
+    const int32 StepX = Dir.X >= 0.f ? 1 : -1;
+    const int32 StepY = Dir.Y >= 0.f ? 1 : -1;
+    const float DeltaX = FMath::IsNearlyZero(Dir.X) ? TNumericLimits<float>::Max() : CellSize / FMath::Abs(Dir.X);
+    const float DeltaY = FMath::IsNearlyZero(Dir.Y) ? TNumericLimits<float>::Max() : CellSize / FMath::Abs(Dir.Y);
+    float NextX = FMath::IsNearlyZero(Dir.X) ? TNumericLimits<float>::Max() : ((Cell.X + (StepX > 0 ? 1 : 0)) * CellSize - O.X) / Dir.X;
+    float NextY = FMath::IsNearlyZero(Dir.Y) ? TNumericLimits<float>::Max() : ((Cell.Y + (StepY > 0 ? 1 : 0)) * CellSize - O.Y) / Dir.Y;
+    float EnterT = 0.f;
+
+    TSet<FIntPoint, DefaultKeyFuncs<FIntPoint>, TInlineSetAllocator<64>> Visited;
+    for (int32 Step = 0; ; ++Step)
+    {
+        if (Best && EnterT - Slack > BestAlong) break;
+
+        for (int32 CY = Cell.Y - PadCells; CY <= Cell.Y + PadCells; ++CY)
+        {
+            for (int32 CX = Cell.X - PadCells; CX <= Cell.X + PadCells; ++CX)
+            {
+                bool bAlreadyVisited = false;
+                Visited.Add(FIntPoint(CX, CY), &bAlreadyVisited);
+                if (!bAlreadyVisited)
+                {
+                    ForEachInCell(FIntPoint(CX, CY), Filter, IgnoreActor, TestEntry);
+                }
+            }
+        }
+
+        if (Step >= NumSteps) break;
+        if (NextX < NextY)
+        {
+            Cell.X += StepX;
+            EnterT = NextX;
+            NextX += DeltaX;
+        }
+        else
+        {
+            Cell.Y += StepY;
+            EnterT = NextY;
+            NextY += DeltaY;
+        }
+    }
+
+    ForEachAdded(Filter, IgnoreActor, TestEntry);
+
+    return Best;
+}
@@ -0,0 +1,95 @@
+#include "Subsystems/StreamingCellSubsystem.h"
+#include "Joyship2.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+
+bool UStreamingCellSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UStreamingCellSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UStreamingCellSubsystem::HandleLevelAdded);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UStreamingCellSubsystem::HandleLevelRemoved);
+}
+
+void UStreamingCellSubsystem::Deinitialize()
+{
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    ConsumedActors.Empty();
+    Super::Deinitialize();
+}
+
+void UStreamingCellSubsystem::HandleLevelAdded(ULevel* Level, UWorld* World)
+{
+    if (World != GetWorld() || !Level || Level->IsPersistentLevel()) return;
+
+    ++Stats.LoadedCells;
+    Stats.PeakLoadedCells = FMath::Max(Stats.PeakLoadedCells, Stats.LoadedCells);
+    UE_LOG(LogJoyship, Verbose, TEXT("[Streaming] Cell in: %s (%d loaded, %d actors)"), *GetNameSafe(Level->GetOuter()), Stats.LoadedCells, Stats.LiveActors);
+}
+
+void UStreamingCellSubsystem::HandleLevelRemoved(ULevel* Level, UWorld* World)
+{
+    // Removal during world teardown passes a null level
+    if (World != GetWorld() || !Level || Level->IsPersistentLevel()) return;
+
+    Stats.LoadedCells = FMath::Max(0, Stats.LoadedCells - 1);
+    UE_LOG(LogJoyship, Verbose, TEXT("[Streaming] Cell out: %s (%d loaded, %d actors)"), *GetNameSafe(Level->GetOuter()), Stats.LoadedCells, Stats.LiveActors);
+}
+
+bool UStreamingCellSubsystem::DiscardIfConsumed(AActor* Actor)
+{
+    UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+    if (!World || World->GetNetMode() == NM_Client || !Actor->IsNetStartupActor()) return false;
+
+    const UStreamingCellSubsystem* Cells = World->GetSubsystem<UStreamingCellSubsystem>();
+    if (!Cells || !Cells->IsConsumed(Actor)) return false;
+
+    // Not begun play yet, so no manager ever sees it
+    Actor->Destroy();
+    return true;
+}
+
+bool UStreamingCellSubsystem::IsConsumed(const AActor* Actor) const
+{
+    return Actor && ConsumedActors.Num() > 0 && ConsumedActors.Contains(FSoftObjectPath(Actor));
+}
+
+void UStreamingCellSubsystem::AddCellActor(AActor* Actor)
+{
+    if (!Actor) return;
+
+    ++Stats.LiveActors;
+    Stats.PeakActors = FMath::Max(Stats.PeakActors, Stats.LiveActors);
+}
+
+void UStreamingCellSubsystem::RemoveCellActor(AActor* Actor, EEndPlayReason::Type EndPlayReason, bool bConsumed)
+{
+    if (!Actor) return;
+
+    Stats.LiveActors = FMath::Max(0, Stats.LiveActors - 1);
+
+    // Only placed actors are reloaded with their cell; spawned ones are simply gone
+    if (bConsumed && Actor->IsNetStartupActor() && GetWorld()->GetNetMode() != NM_Client)
+    {
+        ConsumedActors.Add(FSoftObjectPath(Actor));
+        ++Stats.Consumed;
+    }
+    else if (EndPlayReason == EEndPlayReason::RemovedFromWorld)
+    {
+        ++Stats.StreamedOut;
+    }
+}
+
+void UStreamingCellSubsystem::ResetPeaks()
+{
+    Stats.PeakLoadedCells = Stats.LoadedCells;
+    Stats.PeakActors = Stats.LiveActors;
+}
@@ -0,0 +1,169 @@
+#include "Subsystems/TickSignificanceSubsystem.h"
+#include "Pawns/PlayerShip.h"
+#include "Camera/CameraComponent.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+bool UTickSignificanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UTickSignificanceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    InWorld.GetTimerManager().SetTimer(UpdateTimer, this, &UTickSignificanceSubsystem::UpdateSignificance, FMath::Max(UpdateInterval, 0.02f), true);
+}
+
+void UTickSignificanceSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(UpdateTimer);
+    }
+    Entries.Empty();
+    EntryIndex.Empty();
+    Viewers.Empty();
+    Super::Deinitialize();
+}
+
+void UTickSignificanceSubsystem::Register(AActor* Actor, FOnTierChanged&& OnTierChanged)
+{
+    if (!Actor || EntryIndex.Contains(Actor)) return;
+
+    // Score immediately so a freshly spawned far-away actor does not tick at full rate until the next update
+    if (Viewers.Num() == 0)
+    {
+        GatherViewers();
+    }
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Actor = Actor;
+    Entry.Key = Actor;
+    Entry.Tier = ScoreLocation(Actor->GetActorLocation());
+    Entry.OnTierChanged = MoveTemp(OnTierChanged);
+    EntryIndex.Add(Actor, Entries.Num() - 1);
+    ++TierCounts[(int32)Entry.Tier];
+
+    if (Entry.OnTierChanged)
+    {
+        Entry.OnTierChanged(Entry.Tier);
+    }
+}
+
+void UTickSignificanceSubsystem::Unregister(AActor* Actor)
+{
+    RemoveEntry(Actor);
+}
+
+void UTickSignificanceSubsystem::RemoveEntry(const TObjectKey<AActor>& Key)
+{
+    int32 Index = INDEX_NONE;
+    if (!EntryIndex.RemoveAndCopyValue(Key, Index)) return;
+
+    --TierCounts[(int32)Entries[Index].Tier];
+    Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    if (Index < Entries.Num())
+    {
+        EntryIndex.Add(Entries[Index].Key, Index);
+    }
+}
+
+ESignificanceTier UTickSignificanceSubsystem::GetTier(const AActor* Actor) const
+{
+    const int32* Index = EntryIndex.Find(Actor);
+    return Index ? Entries[*Index].Tier : ESignificanceTier::High;
+}
+
+float UTickSignificanceSubsystem::GetTierTickInterval(ESignificanceTier Tier) const
+{
+    switch (Tier)
+    {
+    case ESignificanceTier::Medium:  return MediumTickInterval;
+    case ESignificanceTier::Low:     return LowTickInterval;
+    case ESignificanceTier::Dormant: return DormantTickInterval;
+    default:                         return 0.f;
+    }
+}
+
+void UTickSignificanceSubsystem::GatherViewers()
+{
+    Viewers.Reset();
+    for (TActorIterator<APlayerShip> It(GetWorld()); It; ++It)
+    {
+        const APlayerShip* Ship = *It;
+        if (!IsValid(Ship)) continue;
+
+        FViewer& Viewer = Viewers.AddDefaulted_GetRef();
+        Viewer.Location = Ship->GetActorLocation();
+        if (Ship->Camera)
+        {
+            Viewer.CameraLocation = Ship->Camera->GetComponentLocation();
+            Viewer.CameraForward = Ship->Camera->GetForwardVector();
+            // Widen a little so things entering from the screen edge are already at full rate
+            Viewer.CosHalfFOV = FMath::Cos(FMath::DegreesToRadians(FMath::Min(Ship->Camera->FieldOfView * 0.5f * 1.2f, 89.f)));
+        }
+        else
+        {
+            // No camera: treat the view as everything around the ship
+            Viewer.CameraLocation = Viewer.Location;
+            Viewer.CosHalfFOV = -1.f;
+        }
+    }
+}
+
+ESignificanceTier UTickSignificanceSubsystem::ScoreLocation(const FVector& Location) const
+{
+    // Without players (benchmarks, menus) everything is relevant
+    if (Viewers.Num() == 0) return ESignificanceTier::High;
+
+    ESignificanceTier Best = ESignificanceTier::Dormant;
+    for (const FViewer& Viewer : Viewers)
+    {
+        const float DistSq = FVector::DistSquared(Location, Viewer.Location);
+        if (DistSq <= NearDistance * NearDistance) return ESignificanceTier::High;
+
+        if (DistSq <= VisibleDistance * VisibleDistance)
+        {
+            const FVector ToActor = (Location - Viewer.CameraLocation).GetSafeNormal();
+            if (FVector::DotProduct(ToActor, Viewer.CameraForward) >= Viewer.CosHalfFOV) return ESignificanceTier::High;
+        }
+
+        ESignificanceTier Tier = ESignificanceTier::Dormant;
+        if (DistSq <= MidDistance * MidDistance) Tier = ESignificanceTier::Medium;
+        else if (DistSq <= FarDistance * FarDistance) Tier = ESignificanceTier::Low;
+
+        if (Tier < Best) Best = Tier;
+    }
+    return Best;
+}
+
+void UTickSignificanceSubsystem::UpdateSignificance()
+{
+    GatherViewers();
+
+    for (int32 i = Entries.Num() - 1; i >= 0; --i)
+    {
+        AActor* Actor = Entries[i].Actor.Get();
+        if (!Actor)
+        {
+            RemoveEntry(Entries[i].Key);
+            continue;
+        }
+
+        const ESignificanceTier NewTier = ScoreLocation(Actor->GetActorLocation());
+        FEntry& Entry = Entries[i];
+        if (NewTier == Entry.Tier) continue;
+
+        --TierCounts[(int32)Entry.Tier];
+        ++TierCounts[(int32)NewTier];
+        Entry.Tier = NewTier;
+        if (Entry.OnTierChanged)
+        {
+            Entry.OnTierChanged(NewTier);
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/JoyshipTestWorld.h"
+#include "Subsystems/AssetPreloadSubsystem.h"
+#include "Pawns/BaseShip.h"
+#include "Actors/Turret.h"
+#include "Actors/Collectable.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "GameFramework/DamageType.h"
+#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
+
+namespace
+{
+    // Every ship, turret and collectable class the project ships, Blueprints included: they hold the soft references
+    TArray<UClass*> LoadGameplayClasses()
+    {
+        const TArray<FTopLevelAssetPath> BaseClasses = {
+            ABaseShip::StaticClass()->GetClassPathName(),
+            ATurret::StaticClass()->GetClassPathName(),
+            ACollectable::StaticClass()->GetClassPathName() };
+
+        TSet<FTopLevelAssetPath> DerivedClasses;
+        UAssetManager::Get().GetAssetRegistry().GetDerivedClassNames(BaseClasses, TSet<FTopLevelAssetPath>(), DerivedClasses);
+
+        TArray<UClass*> Classes;
+        for (const FTopLevelAssetPath& ClassPath : DerivedClasses)
+        {
+            UClass* Class = LoadObject<UClass>(nullptr, *ClassPath.ToString());
+            if (Class && !Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+            {
+                Classes.Add(Class);
+            }
+        }
+        return Classes;
+    }
+
+    void SpawnRow(UWorld* World, const TArray<UClass*>& Classes, float Z, TArray<TWeakObjectPtr<AActor>>& OutActors)
+    {
+        FActorSpawnParameters Params;
+        Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        for (int32 i = 0; i < Classes.Num(); ++i)
+        {
+            OutActors.Add(World->SpawnActor<AActor>(Classes[i], FTransform(FVector(0.f, 600.f * i, Z)), Params));
+        }
+    }
+}
+
+// Play must never load a package synchronously: map actors' soft references are preloaded before BeginPlay and
+// everything later loads async (the benchmark's -FailOnSyncLoad checks the same counter on a full run)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJoyshipNoSyncLoadDuringPlayTest, "Joyship.Loading.NoSyncLoadDuringPlay",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FJoyshipNoSyncLoadDuringPlayTest::RunTest(const FString& Parameters)
+{
+    // Class loads happen before play, like the map's own imports
+    const TArray<UClass*> Classes = LoadGameplayClasses();
+    TestTrue(TEXT("Gameplay classes found"), Classes.Num() > 0);
+
+    TArray<TWeakObjectPtr<AActor>> Actors;
+    FJoyshipTestWorld TestWorld(TEXT("JoyshipAssetPreloadTest"), [&](UWorld* World)
+    {
+        SpawnRow(World, Classes, 0.f, Actors);
+    });
+    UWorld* World = TestWorld.Get();
+    UAssetPreloadSubsystem* Preloader = World->GetSubsystem<UAssetPreloadSubsystem>();
+    if (!TestNotNull(TEXT("Asset preload subsystem"), Preloader)) return false;
+
+    // Only loads made while the world ticks are counted, so play is driven from timers like gameplay code.
+    // Actors spawned during play (waves, streamed cells) take the async path.
+    FTimerManager& Timers = World->GetTimerManager();
+    Timers.SetTimerForNextTick([&]() { SpawnRow(World, Classes, 2000.f, Actors); });
+
+    // Fire, then kill everything so projectiles, impacts and death effects all resolve their references
+    for (int32 Frame = 0; Frame < 240; ++Frame)
+    {
+        if (Frame % 20 == 0)
+        {
+            Timers.SetTimerForNextTick([&]()
+            {
+                for (const TWeakObjectPtr<AActor>& Actor : Actors)
+                {
+                    if (ABaseShip* Ship = Cast<ABaseShip>(Actor.Get()))
+                    {
+                        Ship->Fire();
+                    }
+                }
+            });
+        }
+        if (Frame == 180)
+        {
+            Timers.SetTimerForNextTick([&]()
+            {
+                for (const TWeakObjectPtr<AActor>& Actor : Actors)
+                {
+                    if (Actor.IsValid())
+                    {
+                        UGameplayStatics::ApplyDamage(Actor.Get(), 1.e6f, nullptr, nullptr, UDamageType::StaticClass());
+                    }
+                }
+            });
+        }
+        TestWorld.Tick();
+    }
+
+    for (const FString& Package : Preloader->GetSyncLoadedPackages())
+    {
+        AddError(FString::Printf(TEXT("Synchronous load during play: %s"), *Package));
+    }
+    TestEqual(TEXT("Synchronous loads during play"), Preloader->GetNumSyncLoadsDuringPlay(), 0);
+    return true;
+}
+
+#endif
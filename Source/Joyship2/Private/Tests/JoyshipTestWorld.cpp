@@ -0,0 +1,27 @@
+#include "Tests/JoyshipTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "JoyshipHeadlessWorld.h"
+#include "Engine/World.h"
+
+FJoyshipTestWorld::FJoyshipTestWorld(const TCHAR* Name, TFunction<void(UWorld*)> PopulateBeforePlay)
+{
+    World = JoyshipHeadlessWorld::Create(FString(), Name, MoveTemp(PopulateBeforePlay));
+}
+
+FJoyshipTestWorld::~FJoyshipTestWorld()
+{
+    JoyshipHeadlessWorld::Destroy(World);
+}
+
+void FJoyshipTestWorld::Tick(int32 NumFrames, float DeltaSeconds)
+{
+    for (int32 i = 0; i < NumFrames; ++i)
+    {
+        ++GFrameCounter;
+        World->Tick(LEVELTICK_All, DeltaSeconds);
+    }
+}
+
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+class UWorld;
+
+// Game world for automation tests: created and begun play on construction, destroyed on scope exit.
+// A JoyshipHeadlessWorld, the same world the benchmark commandlets run in.
+class FJoyshipTestWorld
+{
+public:
+    // PopulateBeforePlay spawns actors that begin play with the world, as actors loaded with a map do
+    explicit FJoyshipTestWorld(const TCHAR* Name, TFunction<void(UWorld*)> PopulateBeforePlay = nullptr);
+    ~FJoyshipTestWorld();
+
+    FJoyshipTestWorld(const FJoyshipTestWorld&) = delete;
+    FJoyshipTestWorld& operator=(const FJoyshipTestWorld&) = delete;
+
+    UWorld* Get() const { return World; }
+
+    // Advance the world NumFrames times; also advances GFrameCounter so per-frame caches rebuild
+    void Tick(int32 NumFrames = 1, float DeltaSeconds = 1.f / 60.f);
+
+private:
+    UWorld* World = nullptr;
+};
+
+#endif
@@ -0,0 +1,232 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/JoyshipTestWorld.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+
+namespace
+{
+    // Queries closer than this to an actor's reach are skipped: physics and the grid may round them differently
+    constexpr float BoundarySlack = 1.f;
+
+    AActor* SpawnSphereActor(UWorld* World, const FVector& Location, float Radius)
+    {
+        AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+        USphereComponent* Sphere = NewObject<USphereComponent>(Actor);
+        Sphere->InitSphereRadius(Radius);
+        Sphere->SetCollisionObjectType(ECC_WorldDynamic);
+        Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+        Sphere->SetCollisionResponseToAllChannels(ECR_Overlap);
+        Actor->SetRootComponent(Sphere);
+        Actor->SetActorLocation(Location);
+        Sphere->RegisterComponent();
+        return Actor;
+    }
+
+    FVector RandomPlanePoint(FRandomStream& Rng, float Extent)
+    {
+        return FVector(0.f, Rng.FRandRange(-Extent, Extent), Rng.FRandRange(-Extent, Extent));
+    }
+
+    FVector RandomPlaneDirection(FRandomStream& Rng)
+    {
+        const float Angle = Rng.FRandRange(0.f, 2.f * PI);
+        return FVector(0.f, FMath::Cos(Angle), FMath::Sin(Angle));
+    }
+
+    // Distance from Point to the flat cone (circular sector) at Origin; 0 inside it
+    float DistToCone(const FVector& Point, const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees)
+    {
+        const FVector To = Point - Origin;
+        const float Dist = To.Size();
+        const float Angle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(To.GetSafeNormal(), Direction), -1.f, 1.f)));
+        if (Angle <= HalfAngleDegrees)
+        {
+            return FMath::Max(Dist - Range, 0.f);
+        }
+
+        // Outside the angle: nearest of the two edges (the arc's closest points are their ends)
+        const FVector EdgeA = Origin + Direction.RotateAngleAxis(HalfAngleDegrees, FVector::XAxisVector) * Range;
+        const FVector EdgeB = Origin + Direction.RotateAngleAxis(-HalfAngleDegrees, FVector::XAxisVector) * Range;
+        return FMath::Min(FMath::PointDistToSegment(Point, Origin, EdgeA), FMath::PointDistToSegment(Point, Origin, EdgeB));
+    }
+}
+
+// The grid must report the same actors as the physics queries it replaced (turret overlap, aggro overlap, aim-assist sweep)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJoyshipSpatialGridMatchesPhysicsTest, "Joyship.SpatialGrid.MatchesPhysicsQueries",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FJoyshipSpatialGridMatchesPhysicsTest::RunTest(const FString& Parameters)
+{
+    FJoyshipTestWorld TestWorld(TEXT("JoyshipSpatialGridTest"));
+    UWorld* World = TestWorld.Get();
+    USpatialGridSubsystem* Grid = World->GetSubsystem<USpatialGridSubsystem>();
+    if (!TestNotNull(TEXT("Spatial grid subsystem"), Grid)) return false;
+
+    // Small cells so queries span several of them and large actors straddle cell borders
+    Grid->SetCellSize(300.f);
+
+    FRandomStream Rng(4);
+    TArray<AActor*> Actors;
+    TMap<AActor*, float> Radii;
+    for (int32 i = 0; i < 80; ++i)
+    {
+        const float Radius = Rng.FRandRange(20.f, 150.f);
+        AActor* Actor = SpawnSphereActor(World, RandomPlanePoint(Rng, 2000.f), Radius);
+        Grid->Register(Actor, ESpatialGridFlags::Damageable, Radius);
+        Actors.Add(Actor);
+        Radii.Add(Actor, Radius);
+    }
+
+    const FCollisionObjectQueryParams ObjectParams(ECC_WorldDynamic);
+    int32 NumCompared = 0;
+
+    /* ---------------- RADIUS ---------------- */
+
+    for (int32 q = 0; q < 100; ++q)
+    {
+        const FVector Center = RandomPlanePoint(Rng, 2200.f);
+        const float Radius = Rng.FRandRange(50.f, 800.f);
+        AActor* Ignore = (q % 2) ? Actors[Rng.RandHelper(Actors.Num())] : nullptr;
+
+        bool bAmbiguous = false;
+        for (AActor* Actor : Actors)
+        {
+            const float Gap = FVector::Dist(Actor->GetActorLocation(), Center) - (Radius + Radii[Actor]);
+            bAmbiguous |= FMath::Abs(Gap) < BoundarySlack;
+        }
+        if (bAmbiguous) continue;
+
+        FCollisionQueryParams QueryParams;
+        QueryParams.AddIgnoredActor(Ignore);
+        TArray<FOverlapResult> Overlaps;
+        World->OverlapMultiByObjectType(Overlaps, Center, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Radius), QueryParams);
+
+        TSet<AActor*> Expected;
+        for (const FOverlapResult& Overlap : Overlaps)
+        {
+            if (Radii.Contains(Overlap.GetActor())) Expected.Add(Overlap.GetActor());
+        }
+
+        TArray<AActor*> Found;
+        Grid->QueryRadius(Center, Radius, ESpatialGridFlags::Damageable, Found, Ignore);
+
+        TestEqual(FString::Printf(TEXT("QueryRadius %d count"), q), Found.Num(), Expected.Num());
+        for (AActor* Actor : Found)
+        {
+            TestTrue(FString::Printf(TEXT("QueryRadius %d found %s"), q, *GetNameSafe(Actor)), Expected.Contains(Actor));
+        }
+        ++NumCompared;
+    }
+
+    /* ---------------- RAY ---------------- */
+
+    for (int32 q = 0; q < 100; ++q)
+    {
+        const FVector Origin = RandomPlanePoint(Rng, 2200.f);
+        const FVector Direction = RandomPlaneDirection(Rng);
+        const float Range = Rng.FRandRange(300.f, 3000.f);
+        const float Radius = Rng.FRandRange(0.f, 60.f);
+        const FVector End = Origin + Direction * Range;
+
+        bool bAmbiguous = false;
+        for (AActor* Actor : Actors)
+        {
+            const float Gap = FMath::PointDistToSegment(Actor->GetActorLocation(), Origin, End) - (Radius + Radii[Actor]);
+            bAmbiguous |= FMath::Abs(Gap) < BoundarySlack;
+        }
+        if (bAmbiguous) continue;
+
+        TArray<FHitResult> Hits;
+        World->SweepMultiByObjectType(Hits, Origin, End, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Radius));
+
+        TSet<AActor*> Expected;
+        for (const FHitResult& Hit : Hits)
+        {
+            if (Radii.Contains(Hit.GetActor())) Expected.Add(Hit.GetActor());
+        }
+
+        // The grid orders candidates by distance along the ray, not by time of impact, so only require a hit the sweep also reports
+        AActor* First = Grid->FindFirstAlongRay(Origin, Direction, Range, Radius, ESpatialGridFlags::Damageable);
+        TestEqual(FString::Printf(TEXT("FindFirstAlongRay %d hit"), q), First != nullptr, Expected.Num() > 0);
+        if (First)
+        {
+            TestTrue(FString::Printf(TEXT("FindFirstAlongRay %d found %s"), q, *GetNameSafe(First)), Expected.Contains(First));
+        }
+        ++NumCompared;
+    }
+
+    /* ---------------- CONE ---------------- */
+
+    // No physics query matches a flat cone, so compare against the exact distance from each actor's circle to the sector
+    for (int32 q = 0; q < 100; ++q)
+    {
+        const FVector Origin = RandomPlanePoint(Rng, 2200.f);
+        const FVector Direction = RandomPlaneDirection(Rng);
+        const float Range = Rng.FRandRange(300.f, 3000.f);
+        const float HalfAngle = Rng.FRandRange(5.f, 120.f);
+
+        TSet<AActor*> Expected;
+        bool bAmbiguous = false;
+        for (AActor* Actor : Actors)
+        {
+            const float Gap = DistToCone(Actor->GetActorLocation(), Origin, Direction, Range, HalfAngle) - Radii[Actor];
+            bAmbiguous |= FMath::Abs(Gap) < BoundarySlack;
+            if (Gap <= 0.f) Expected.Add(Actor);
+        }
+        if (bAmbiguous) continue;
+
+        TArray<AActor*> Found;
+        Grid->QueryCone(Origin, Direction, Range, HalfAngle, ESpatialGridFlags::Damageable, Found);
+
+        TestEqual(FString::Printf(TEXT("QueryCone %d count"), q), Found.Num(), Expected.Num());
+        for (AActor* Actor : Found)
+        {
+            TestTrue(FString::Printf(TEXT("QueryCone %d found %s"), q, *GetNameSafe(Actor)), Expected.Contains(Actor));
+        }
+        ++NumCompared;
+    }
+
+    // Boundary skips must not swallow the whole run
+    TestTrue(TEXT("Enough queries compared"), NumCompared >= 225);
+
+    /* ---------------- INCREMENTAL ---------------- */
+
+    // Registering and unregistering after this frame's build patches the built grid
+    const FVector Probe(0.f, 5000.f, 5000.f);
+    AActor* Late = SpawnSphereActor(World, Probe, 50.f);
+    Grid->Register(Late, ESpatialGridFlags::Damageable, 50.f);
+    {
+        TArray<AActor*> Found;
+        Grid->QueryRadius(Probe, 10.f, ESpatialGridFlags::Damageable, Found);
+        TestTrue(TEXT("Actor registered after the build is found by QueryRadius"), Found.Contains(Late));
+        TestTrue(TEXT("Actor registered after the build is found by FindFirstAlongRay"),
+            Grid->FindFirstAlongRay(Probe - FVector(0.f, 500.f, 0.f), FVector(0.f, 1.f, 0.f), 1000.f, 0.f, ESpatialGridFlags::Damageable) == Late);
+
+        Grid->Unregister(Late);
+        Found.Reset();
+        Grid->QueryRadius(Probe, 10.f, ESpatialGridFlags::Damageable, Found);
+        TestFalse(TEXT("Actor unregistered after the build is not reported"), Found.Contains(Late));
+    }
+    Late->Destroy();
+
+    /* ---------------- PRUNE ---------------- */
+
+    // An actor destroyed without unregistering drops out of queries
+    AActor* Destroyed = Actors[0];
+    const FVector DestroyedLocation = Destroyed->GetActorLocation();
+    Destroyed->Destroy();
+    TestWorld.Tick();
+
+    TArray<AActor*> Found;
+    Grid->QueryRadius(DestroyedLocation, 1.f, ESpatialGridFlags::All, Found);
+    TestFalse(TEXT("Destroyed actor is not reported"), Found.Contains(Destroyed));
+    TestEqual(TEXT("Destroyed actor is pruned"), Grid->GetNumEntries(), Actors.Num() - 1);
+
+    return true;
+}
+
+#endif
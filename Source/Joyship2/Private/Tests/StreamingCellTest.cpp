@@ -0,0 +1,227 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/JoyshipTestWorld.h"
+#include "Subsystems/StreamingCellSubsystem.h"
+#include "Actors/Turret.h"
+#include "Pawns/PlayerShip.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+
+namespace
+{
+    constexpr int32 NumCellActors = 3;
+
+    // Stand-in for a World Partition cell. A real cell needs a saved partitioned map, so the test drives the same
+    // engine calls streaming makes: the level delegates, actors reloaded under their saved names and flagged as
+    // loaded from the map, and EndPlay(RemovedFromWorld) when the cell goes.
+    struct FTestCell
+    {
+        UWorld* World = nullptr;
+        ULevel* Level = nullptr;
+        // Saved actor names are Name_0, Name_1, ...; actors are placed 1000 uu apart along Y from Origin
+        FString Name;
+        FVector Origin = FVector::ZeroVector;
+        TArray<TWeakObjectPtr<ATurret>> Actors;
+
+        bool IsLoaded() const { return Actors.Num() > 0; }
+
+        void StreamIn()
+        {
+            FWorldDelegates::LevelAddedToWorld.Broadcast(Level, World);
+
+            Actors.Reset();
+            for (int32 i = 0; i < NumCellActors; ++i)
+            {
+                const FTransform Transform(Origin + FVector(0.f, 1000.f * i, 0.f));
+                FActorSpawnParameters Params;
+                Params.Name = FName(*FString::Printf(TEXT("%s_%d"), *Name, i));
+                Params.bDeferConstruction = true;
+                Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+                ATurret* Turret = World->SpawnActor<ATurret>(ATurret::StaticClass(), Transform, Params);
+                Turret->bNetStartup = true;
+                Turret->FinishSpawning(Transform);
+                Actors.Add(Turret);
+            }
+        }
+
+        void StreamOut()
+        {
+            for (const TWeakObjectPtr<ATurret>& Actor : Actors)
+            {
+                if (Actor.IsValid() && !Actor->IsActorBeingDestroyed())
+                {
+                    Actor->RouteEndPlay(EEndPlayReason::RemovedFromWorld);
+                    Actor->Destroy();
+                }
+            }
+            FWorldDelegates::LevelRemovedFromWorld.Broadcast(Level, World);
+            Actors.Reset();
+
+            // Free the names so the reload gets the same paths
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+
+        static bool IsLive(const TWeakObjectPtr<ATurret>& Actor)
+        {
+            return Actor.IsValid() && !Actor->IsActorBeingDestroyed() && Actor->HasActorBegunPlay();
+        }
+    };
+}
+
+// A placed actor consumed before its cell streams out must not come back with the cell, and the counters must follow
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJoyshipStreamingCellConsumedTest, "Joyship.Streaming.ConsumedPlacementsStayGone",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FJoyshipStreamingCellConsumedTest::RunTest(const FString& Parameters)
+{
+    FJoyshipTestWorld TestWorld(TEXT("JoyshipStreamingCellTest"));
+    UWorld* World = TestWorld.Get();
+    UStreamingCellSubsystem* Cells = World->GetSubsystem<UStreamingCellSubsystem>();
+    if (!TestNotNull(TEXT("Streaming cell subsystem"), Cells)) return false;
+
+    FTestCell Cell;
+    Cell.World = World;
+    Cell.Level = NewObject<ULevel>(World, TEXT("JoyshipTestCell"));
+    Cell.Name = TEXT("JoyshipTestTurret");
+
+    /* ---------------- FIRST LOAD ---------------- */
+
+    Cell.StreamIn();
+    FStreamingCellStats Stats = Cells->GetStats();
+    TestEqual(TEXT("Loaded cells after first load"), Stats.LoadedCells, 1);
+    TestEqual(TEXT("Live actors after first load"), Stats.LiveActors, 3);
+    TestEqual(TEXT("Peak actors after first load"), Stats.PeakActors, 3);
+
+    // Destroy one placement for good
+    Cell.Actors[0]->Destroy();
+    Stats = Cells->GetStats();
+    TestEqual(TEXT("Live actors after consuming one"), Stats.LiveActors, 2);
+    TestEqual(TEXT("Consumed"), Stats.Consumed, 1);
+
+    /* ---------------- STREAM OUT ---------------- */
+
+    Cell.StreamOut();
+    Stats = Cells->GetStats();
+    TestEqual(TEXT("Loaded cells after stream out"), Stats.LoadedCells, 0);
+    TestEqual(TEXT("Live actors after stream out"), Stats.LiveActors, 0);
+    TestEqual(TEXT("Streamed out"), Stats.StreamedOut, 2);
+    TestEqual(TEXT("Consumed is not counted as streamed out"), Stats.Consumed, 1);
+    TestEqual(TEXT("Peak cells kept after stream out"), Stats.PeakLoadedCells, 1);
+    TestEqual(TEXT("Peak actors kept after stream out"), Stats.PeakActors, 3);
+
+    /* ---------------- RELOAD ---------------- */
+
+    Cell.StreamIn();
+    TestFalse(TEXT("Consumed placement discarded on reload"), FTestCell::IsLive(Cell.Actors[0]));
+    TestTrue(TEXT("Other placements reload"), FTestCell::IsLive(Cell.Actors[1]) && FTestCell::IsLive(Cell.Actors[2]));
+
+    Stats = Cells->GetStats();
+    TestEqual(TEXT("Loaded cells after reload"), Stats.LoadedCells, 1);
+    TestEqual(TEXT("Discarded placement never begins play"), Stats.LiveActors, 2);
+    TestEqual(TEXT("Discarding is not a second consumption"), Stats.Consumed, 1);
+    TestEqual(TEXT("Peak cells after reload"), Stats.PeakLoadedCells, 1);
+    TestEqual(TEXT("Peak actors after reload"), Stats.PeakActors, 3);
+
+    Cells->ResetPeaks();
+    Stats = Cells->GetStats();
+    TestEqual(TEXT("Peak actors after reset"), Stats.PeakActors, 2);
+    TestEqual(TEXT("Peak cells after reset"), Stats.PeakLoadedCells, 1);
+
+    Cell.StreamOut();
+    return true;
+}
+
+// Scripted flight along a row of cells, loaded and unloaded around the ship the way World Partition's loading range
+// does (12800 uu cells, 25600 uu range; see UStreamingCellSubsystem). Reports peak actors, peak cells and memory.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJoyshipStreamingFlightTest, "Joyship.Streaming.ScriptedFlight",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FJoyshipStreamingFlightTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumCells = 10;
+    constexpr float CellSize = 12800.f;
+    constexpr float LoadingRange = 25600.f;
+    constexpr float FlightSpeed = 8000.f;
+    constexpr float DeltaTime = 1.f / 30.f;
+
+    FJoyshipTestWorld TestWorld(TEXT("JoyshipStreamingFlightTest"));
+    UWorld* World = TestWorld.Get();
+    UStreamingCellSubsystem* Cells = World->GetSubsystem<UStreamingCellSubsystem>();
+    if (!TestNotNull(TEXT("Streaming cell subsystem"), Cells)) return false;
+
+    TArray<FTestCell> Row;
+    Row.SetNum(NumCells);
+    for (int32 c = 0; c < NumCells; ++c)
+    {
+        Row[c].World = World;
+        Row[c].Level = NewObject<ULevel>(World, *FString::Printf(TEXT("JoyshipFlightCell_%d"), c));
+        Row[c].Name = FString::Printf(TEXT("JoyshipFlightTurret_%d"), c);
+        Row[c].Origin = FVector(0.f, c * CellSize + 2000.f, 0.f);
+    }
+
+    // The ship is flown by script, so the turrets in loaded cells have a pawn to find
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    APlayerShip* Ship = World->SpawnActor<APlayerShip>(APlayerShip::StaticClass(), FTransform::Identity, SpawnParams);
+    if (!TestNotNull(TEXT("Player ship"), Ship)) return false;
+    Ship->SetActorTickEnabled(false);
+
+    const uint64 MemStart = FPlatformMemory::GetStats().UsedPhysical;
+    uint64 MemPeak = MemStart;
+    int32 ExpectedPeakCells = 0;
+    TBitArray<> EverLoaded(false, NumCells);
+
+    // From before the first cell to past the last, so every cell streams in and back out
+    const float StartY = -LoadingRange - CellSize;
+    const float EndY = NumCells * CellSize + LoadingRange + CellSize;
+    const int32 NumFrames = FMath::CeilToInt((EndY - StartY) / (FlightSpeed * DeltaTime));
+    for (int32 Frame = 0; Frame <= NumFrames; ++Frame)
+    {
+        const float ShipY = FMath::Min(StartY + Frame * FlightSpeed * DeltaTime, EndY);
+        Ship->SetActorLocation(FVector(0.f, ShipY, 0.f));
+
+        // A cell is wanted while its nearest edge is within the loading range
+        int32 NumLoaded = 0;
+        for (int32 c = 0; c < NumCells; ++c)
+        {
+            const float CellMin = c * CellSize;
+            const float Gap = FMath::Max3(CellMin - ShipY, ShipY - (CellMin + CellSize), 0.f);
+            const bool bWanted = Gap <= LoadingRange;
+            if (bWanted && !Row[c].IsLoaded())
+            {
+                Row[c].StreamIn();
+                EverLoaded[c] = true;
+            }
+            else if (!bWanted && Row[c].IsLoaded())
+            {
+                Row[c].StreamOut();
+            }
+            NumLoaded += Row[c].IsLoaded() ? 1 : 0;
+        }
+        ExpectedPeakCells = FMath::Max(ExpectedPeakCells, NumLoaded);
+
+        TestWorld.Tick(1, DeltaTime);
+        MemPeak = FMath::Max<uint64>(MemPeak, FPlatformMemory::GetStats().UsedPhysical);
+    }
+
+    const FStreamingCellStats Stats = Cells->GetStats();
+    AddInfo(FString::Printf(TEXT("Flight: %d cells, %d frames. PeakLoadedCells %d, PeakActors %d, StreamedOut %d. UsedPhysical peak %.1f MB (+%.1f MB over start)"),
+        NumCells, NumFrames + 1, Stats.PeakLoadedCells, Stats.PeakActors, Stats.StreamedOut,
+        MemPeak / (1024.0 * 1024.0), (MemPeak - MemStart) / (1024.0 * 1024.0)));
+
+    TestEqual(TEXT("Every cell streamed in"), EverLoaded.CountSetBits(), NumCells);
+    TestEqual(TEXT("Peak cells match the loading range"), Stats.PeakLoadedCells, ExpectedPeakCells);
+    TestTrue(TEXT("Loading range keeps only a window of cells"), ExpectedPeakCells < NumCells);
+    TestEqual(TEXT("Peak actors are the peak cells' actors"), Stats.PeakActors, ExpectedPeakCells * NumCellActors);
+    TestEqual(TEXT("No cells left loaded"), Stats.LoadedCells, 0);
+    TestEqual(TEXT("No cell actors left live"), Stats.LiveActors, 0);
+    TestEqual(TEXT("Every cell actor streamed out"), Stats.StreamedOut, NumCells * NumCellActors);
+    TestEqual(TEXT("Nothing consumed"), Stats.Consumed, 0);
+
+    return true;
+}
+
+#endif
@@ -1,8 +1,13 @@
 #include "Weapons/Projectile.h"
+#include "Joyship2.h"
+#include "JoyshipProfiling.h"
 #include "Components/SphereComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "GameFramework/DamageType.h"
 #include "Kismet/GameplayStatics.h"
+#include "Subsystems/DamageSubsystem.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "TimerManager.h"
 
 AProjectile::AProjectile()
 {
@@ -23,40 +28,184 @@ AProjectile::AProjectile()
     ProjectileMovement->bRotationFollowsVelocity = true;
     ProjectileMovement->bShouldBounce = false;
 
-    InitialLifeSpan = 5.f;
+    // Lifetime is driven by LifeTimer so pooled projectiles are recycled instead of destroyed
+    InitialLifeSpan = 0.f;
+}
+
+void AProjectile::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    // Cache before the pool disables collision (pooled projectiles may be deactivated before BeginPlay)
+    if (CollisionComp)
+    {
+        DefaultCollisionEnabled = CollisionComp->GetCollisionEnabled();
+    }
 }
 
 void AProjectile::BeginPlay()
 {
     Super::BeginPlay();
-    SetLifeSpan(LifeTime);
+
+    // Pooled projectiles are activated (and arm the timer) when the pool hands them out
+    if (!bPooled)
+    {
+        SetProjectileActive(true);
+        if (LifeTime > 0.f)
+        {
+            GetWorldTimerManager().SetTimer(LifeTimer, this, &AProjectile::ReleaseProjectile, LifeTime, false);
+        }
+    }
+}
+
+void AProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    SetProjectileActive(false);
+    Super::EndPlay(EndPlayReason);
+}
+
+void AProjectile::SetProjectileActive(bool bNewActive)
+{
+    if (bActive == bNewActive) return;
+    bActive = bNewActive;
+    JoyshipProfiling::AdjustCounter(JoyshipProfiling::ECounter::LiveProjectiles, bActive ? 1 : -1);
+
+    if (bActive)
+    {
+        UDamageSubsystem* DamageSys = GetWorld() ? GetWorld()->GetSubsystem<UDamageSubsystem>() : nullptr;
+        ShotId = DamageSys ? DamageSys->NextShotId() : ShotId + 1;
+    }
+
+    if (!InstancedMesh) return;
+    UInstancedMeshSubsystem* Instanced = GetWorld() ? GetWorld()->GetSubsystem<UInstancedMeshSubsystem>() : nullptr;
+    if (!Instanced) return;
+
+    if (bActive)
+    {
+        MeshHandle = Instanced->AddInstance(InstancedMesh, InstancedMeshTransform * GetActorTransform());
+        Instanced->TrackActor(this, MeshHandle, InstancedMeshTransform);
+    }
+    else if (MeshHandle.IsValid())
+    {
+        Instanced->UntrackActor(this);
+        Instanced->RemoveInstance(MeshHandle);
+    }
+}
+
+void AProjectile::ActivateProjectile(const FVector& Location, const FRotator& Rotation, const FVector& Direction)
+{
+    SetProjectileActive(true);
+
+    SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+    SetActorHiddenInGame(false);
+
+    if (CollisionComp)
+    {
+        CollisionComp->SetCollisionEnabled(DefaultCollisionEnabled);
+    }
+
+    if (ProjectileMovement)
+    {
+        ProjectileMovement->SetUpdatedComponent(CollisionComp);
+        ProjectileMovement->Activate(true);
+        ProjectileMovement->Velocity = Direction * ProjectileMovement->InitialSpeed;
+        ProjectileMovement->UpdateComponentVelocity();
+    }
+
+    if (LifeTime > 0.f)
+    {
+        GetWorldTimerManager().SetTimer(LifeTimer, this, &AProjectile::ReleaseProjectile, LifeTime, false);
+    }
+}
+
+void AProjectile::DeactivateProjectile()
+{
+    SetProjectileActive(false);
+
+    GetWorldTimerManager().ClearTimer(LifeTimer);
+
+    if (ProjectileMovement)
+    {
+        ProjectileMovement->StopMovementImmediately();
+        ProjectileMovement->Deactivate();
+    }
+
+    if (CollisionComp)
+    {
+        CollisionComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+
+    SetActorHiddenInGame(true);
+    SetOwner(nullptr);
+    SetInstigator(nullptr);
+}
+
+void AProjectile::ReleaseProjectile()
+{
+    if (!bActive) return;
+
+    if (bPooled)
+    {
+        UWorld* World = GetWorld();
+        UProjectilePoolSubsystem* Pool = World ? World->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+        if (Pool)
+        {
+            Pool->Release(this);
+            return;
+        }
+    }
+
+    SetProjectileActive(false);
+    Destroy();
+}
+
+void AProjectile::DealDamage(AActor* OtherActor)
+{
+    UDamageSubsystem* DamageSys = GetWorld() ? GetWorld()->GetSubsystem<UDamageSubsystem>() : nullptr;
+    if (DamageSys)
+    {
+        // Hit and overlap for the same shot collapse into one event
+        DamageSys->QueueDamage(OtherActor, Damage, this, ShotId, GetInstigatorController());
+    }
+    else
+    {
+        UGameplayStatics::ApplyDamage(OtherActor, Damage, GetInstigatorController(), this, UDamageType::StaticClass());
+    }
 }
 
 void AProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
+    JOYSHIP_TIMING_SCOPE(ProjectileHit);
+
+    if (!bActive) return;
+
     if (OtherActor && OtherActor != this && OtherComp)
     {
         if (ProjectileMovement) ProjectileMovement->StopMovementImmediately();
 
-        UGameplayStatics::ApplyDamage(OtherActor, Damage, GetInstigatorController(), this, UDamageType::StaticClass());
+        DealDamage(OtherActor);
     }
 
-    Destroy();
+    ReleaseProjectile();
 }
 
 void AProjectile::OnOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[Projectile] OnOverlap called Other=%s Comp=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"), OtherComp ? *OtherComp->GetName() : TEXT("None"));
+    JOYSHIP_TIMING_SCOPE(ProjectileHit);
+
+    if (!bActive) return;
+
+    UE_LOG(LogJoyshipCombat, VeryVerbose, TEXT("[Projectile] OnOverlap called Other=%s Comp=%s"), OtherActor ? *OtherActor->GetName() : TEXT("None"), OtherComp ? *OtherComp->GetName() : TEXT("None"));
     if (OtherActor && OtherActor != this && OtherComp)
     {
         if (OtherComp->GetCollisionEnabled() == ECollisionEnabled::QueryOnly)
         {
-            UE_LOG(LogTemp, Verbose, TEXT("[Projectile] Overlap ignored: OtherComp is QueryOnly"));
+            UE_LOG(LogJoyshipCombat, VeryVerbose, TEXT("[Projectile] Overlap ignored: OtherComp is QueryOnly"));
             return;
         }
 
         if (ProjectileMovement) ProjectileMovement->StopMovementImmediately();
-        UGameplayStatics::ApplyDamage(OtherActor, Damage, GetInstigatorController(), this, UDamageType::StaticClass());
-        Destroy();
+        DealDamage(OtherActor);
+        ReleaseProjectile();
     }
 }
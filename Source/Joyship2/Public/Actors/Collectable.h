@@ -2,30 +2,63 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Subsystems/InstancedMeshSubsystem.h"
 #include "Collectable.generated.h"
 
 class USphereComponent;
 class UStaticMeshComponent;
 class APlayerShip;
 
+// Where a collectable is in its pooled lifecycle
+UENUM(BlueprintType)
+enum class ECollectableState : uint8
+{
+    Active,     // placed and collectable
+    Pooled,     // collected, in UCollectableSubsystem's free list
+    Respawning  // collected, waiting out RespawnDelay
+};
+
+// Pickup. Magnet pull, range collection and the fail-safe are run for all collectables by UCollectableSubsystem;
+// the actor itself never ticks. Collecting deactivates the actor and hands it back to the subsystem, which either
+// respawns it in place after RespawnDelay or keeps it for the next SpawnCollectable of the same class.
 UCLASS()
 class JOYSHIP2_API ACollectable : public AActor
 {
     GENERATED_BODY()
 
+    // Reads the magnet settings and bCollected; drives the pooled lifecycle
+    friend class UCollectableSubsystem;
+
 public:
     ACollectable();
 
 protected:
+    virtual void PostInitializeComponents() override;
     virtual void BeginPlay() override;
-    virtual void Tick(float DeltaTime) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-    // Visual mesh (set in Blueprint)
+public:
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+protected:
     // Visual mesh (set in Blueprint)
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Collectable")
     UStaticMeshComponent* MeshComp;
 
+    // Draw MeshComp's mesh through UInstancedMeshSubsystem instead of a per-actor proxy.
+    // Ignored (falls back to MeshComp) when MeshComp has material overrides, since instances share the mesh's materials.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collectable|Rendering")
+    bool bRenderInstanced = true;
+
+    // Instance handle while drawn instanced
+    FInstancedMeshHandle MeshHandle;
+
+    // Hand the visual over to the instanced mesh subsystem (BeginPlay)
+    void RegisterInstancedMesh();
+
+    // Remove our instance (collect/EndPlay)
+    void ReleaseInstancedMesh();
+
     // Magnet radius: when player is within this distance the collectable will move toward the player
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collectable")
     float MagnetRadius = 600.f;
@@ -43,32 +76,62 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collectable")
     bool bAllowRangeCollect = false;
 
-    // Internal flag to avoid double-collect
+    // Set while collected (inactive). Replicated so clients hide and restore pooled collectables.
+    UPROPERTY(ReplicatedUsing = OnRep_Collected)
     bool bCollected = false;
 
-    // Cached player pawn while magnet is active
+    // Location of the current placement, sent with reactivation so clients put the pickup back before showing it
+    UPROPERTY(Replicated)
+    FVector_NetQuantize ActiveLocation;
+
+    UFUNCTION()
+    void OnRep_Collected();
+
+    // Return to UCollectableSubsystem's pool on collect instead of being destroyed
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collectable|Pooling")
+    bool bReturnToPoolOnCollect = true;
+
+    // Seconds after collection before this placement reappears where it was (0: stays collected, and the actor
+    // waits in the class's free list for SpawnCollectable)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collectable|Pooling")
+    float RespawnDelay = 0.f;
+
+    UPROPERTY(VisibleInstanceOnly, Category = "Collectable|Pooling")
+    ECollectableState PoolState = ECollectableState::Active;
+
+    // Where the placement respawns (BeginPlay, or the SpawnCollectable that reused this actor)
+    FTransform HomeTransform;
+
+    // Hide, disable collision and drop the instance/magnet/grid entry (server; clients via OnRep_Collected)
+    void DeactivateCollectable();
+
+    // Move to Transform and become collectable again
+    void ActivateCollectable(const FTransform& Transform);
+
+    // Visibility, collision and instanced mesh for the active/collected state (server and clients)
+    void ApplyCollectedState();
+
+    // Cached player pawn while magnet is active. Replicated so clients pull the pickup themselves; the collectable
+    // is net-dormant while this is null.
+    UPROPERTY(ReplicatedUsing = OnRep_CachedPlayer)
     APawn* CachedPlayer = nullptr;
 
-    // Tick gating to reduce frequency of attraction calculations
-    float TickAccumulator = 0.f;
+    UFUNCTION()
+    void OnRep_CachedPlayer();
 
-    // How often (seconds) to run attraction logic while active (default 20 Hz)
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collectable")
-    float TickInterval = 0.05f;
+    // Hand the pair to UCollectableSubsystem and move the instance with the actor while CachedPlayer is set
+    void StartAttraction();
+    void StopAttraction();
 
-    // Fail-safe: automatically attempt collection after this delay (seconds) when magnet is activated
+    // Fail-safe: automatically attempt collection after this delay (seconds) when magnet is activated (0 disables)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collectable")
     float MagnetFailSafeDelay = 0.5f;
 
-    // Internal timer handle for fail-safe
-    FTimerHandle MagnetFailSafeTimer;
-
-    // Attempt a collection when the fail-safe fires
-    void AttemptFailSafeCollect();
-
     // Note: collision components are expected to be added in Blueprint. Call ActivateMagnet/DeactivateMagnet and Collect from BP overlap events.
 
 public:
+    // Magnet and collection calls only act on the server (or standalone); clients follow the replicated state.
+
     // Collect the item (can be called from C++ or Blueprints). Collector may be null.
     UFUNCTION(BlueprintCallable, Category = "Collectable")
     void Collect(APlayerShip* Collector);
@@ -77,6 +140,10 @@ public:
     UFUNCTION(BlueprintImplementableEvent, Category = "Collectable")
     void OnCollected(APlayerShip* Collector);
 
+    // True while collected and waiting in the pool or for its respawn
+    UFUNCTION(BlueprintPure, Category = "Collectable")
+    bool IsCollected() const { return bCollected; }
+
     // Activate magnet attraction toward the given pawn (call from Blueprint when your trigger begins overlap)
     UFUNCTION(BlueprintCallable, Category = "Collectable")
     void ActivateMagnet(APawn* Pawn);
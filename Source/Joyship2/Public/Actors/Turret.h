@@ -2,8 +2,20 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Subsystems/TickSignificanceSubsystem.h"
 #include "Turret.generated.h"
 
+// Turret behaviour. Idle sleeps (no Tick); Tracking and Locked tick to turn the aim mesh;
+// Firing is entered briefly by the fire timer for each shot.
+UENUM(BlueprintType)
+enum class ETurretState : uint8
+{
+    Idle,       // no target
+    Tracking,   // turning toward the target; lock timer runs while aimed within tolerance
+    Locked,     // aimed long enough; fire timer runs
+    Firing      // releasing a shot (returns to Locked)
+};
+
 class UBoxComponent;
 class UStaticMeshComponent;
 class USceneComponent;
@@ -17,10 +29,14 @@ public:
     ATurret();
 
 protected:
+    virtual void PostInitializeComponents() override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
 public:
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
     // Trigger box
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Turret")
     UBoxComponent* Trigger;
@@ -33,9 +49,17 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Turret")
     USceneComponent* Muzzle;
 
-    // Projectile to fire
+    // Projectile to fire. Soft: loaded by UAssetPreloadSubsystem; the turret holds fire until it has arrived.
+    UPROPERTY(EditAnywhere, Category = "Turret")
+    TSoftClassPtr<AActor> ProjectileClass;
+
+    // Number of projectiles of ProjectileClass to keep ready in the world pool
     UPROPERTY(EditAnywhere, Category = "Turret")
-    TSubclassOf<AActor> ProjectileClass;
+    int32 ProjectilePoolPrewarm = 4;
+
+    // Fire through USimulatedProjectileSubsystem (no actor per shot) using ProjectileClass's defaults
+    UPROPERTY(EditAnywhere, Category = "Turret")
+    bool bUseSimulatedProjectiles = false;
 
     // Turn speed degrees/sec
     UPROPERTY(EditAnywhere, Category = "Turret")
@@ -53,15 +77,62 @@ public:
     UPROPERTY(EditAnywhere, Category = "Turret")
     float AimToleranceDegrees = 5.f;
 
+    // Find targets by polling the spatial grid instead of Trigger overlap events
+    UPROPERTY(EditAnywhere, Category = "Turret|Targeting")
+    bool bUseSpatialTargeting = true;
+
+    // How often (seconds) the spatial grid is polled for a pawn inside Trigger
+    UPROPERTY(EditAnywhere, Category = "Turret|Targeting")
+    float TargetScanInterval = 0.2f;
+
+    UFUNCTION(BlueprintPure, Category = "Turret")
+    ETurretState GetTurretState() const { return State; }
+
 protected:
-    // Current target pawn
+    // Current target pawn. Replicated so clients can turn the aim mesh; the turret is net-dormant while this is null.
+    UPROPERTY(ReplicatedUsing = OnRep_TargetPawn)
     APawn* TargetPawn = nullptr;
 
-    // Accumulated time looking at target
-    float LookAccum = 0.f;
+    UFUNCTION()
+    void OnRep_TargetPawn();
+
+    UPROPERTY(VisibleInstanceOnly, Category = "Turret")
+    ETurretState State = ETurretState::Idle;
+
+    // cos(AimToleranceDegrees), so the aim test is a dot product compare
+    float CosAimTolerance = 1.f;
+
+    // One-shot: LookTimeRequired spent on target -> Locked
+    FTimerHandle LockTimer;
+
+    // Looping every FireInterval while Locked
+    FTimerHandle FireTimer;
+
+    void SetState(ETurretState NewState);
+    void OnLockAcquired();
+    void OnFireTimer();
+    void FireProjectile();
+
+    // Top up the world pool with ProjectilePoolPrewarm projectiles of the loaded ProjectileClass
+    void PrewarmProjectilePool();
+
+    // Looping timer driving ScanForTarget when bUseSpatialTargeting is set
+    FTimerHandle TargetScanTimer;
+
+    // Pick a pawn inside Trigger from the spatial grid (keeps the current target while it stays inside)
+    void ScanForTarget();
+
+    // Last tier from UTickSignificanceSubsystem
+    ESignificanceTier SignificanceTier = ESignificanceTier::High;
+
+    // Change target and wake/sleep Tick and replication accordingly
+    void SetTarget(APawn* NewTarget);
+
+    // Tick only while Tracking or Locked, at the rate of SignificanceTier
+    void RefreshTickState();
 
-    // Fire accumulator
-    float FireAccum = 0.f;
+    // Slow target scans down for Low/Dormant turrets
+    void RefreshScanRate();
 
     UFUNCTION()
     void OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult);
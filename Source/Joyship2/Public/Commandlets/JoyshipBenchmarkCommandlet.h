@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "JoyshipBenchmarkCommandlet.generated.h"
+
+class UWorld;
+class AEnemyShip;
+class FJsonObject;
+
+// Headless gameplay benchmark. Builds a test world (or loads -Map=), spawns enemies, turrets and collectables,
+// keeps enemies firing, ticks a fixed number of frames at a fixed DeltaTime and writes per-hot-path tick time,
+// spawn counts and memory to JSON and CSV. Runs without a GPU:
+//
+//   UnrealEditor-Cmd Joyship2.uproject -run=JoyshipBenchmark -nullrhi -nosound -unattended
+//       [-Enemies=200] [-Turrets=50] [-Collectables=300] [-Frames=1800] [-WarmupFrames=60] [-DeltaTime=0.0166667]
+//       [-FireInterval=0.25] [-GCInterval=600] [-Seed=1] [-Map=/Game/Maps/SandBox]
+//       [-EnemyClass=...] [-TurretClass=...] [-CollectableClass=...] [-ProjectileClass=...]
+//       [-Output=<path without extension>] [-Replay=<recording>] [-FailOnSyncLoad]
+//
+// -Replay= drives the player from a session written by APlayerShip::StopInputRecording: the player starts at the
+// recorded state, the timed run lasts one frame per recorded frame and each frame uses its recorded DeltaTime.
+//
+// With a World Partition -Map= the player ship is the streaming source, so a replay flies a scripted path through the
+// level's cells; Streaming.* report peak gameplay actors and loaded cells, Memory.RunPeakUsedPhysicalMB the peak
+// memory sampled during the run.
+//
+// Loading.SyncLoadsDuringPlay counts synchronous package loads after BeginPlay (UAssetPreloadSubsystem);
+// -FailOnSyncLoad lists them and exits non-zero when there are any (a convenience for benchmark runs; the
+// Joyship.Loading.NoSyncLoadDuringPlay automation test is the check).
+//
+// -SpawnCost [-Spawns=500] [-WarmupSpawns=10] times AEnemyShip spawns alone instead: with every spawn also running the
+// baseline's BeginPlay physics work (Fixup) and without it (Fast), two fresh-world rounds each in ABBA order,
+// and reports SpawnCost.{Fixup,Fast}.{MsTotal,MsAvg,MsWorst} and SpawnCost.Speedup.
+UCLASS()
+class JOYSHIP2_API UJoyshipBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UJoyshipBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+protected:
+    // Class loaded from Params' Name= (a path), or Default when absent or not a BaseClass
+    static UClass* ParseClassParam(const FString& Params, const TCHAR* Name, UClass* BaseClass, UClass* Default);
+
+    template<typename T>
+    static TSubclassOf<T> ParseClassParam(const FString& Params, const TCHAR* Name, TSubclassOf<T> Default)
+    {
+        return ParseClassParam(Params, Name, T::StaticClass(), *Default);
+    }
+
+    // Random point on the ZY play plane between MinRadius and MaxRadius from the origin
+    static FVector RandomPlanePoint(FRandomStream& Rng, float MinRadius, float MaxRadius);
+
+    // Save Metrics into Root as JSON, plus a Metric,Value CSV, at OutputBase.{json,csv}
+    static bool WriteResults(const FString& OutputBase, const TSharedRef<FJsonObject>& Root, const TArray<TPair<FString, double>>& Metrics);
+
+    // -SpawnCost mode
+    int32 RunSpawnCost(const FString& Params, const FString& MapPath, TSubclassOf<AEnemyShip> EnemyClass, TSubclassOf<AActor> ProjectileClass, const FString& OutputBase);
+};
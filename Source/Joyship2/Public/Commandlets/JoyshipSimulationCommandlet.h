@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/JoyshipBenchmarkCommandlet.h"
+#include "JoyshipSimulationCommandlet.generated.h"
+
+class APlayerShip;
+class UHealthComponent;
+
+// Result of one simulated session (one world, one bot-flown player)
+struct FJoyshipSimulationSession
+{
+    int32 Index = 0;
+    int32 Seed = 0;
+    float SimSeconds = 0.f;
+    bool bPlayerDied = false;
+    float TimeToDeath = 0.f;
+    float FuelConsumed = 0.f;
+    int32 PlayerShots = 0;
+    int32 TotalShots = 0;
+    int32 Kills = 0;
+    int32 Pickups = 0;
+    double WallSeconds = 0.0;
+
+    static const TCHAR* CsvHeader();
+    FString ToCsvRow() const;
+    bool FromCsvRow(const FString& Row);
+};
+
+// Headless balancing runner. Each session loads SandBox (or -Map=) into a fresh world, adds a bot-flown player plus
+// optional extra enemies, turrets and collectables, and steps the world at a fixed DeltaTime as fast as the CPU allows
+// until the player dies or -MaxSeconds= of game time pass. Sessions are independent; -Workers=N runs them in N child
+// processes (one game thread each) and the parent merges the results. Writes per-session rows (CSV) and aggregates
+// (JSON: fuel consumed, shots, kills, pickups, death rate, time-to-death):
+//
+//   UnrealEditor-Cmd Joyship2.uproject -run=JoyshipSimulation -nullrhi -nosound -unattended
+//       [-Sessions=8] [-Workers=1] [-Seed=1] [-MaxSeconds=300] [-DeltaTime=0.0166667] [-Map=/Game/Maps/SandBox]
+//       [-Enemies=20] [-Turrets=10] [-Collectables=40] [-SpawnRadius=6000]
+//       [-PlayerClass=...] [-EnemyClass=...] [-TurretClass=...] [-CollectableClass=...] [-ProjectileClass=...]
+//       [-FuelConsumptionRate=] [-MaxFuel=] [-TurretFireInterval=] [-TurretLookTime=]
+//       [-BotFireInterval=0.3] [-BotRefuelFraction=0.4] [-Output=<path without extension>]
+UCLASS()
+class JOYSHIP2_API UJoyshipSimulationCommandlet : public UJoyshipBenchmarkCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    virtual int32 Main(const FString& Params) override;
+
+protected:
+    // Run one session in its own world
+    FJoyshipSimulationSession RunSession(const FString& Params, int32 SessionIndex, int32 Seed);
+
+    // Launch -Workers child processes and wait for them; returns false if any failed
+    bool RunWorkers(const FString& Params, int32 NumWorkers, const FString& OutputBase);
+
+    // Bind HandleDeath to Actor's UHealthComponent, if it has one
+    void BindDeath(AActor* Actor);
+
+    // Any UHealthComponent's OnDeath during a session
+    UFUNCTION()
+    void HandleDeath(UHealthComponent* HealthComp);
+
+    // Session being run
+    FJoyshipSimulationSession* CurrentSession = nullptr;
+    TWeakObjectPtr<APlayerShip> CurrentPlayer;
+    float SessionStartTime = 0.f;
+};
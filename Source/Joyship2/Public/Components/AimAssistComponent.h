@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "AimAssistComponent.generated.h"
+
+// Keeps the owner's current aim-assist target: the first damageable actor a sphere of LateralRadius swept Range
+// along the owner's Up vector (the ship thrust axis) would hit, as the per-shot sweep it replaces found. The target is
+// re-validated each tick against that swept sphere; a spatial-grid ray query only runs when the target is lost or
+// every FullQueryInterval.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class JOYSHIP2_API UAimAssistComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UAimAssistComponent();
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    // Maximum distance to a target
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AimAssist")
+    float Range = 5000.f;
+
+    // Radius of the swept sphere: targets whose collision comes this close to the aim axis are accepted
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AimAssist")
+    float LateralRadius = 150.f;
+
+    // Seconds between full queries while a target is held (or while nothing is found)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AimAssist")
+    float FullQueryInterval = 0.25f;
+
+    // Current best target, or null
+    UFUNCTION(BlueprintCallable, Category = "AimAssist")
+    AActor* GetCurrentTarget() const { return CurrentTarget.Get(); }
+
+    // Direction from FromLocation to the current target, or Fallback when there is none
+    FVector GetAimDirection(const FVector& FromLocation, const FVector& Fallback) const;
+
+    // Drop the current target and run a full query on the next tick
+    UFUNCTION(BlueprintCallable, Category = "AimAssist")
+    void InvalidateTarget();
+
+protected:
+    // Cheap check of a single candidate: would the swept sphere touch it?
+    bool IsTargetAcceptable(const AActor* Target, const FVector& Origin, const FVector& Axis) const;
+
+    // Spatial-grid ray query for the first target along the aim axis
+    AActor* FindBestTarget(const FVector& Origin, const FVector& Axis);
+
+    void GetAimOriginAndAxis(FVector& OutOrigin, FVector& OutAxis) const;
+
+    TWeakObjectPtr<AActor> CurrentTarget;
+
+    float QueryAccum = 0.f;
+    bool bForceQuery = true;
+};
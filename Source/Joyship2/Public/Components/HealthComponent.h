@@ -6,7 +6,16 @@
 
 class UParticleSystem;
 class USoundBase;
+class UDamageType;
+class UHealthComponent;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHealthChanged, UHealthComponent*, HealthComp, float, NewHealth);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHealthDepleted, UHealthComponent*, HealthComp);
+
+// The one place health lives (ships, enemies and turrets). Damage normally arrives batched from UDamageSubsystem;
+// UGameplayStatics::ApplyDamage on the owner is routed into that queue. Death is dispatched once through Explode.
+// In a networked game only the server changes health; clients receive CurrentHealth (re-broadcasting OnHealthChanged)
+// and a death event for the effects, while the owner's destruction replicates from the server.
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class JOYSHIP2_API UHealthComponent : public UActorComponent
 {
@@ -16,28 +25,68 @@ public:
     UHealthComponent();
 
 protected:
+    virtual void InitializeComponent() override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+    UFUNCTION()
+    void OnRep_CurrentHealth();
+
+    // Sent before the owner is destroyed, so clients still get the effects when the final health never arrives
+    UFUNCTION(NetMulticast, Reliable)
+    void MulticastDeath();
+
+    // Death effects only (no OnDeath, no destroy)
+    void PlayDeathEffects();
+
+    // Owner's OnTakeAnyDamage: queue into UDamageSubsystem
+    UFUNCTION()
+    void HandleTakeAnyDamage(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser);
 
 public:
     // Max health
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health")
     float MaxHealth = 100.f;
 
-    // Current health
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Health")
+    // Current health (replicated from the server)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, ReplicatedUsing = OnRep_CurrentHealth, Category = "Health")
     float CurrentHealth = 100.f;
 
-    // Explosion effect to play on death
+    // Explosion effect to play on death. Soft: preloaded with the owner, skipped if it has not arrived.
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Effects")
-    UParticleSystem* ExplosionEffect;
+    TSoftObjectPtr<UParticleSystem> ExplosionEffect;
 
     // Explosion sound
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Effects")
-    USoundBase* ExplosionSound;
+    TSoftObjectPtr<USoundBase> ExplosionSound;
+
+    // Broadcast after each applied change
+    UPROPERTY(BlueprintAssignable, Category = "Health")
+    FOnHealthChanged OnHealthChanged;
+
+    // Broadcast once, just before the owner is destroyed
+    UPROPERTY(BlueprintAssignable, Category = "Health")
+    FOnHealthDepleted OnDeath;
+
+    // Controller behind the most recent queued damage (kill attribution)
+    TWeakObjectPtr<AController> LastInstigator;
 
+    // Apply immediately (UDamageSubsystem calls this with the frame's summed damage). Ignored on network clients.
     UFUNCTION(BlueprintCallable, Category = "Health")
     void ApplyDamage(float DamageAmount);
 
+    // Effects, OnDeath and destroy the owner. Safe to call more than once; only the first call does anything.
+    // Ignored on network clients.
     UFUNCTION(BlueprintCallable, Category = "Health")
     void Explode();
+
+    UFUNCTION(BlueprintPure, Category = "Health")
+    bool IsDead() const { return bDead; }
+
+protected:
+    bool bDead = false;
 };
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Net/ShipNetTypes.h"
+#include "ShipNetMovementComponent.generated.h"
+
+class ABaseShip;
+
+// Replicated movement for ABaseShip. Inactive in standalone; in a networked game the ship runs the kinematic
+// fixed-step simulation on every machine and this component plays one of four roles:
+//   - server, ship driven locally (AI, listen-server host): capture the simulated state into ServerState
+//   - server, ship owned by a remote player: simulate each FShipNetMove the client sends, then capture with an ack
+//   - owning client (autonomous proxy): simulate input immediately, keep the unacknowledged moves, and when
+//     ServerState arrives rewind to it and replay the moves still in flight if the prediction was off
+//   - other clients (simulated proxy): snap to ServerState and predict forward from its steering targets
+// Corrections are hidden by easing the ship mesh out of the old position. Test on one machine with
+// "UnrealEditor Joyship2 /Game/Maps/SandBox?listen -game" plus "UnrealEditor Joyship2 127.0.0.1 -game",
+// or PIE with Net Mode "Play As Listen Server"/"Play As Client" and several players.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class JOYSHIP2_API UShipNetMovementComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UShipNetMovementComponent();
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    // Distance (uu) between the predicted and the acknowledged server position that triggers a rewind and replay
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
+    float CorrectionTolerance = 2.f;
+
+    // Corrections larger than this (uu) snap instead of being smoothed out
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
+    float SnapDistance = 500.f;
+
+    // How fast (1/s) the visual correction offset decays
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
+    float SmoothingSpeed = 12.f;
+
+    // Server clamps each client move to this many seconds
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
+    float MaxMoveDeltaTime = 0.1f;
+
+    // Server: how far (seconds) a client's summed move time may run ahead of elapsed server time.
+    // Moves past this budget are cut short, so sending extra moves cannot make the ship faster.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
+    float MoveTimeTolerance = 0.25f;
+
+    // Unacknowledged moves kept for replay; the oldest is dropped beyond this
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
+    int32 MaxPendingMoves = 96;
+
+    bool IsNetworked() const { return GetNetMode() != NM_Standalone; }
+
+    // Movement comes from client moves: the owning client, or the server's copy of a remote player's ship
+    bool IsDrivenByMoves() const;
+
+    // Owning client: simulate this frame's input, remember it and send it to the server
+    void PredictMove(float DeltaTime, float Rotation, bool bThrust);
+
+    // Called by ABaseShip::Tick. True when network movement replaced the ship's own simulation this frame.
+    bool TickNetworkMovement(float DeltaTime);
+
+protected:
+    UPROPERTY(ReplicatedUsing = OnRep_ServerState)
+    FShipNetState ServerState;
+
+    UFUNCTION()
+    void OnRep_ServerState();
+
+    // The latest move plus the one before it, so a single lost packet costs nothing
+    UFUNCTION(Server, Unreliable)
+    void ServerMove(const FShipNetMove& Move, const FShipNetMove& PreviousMove);
+
+    // Server: simulate Move if it is newer than the last one processed
+    void ProcessMove(FShipNetMove Move);
+
+    // Server: ship -> ServerState
+    void CaptureServerState();
+
+    // Clients: ServerState -> ship
+    void ApplyServerState(const FShipNetState& State);
+
+    void ReconcileAutonomous();
+    void CorrectSimulatedProxy();
+
+    // Ease the mesh from OldLocation to the corrected actor location
+    void AddCorrectionOffset(const FVector& OldLocation);
+    void UpdateMeshOffset(float DeltaTime);
+
+    struct FPendingMove
+    {
+        FShipNetMove Move;
+        FVector PredictedLocation;
+    };
+
+    // Owning client: moves sent but not yet acknowledged, oldest first
+    TArray<FPendingMove> PendingMoves;
+    uint16 NextMoveId = 1;
+
+    // Server: last client move simulated
+    uint16 LastProcessedMove = 0;
+    bool bHasProcessedMove = false;
+
+    // Server: simulation time the owning connection may still spend (seconds), refilled by elapsed server time
+    double MoveTimeBudget = 0.0;
+    double LastMoveBudgetTime = 0.0;
+
+    // World-space offset of the mesh from the actor while a correction is smoothed out
+    FVector MeshOffset = FVector::ZeroVector;
+
+    UPROPERTY()
+    ABaseShip* Ship = nullptr;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EShipInputEvent : uint8
+{
+    Rotate,         // Value = axis
+    ThrustStart,
+    ThrustStop,
+    Fire
+};
+
+struct FShipInputSample
+{
+    EShipInputEvent Event = EShipInputEvent::Rotate;
+    float Value = 0.f;
+};
+
+// Fixed-size single-threaded ring of input samples. Input callbacks only push a POD sample; the ship drains the
+// ring in its simulation steps. Never allocates. A Rotate sample replaces a Rotate that is still the newest queued
+// sample (the axis is a value, only its latest reading matters); when full, the oldest sample is overwritten and
+// counted, so the newest state (e.g. a ThrustStop) always gets through.
+class FShipInputBuffer
+{
+public:
+    static constexpr uint32 Capacity = 64;
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    void Push(EShipInputEvent Event, float Value = 0.f)
+    {
+        if (Event == EShipInputEvent::Rotate && Num() > 0)
+        {
+            FShipInputSample& Newest = Samples[(Head - 1) & (Capacity - 1)];
+            if (Newest.Event == EShipInputEvent::Rotate)
+            {
+                Newest.Value = Value;
+                return;
+            }
+        }
+        if (Num() == Capacity)
+        {
+            ++Tail;
+            ++NumDropped;
+        }
+        FShipInputSample& Sample = Samples[Head++ & (Capacity - 1)];
+        Sample.Event = Event;
+        Sample.Value = Value;
+    }
+
+    bool Pop(FShipInputSample& OutSample)
+    {
+        if (Tail == Head) return false;
+        OutSample = Samples[Tail++ & (Capacity - 1)];
+        return true;
+    }
+
+    uint32 Num() const { return Head - Tail; }
+    void Reset() { Head = Tail = 0; }
+
+    // Oldest samples overwritten by a full ring since creation
+    uint32 GetNumDropped() const { return NumDropped; }
+
+private:
+    FShipInputSample Samples[Capacity];
+    uint32 Head = 0;
+    uint32 Tail = 0;
+    uint32 NumDropped = 0;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "JoyshipReplicationGraph.generated.h"
+
+// How a replicated class is routed through UJoyshipReplicationGraph
+enum class EJoyshipRepPolicy : uint8
+{
+    NotRouted,          // handled per connection (player controllers) or not replicated
+    AlwaysRelevant,     // game state, player states, the projectile event relay
+    Spatialized,        // ships, turrets, collectables: relevant when the spatial grid finds them near a viewer
+    SpatializedByRange, // enemies: spatialized, and replicated less often the further they are from each viewer
+    Distance            // anything else: gathered for everyone and culled by its NetCullDistance
+};
+
+// Per-connection relevancy from USpatialGridSubsystem. Each connection's viewers query the grid once per
+// replication frame instead of every actor answering IsNetRelevantFor for every connection; actors found are also
+// given a per-connection replication period from their distance to the nearest viewer when range-rated.
+UCLASS()
+class JOYSHIP2_API UJoyshipGridReplicationNode : public UReplicationGraphNode
+{
+    GENERATED_BODY()
+
+public:
+    virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override {}
+    virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+    virtual void NotifyResetAllNetworkActors() override;
+    virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+    void AddActor(AActor* Actor, bool bRateByRange);
+
+    // Viewer query radius (uu)
+    float RelevancyRadius = 15000.f;
+
+    // Range-rated actors closer than NearDistance replicate at their class rate, up to FarDistance at
+    // MidPeriodScale times its period, and beyond that at FarPeriodScale times
+    float NearDistance = 3000.f;
+    float FarDistance = 8000.f;
+    uint16 MidPeriodScale = 2;
+    uint16 FarPeriodScale = 4;
+
+protected:
+    // Replicated actors in the node; true for range-rated ones
+    TMap<AActor*, bool> Actors;
+
+    // Gathered lists must outlive the gather, so each connection keeps its own
+    TMap<const UNetReplicationGraphConnection*, FActorRepListRefView> ConnectionLists;
+
+    // Per-gather scratch
+    TArray<AActor*> QueryResults;
+};
+
+// Replication driver (see Config/DefaultEngine.ini). Routes each replicated class by EJoyshipRepPolicy:
+// always-relevant actors go to one global list, spatialized ones to UJoyshipGridReplicationNode, player controllers
+// and the connection's view target to a per-connection node. Dormancy (idle turrets and collectables) is honoured
+// per connection by the graph itself.
+UCLASS(Transient, Config = Engine)
+class JOYSHIP2_API UJoyshipReplicationGraph : public UReplicationGraph
+{
+    GENERATED_BODY()
+
+public:
+    virtual void InitGlobalActorClassSettings() override;
+    virtual void InitGlobalGraphNodes() override;
+    virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+    virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+    virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+    // Radius around each viewer the spatial grid is queried with
+    UPROPERTY(Config)
+    float RelevancyRadius = 15000.f;
+
+    UPROPERTY(Config)
+    float EnemyNearDistance = 3000.f;
+
+    UPROPERTY(Config)
+    float EnemyFarDistance = 8000.f;
+
+protected:
+    EJoyshipRepPolicy GetPolicy(const UClass* Class);
+
+    // Class policy, overridden by the actor's own bOnlyRelevantToOwner / bAlwaysRelevant
+    EJoyshipRepPolicy GetActorPolicy(const AActor* Actor);
+
+    TClassMap<EJoyshipRepPolicy> ClassPolicies;
+
+    UPROPERTY()
+    UJoyshipGridReplicationNode* GridNode = nullptr;
+
+    UPROPERTY()
+    UReplicationGraphNode_ActorList* AlwaysRelevantNode = nullptr;
+
+    // Gathered for every connection, culled by distance in the graph
+    UPROPERTY()
+    UReplicationGraphNode_ActorList* DistanceNode = nullptr;
+};
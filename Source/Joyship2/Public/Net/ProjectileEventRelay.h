@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Net/ProjectileNetTypes.h"
+#include "ProjectileEventRelay.generated.h"
+
+// Replicated carrier for UProjectileNetSubsystem: world subsystems have no net channel, so the server spawns one of
+// these per world and sends each frame's shots through it in a single unreliable multicast.
+UCLASS(NotPlaceable, Transient)
+class JOYSHIP2_API AProjectileEventRelay : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AProjectileEventRelay();
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Server -> all clients. Lost batches only cost the visuals; hits are resolved on the server.
+    UFUNCTION(NetMulticast, Unreliable)
+    void MulticastFireEvents(const TArray<FProjectileFireEvent>& Events);
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProjectileNetTypes.generated.h"
+
+// One shot, as sent server -> clients in batches and owning client -> server. Clients simulate the shot locally from
+// this (projectiles themselves are never replicated); the server alone decides what it hits.
+USTRUCT()
+struct JOYSHIP2_API FProjectileFireEvent
+{
+    GENERATED_BODY()
+
+    // Muzzle location (1/10 uu)
+    FVector Origin = FVector::ZeroVector;
+
+    // Unit direction, sent as pitch/yaw shorts
+    FVector Direction = FVector::UpVector;
+
+    // Shooter's shot counter: tells shots from one shooter apart and seeds any cosmetic variation
+    uint16 Seed = 0;
+
+    // Server world time the shot left the muzzle; receivers fast-forward the shot by how long ago that was
+    float Time = 0.f;
+
+    // Both resolve through the package map. The server ignores the values a client sends and uses its own.
+    UPROPERTY()
+    UClass* ProjectileClass = nullptr;
+
+    UPROPERTY()
+    AActor* Shooter = nullptr;
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FProjectileFireEvent> : public TStructOpsTypeTraitsBase2<FProjectileFireEvent>
+{
+    enum { WithNetSerializer = true };
+};
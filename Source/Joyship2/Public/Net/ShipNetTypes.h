@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ShipNetTypes.generated.h"
+
+// Move ids wrap at 16 bits; A is newer than B when it is less than half the range ahead
+inline bool IsNewerShipMove(uint16 A, uint16 B)
+{
+    return (int16)(A - B) > 0;
+}
+
+// One frame of player input sent client -> server. The client simulates the same quantized values it sends,
+// so server and client run identical moves.
+USTRUCT()
+struct JOYSHIP2_API FShipNetMove
+{
+    GENERATED_BODY()
+
+    uint16 Id = 0;
+
+    // Frame time in 1/10000 s (max 6.5 s)
+    uint16 DeltaTime = 0;
+
+    // Rotate axis * 32767
+    int16 Rotation = 0;
+
+    bool bThrust = false;
+
+    void Set(uint16 InId, float InDeltaTime, float InRotation, bool bInThrust);
+    float GetDeltaTime() const { return DeltaTime / 10000.f; }
+    float GetRotation() const { return Rotation / 32767.f; }
+
+    // 35 bits with rotation, 20 without
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FShipNetMove> : public TStructOpsTypeTraitsBase2<FShipNetMove>
+{
+    enum { WithNetSerializer = true };
+};
+
+// Authoritative ship movement state, server -> clients. Everything is stored quantized, so equality (which decides
+// whether the property is re-sent) ignores sub-quantum jitter. Fields that are at rest (no velocity, no steering
+// target, no fuel, no acked move) cost one bit each.
+USTRUCT()
+struct JOYSHIP2_API FShipNetState
+{
+    GENERATED_BODY()
+
+    // ZY position in 1/10 uu
+    int32 PosY = 0;
+    int32 PosZ = 0;
+
+    // Roll, FRotator::CompressAxisToShort
+    uint16 Roll = 0;
+
+    // ZY velocity in uu/s
+    int32 VelY = 0;
+    int32 VelZ = 0;
+
+    // Roll rate in deg/s (the fixed-step simulation's angular velocity about the forward axis)
+    int16 RollRate = 0;
+
+    // Steering targets the simulation eases toward; proxies predict from these between updates
+    int32 TargetVelY = 0;
+    int32 TargetVelZ = 0;
+    int16 TargetRollRate = 0;
+
+    // Player fuel in 1/10 units (only sent when bHasFuel)
+    bool bHasFuel = false;
+    uint16 Fuel = 0;
+
+    // Last client move applied to this state (only sent for remotely controlled ships)
+    bool bHasAck = false;
+    uint16 AckedMove = 0;
+
+    void SetLocation(const FVector& Location);
+    FVector GetLocation(float X) const { return FVector(X, PosY / 10.f, PosZ / 10.f); }
+
+    void SetRoll(float InRoll) { Roll = FRotator::CompressAxisToShort(InRoll); }
+    float GetRoll() const { return FRotator::DecompressAxisFromShort(Roll); }
+
+    void SetVelocity(const FVector& Velocity);
+    FVector GetVelocity() const { return FVector(0.f, (float)VelY, (float)VelZ); }
+
+    void SetTargetVelocity(const FVector& Velocity);
+    FVector GetTargetVelocity() const { return FVector(0.f, (float)TargetVelY, (float)TargetVelZ); }
+
+    // Angular velocity vectors are about the ship's forward axis
+    static int16 QuantizeRollRate(const FVector& AngularVelocity, const FVector& ForwardAxis);
+    static FVector DequantizeRollRate(int16 DegreesPerSecond, const FVector& ForwardAxis);
+
+    void SetFuel(float InFuel);
+    float GetFuel() const { return Fuel / 10.f; }
+
+    bool operator==(const FShipNetState& Other) const;
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FShipNetState> : public TStructOpsTypeTraitsBase2<FShipNetState>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithIdenticalViaEquality = true
+    };
+};
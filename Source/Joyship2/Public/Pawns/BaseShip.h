@@ -3,18 +3,34 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
 #include "Components/CapsuleComponent.h"
+#include "Net/ProjectileNetTypes.h"
 #include "BaseShip.generated.h"
 
+class UAimAssistComponent;
+class UHealthComponent;
+class UShipNetMovementComponent;
+struct FShipNetMove;
+
 UCLASS()
 class JOYSHIP2_API ABaseShip : public APawn
 {
 	GENERATED_BODY()
 
+	// Reads and restores the simulation state for replication
+	friend class UShipNetMovementComponent;
+
 public:
 	ABaseShip();
 
 protected:
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+#if WITH_EDITOR
+	// Flags Blueprint defaults that break Root's physics setup (see CollectPhysicsConfigProblems)
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
 
 public:
 	virtual void Tick(float DeltaTime) override;
@@ -30,17 +46,28 @@ public:
 
 	/* ---------------- HEALTH ---------------- */
 
+	// Owns the ship's health; all damage and the death/explode path go through it
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ship|Health")
+	UHealthComponent* HealthComp;
+
+	// Seeds HealthComp->MaxHealth when the component is left at its default
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Health")
 	float MaxHealth = 100.f;
 
+	// Mirror of HealthComp->CurrentHealth
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ship|Health")
 	float CurrentHealth;
 
+	// Immediate damage (forwards to HealthComp)
 	UFUNCTION(BlueprintCallable)
 	virtual void ApplyDamage(float DamageAmount);
 
+	// Explode and destroy through HealthComp
 	virtual void OnShipDestroyed();
 
+	UFUNCTION()
+	void HandleHealthChanged(UHealthComponent* InHealthComp, float NewHealth);
+
 	/* ---------------- MOVEMENT ---------------- */
 
 	// Current velocity
@@ -66,7 +93,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Movement")
 	float TurnSpeed = 140.f;
 
-	// Drag applied each frame (closer to 1 = less drag)
+	// Drag applied per 60 Hz frame, scaled by DeltaTime (closer to 1 = less drag)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Movement")
 	float Drag = 0.985f;
 
@@ -74,49 +101,119 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Movement")
 	float MaxSpeed = 3000.f;
 
+	// Downward acceleration (uu/s^2) used by the fixed-step simulation when Root has gravity enabled
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Movement")
 	float GravityForce = 600.f;
 
+	/* ---------------- FIXED-STEP SIMULATION ---------------- */
+
+	// Integrate thrust, gravity, drag and rotation at FixedStepRate instead of once per frame with engine physics.
+	// The root is moved kinematically (with sweeps) each step and ShipMesh is interpolated between the last two
+	// steps, so behaviour is identical at any frame rate and can be stepped faster than real time.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Movement|FixedStep")
+	bool bUseFixedStepSimulation = false;
+
+	// Simulation steps per second
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Movement|FixedStep", meta = (ClampMin = "10"))
+	float FixedStepRate = 60.f;
+
+	// Steps allowed in one frame before the remaining time is dropped (avoids a spiral after a hitch)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Movement|FixedStep", meta = (ClampMin = "1"))
+	int32 MaxFixedStepsPerFrame = 8;
+
+	// Advance the fixed-step simulation by exactly one step of StepSeconds
+	void StepFixedSimulation(float StepSeconds);
+
+	// Called before each step TickFixedStep runs, so controls can change between the steps of one frame
+	virtual void PreFixedStep(float StepSeconds) {}
+
+	/* ---------------- NETWORK ---------------- */
+
+	// Replicated movement with client prediction (inactive in standalone)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ship|Network")
+	UShipNetMovementComponent* NetMovement;
+
+	// Apply one client move and advance the simulation by its DeltaTime (owning client and server run the same moves)
+	virtual void SimulateNetMove(const FShipNetMove& Move);
+
+	// Extra replicated state: ships with fuel return true and fill OutFuel
+	virtual bool GetNetFuel(float& OutFuel) const { return false; }
+	virtual void SetNetFuel(float Fuel) {}
+
+	// Shortest time between two shots the ship's weapon allows (0: no limit); the server holds client shots to it
+	virtual float GetFireCooldown() const { return 0.f; }
+
 
 	/* Movement functions */
+	// True when movement is driven by engine physics or by the fixed-step simulation (both consume the Target* velocities)
+	bool UsesTargetVelocities() const { return bUseFixedStepSimulation || (Root && Root->IsSimulatingPhysics()); }
+
 	UFUNCTION(BlueprintCallable)
 	void ApplyThrust(float DeltaTime);
 
 	UFUNCTION(BlueprintCallable)
 	void RotateShip(float Input, float DeltaTime);
 
-    // Weapons
+    // Weapons. Soft: loaded by UAssetPreloadSubsystem, never on first shot; the ship does not fire until it has arrived.
     UPROPERTY(EditDefaultsOnly, Category = "Weapons")
-    TSubclassOf<AActor> ProjectileClass;
+    TSoftClassPtr<AActor> ProjectileClass;
+
+    // Loaded ProjectileClass, or null
+    UClass* GetProjectileClass() const { return ProjectileClass.Get(); }
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapons")
     FVector MuzzleOffset = FVector(0.f, 0.f, 100.f);
 
-    // Aim assist settings: when firing, trace forward and aim at the first hit actor
+    // Number of projectiles of ProjectileClass to keep ready in the world pool
+    UPROPERTY(EditDefaultsOnly, Category = "Weapons")
+    int32 ProjectilePoolPrewarm = 16;
+
+    // Fire through USimulatedProjectileSubsystem (no actor per shot) using ProjectileClass's defaults.
+    // Requires an AProjectile class; anything else still goes through the pool.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapons")
+    bool bUseSimulatedProjectiles = false;
+
+    // Aim assist: Fire aims at the target cached by AimAssist (re-validated each frame, re-queried at a low rate)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapons|AimAssist")
     bool bEnableAimAssist = true;
 
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapons|AimAssist")
+    UAimAssistComponent* AimAssist;
+
+    // Copied to AimAssist->Range at BeginPlay
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapons|AimAssist")
     float AimAssistRange = 5000.f;
 
-    // Radius for sphere trace; set to 0 to use a precise line trace
+    // Copied to AimAssist->LateralRadius at BeginPlay; 0 accepts only targets inside the cone
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapons|AimAssist")
     float AimAssistRadius = 150.f;
 
+    // World location projectiles are fired from (MuzzleOffset in ship space)
+    FVector GetMuzzleLocation() const;
+
+    // Networked, only the server and the owning client fire: the server launches the projectile and sends a fire
+    // event to the clients, the owning client draws a cosmetic shot and sends it to the server (ServerFire)
     UFUNCTION(BlueprintCallable)
     void Fire();
 
+    // Launch ProjectileClass (simulated or pooled) without any bookkeeping; the server's end of a client shot
+    void LaunchProjectile(const FVector& Location, const FRotator& Rotation, const FVector& Direction);
+
+    // Owning client -> server: resolved with lag compensation by UProjectileNetSubsystem
+    UFUNCTION(Server, Reliable)
+    void ServerFire(const FProjectileFireEvent& Event);
+
+    // Number of Fire() calls so far (input recording samples it once per frame)
+    int32 GetFireCount() const { return FireCount; }
+
     /* ---------------- EFFECTS ---------------- */
-    // Explosion effect to play on collision / destruction
+    // Explosion effect to play on collision / destruction (preloaded; skipped if it has not arrived)
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Effects")
-    UParticleSystem* ExplosionEffect;
+    TSoftObjectPtr<UParticleSystem> ExplosionEffect;
 
     // Explosion sound
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Effects")
-    USoundBase* ExplosionSound;
-
-    UFUNCTION(BlueprintCallable)
-    void PlayExplosionEffect();
+    TSoftObjectPtr<USoundBase> ExplosionSound;
 
     // Overlap handler for the root capsule
     UFUNCTION()
@@ -128,4 +225,42 @@ public:
     // Hit handler for blocking collisions
     UFUNCTION()
     void OnRootHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+protected:
+    int32 FireCount = 0;
+
+    // Ways Root differs from the physics setup the constructor establishes (simulating, movable, PhysicsActor
+    // profile, overlap and hit events, the native class's gravity). Empty when the setup is intact.
+    void CollectPhysicsConfigProblems(TArray<FString>& OutProblems) const;
+
+    // Checks the class defaults once per class; classes with problems pay for ApplyPhysicsConfig on every instance
+    bool IsPhysicsConfigValidForClass() const;
+
+    // Class defaults only: result of IsPhysicsConfigValidForClass, unset until the first spawn
+    TOptional<bool> PhysicsConfigValid;
+
+    // Checks this instance, which can differ from the class defaults (level overrides, construction script)
+    bool IsPhysicsConfigValidForInstance() const;
+
+    // Restore the constructor's physics setup on Root
+    void ApplyPhysicsConfig();
+
+    // Top up the world pool with ProjectilePoolPrewarm projectiles of the loaded ProjectileClass
+    void PrewarmProjectilePool();
+
+    // Fixed-step simulation: run the due steps for this frame, then interpolate ShipMesh
+    void TickFixedStep(float DeltaTime);
+
+    // Switch Root to kinematic and seed the simulation state from the current transform
+    void InitFixedStep();
+
+    float FixedStepAccumulator = 0.f;
+    FVector FixedAngularVelocity = FVector::ZeroVector;
+
+    // Root transform after the previous and the latest step (ShipMesh is blended between them)
+    FTransform PrevStepTransform;
+    FTransform CurrStepTransform;
+
+    // ShipMesh's authored offset from Root
+    FTransform MeshRelativeTransform;
 };
@@ -3,10 +3,11 @@
 #include "CoreMinimal.h"
 #include "BaseShip.h"
 #include "Components/SphereComponent.h"
+#include "Subsystems/TickSignificanceSubsystem.h"
 #include "EnemyShip.generated.h"
 
-class UHealthComponent;
 class USphereComponent;
+class APlayerShip;
 
 UCLASS()
 class JOYSHIP2_API AEnemyShip : public ABaseShip
@@ -20,9 +21,9 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Enemy")
     USphereComponent* AggroSphere;
 
-    // Health component
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Enemy")
-    UHealthComponent* HealthComp;
+    // Detect players through the spatial grid (AggroSphere only provides the radius) instead of overlap events
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy")
+    bool bUseSpatialAggro = true;
 
     // Start following target (callable from Blueprints)
     UFUNCTION(BlueprintCallable, Category = "Enemy")
@@ -32,8 +33,24 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Enemy")
     void StopFollowing();
 
+    bool IsFollowing() const { return bFollowing && FollowTarget.IsValid(); }
+    AActor* GetFollowTarget() const { return FollowTarget.Get(); }
+    float GetRotationSpeed() const { return RotationSpeed; }
+
+    // Called by UEnemySteeringSubsystem with the result of the batched steering pass
+    void ApplySteering(const FQuat& NewRotation, const FVector& NewTargetVelocity);
+
+    float GetAggroRadius() const;
+    APlayerShip* GetAggroPlayer() const { return AggroPlayer.Get(); }
+
+    // A player entered / left the aggro radius (from overlap events or the spatial grid scan)
+    void NotifyAggroEnter(APlayerShip* Player);
+    void NotifyAggroExit(APlayerShip* Player);
+
 protected:
+    virtual void PostInitializeComponents() override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
     // Overlap handlers for the aggro sphere
@@ -47,10 +64,22 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Enemy")
     bool bFollowing = false;
 
-    // The actor we are following (player)
-    AActor* FollowTarget = nullptr;
+    // The actor we are following (player); weak so a destroyed target just reads as null
+    TWeakObjectPtr<AActor> FollowTarget;
 
     // Rotation interpolation speed when turning to face the target
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy")
     float RotationSpeed = 4.f;
+
+    // Player currently inside the aggro radius (weak: the player can be destroyed between scans)
+    TWeakObjectPtr<APlayerShip> AggroPlayer;
+
+    // True while UEnemySteeringSubsystem steers this ship; Tick then skips its own steering
+    bool bSteeringBatched = false;
+
+    // Last tier from UTickSignificanceSubsystem
+    ESignificanceTier SignificanceTier = ESignificanceTier::High;
+
+    // Tick rate from SignificanceTier; dormant enemies that are not following stop ticking
+    void RefreshTickState();
 };
@@ -4,8 +4,14 @@
 #include "BaseShip.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "Replay/ShipInputRecording.h"
+#include "Input/ShipInputBuffer.h"
 #include "PlayerShip.generated.h"
 
+class UInputMappingContext;
+class UInputAction;
+struct FInputActionValue;
+
 UCLASS()
 class JOYSHIP2_API APlayerShip : public ABaseShip
 {
@@ -29,20 +35,128 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void StopThrust();
 
+	// Fire unless still cooling down from the last TryFire (the fire input goes through here)
+	UFUNCTION(BlueprintCallable, Category = "Weapons")
+	bool TryFire();
+
+	// Minimum seconds between shots fired through TryFire
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapons", meta = (ClampMin = "0"))
+	float FireCooldown = 0.2f;
+
 	// Refill fuel by Amount (clamped to MaxFuel)
 	UFUNCTION(BlueprintCallable, Category = "Ship|Fuel")
 	void RefillFuel(float Amount);
 
+	UFUNCTION(BlueprintPure, Category = "Ship|Fuel")
+	float GetCurrentFuel() const { return CurrentFuel; }
+
+	// Total fuel burnt by thrust since BeginPlay
+	UFUNCTION(BlueprintPure, Category = "Ship|Fuel")
+	float GetFuelConsumed() const { return FuelConsumed; }
+
+	/* ------------ RECORD / REPLAY ------------ */
+
+	// Start capturing per-frame input. Reseeds the global RNG with Seed (0 picks one) so the session can be reproduced.
+	UFUNCTION(Exec, BlueprintCallable, Category = "Ship|Replay")
+	void StartInputRecording(int32 Seed = 0);
+
+	// Stop capturing and write the session to FileName (relative names go under Saved/Replays)
+	UFUNCTION(Exec, BlueprintCallable, Category = "Ship|Replay")
+	void StopInputRecording(const FString& FileName);
+
+	// Load a session written by StopInputRecording and replay it on this ship
+	UFUNCTION(Exec, BlueprintCallable, Category = "Ship|Replay")
+	void ReplayInput(const FString& FileName);
+
+	// Restore the recorded start state and seed, then take input from Recording (one frame per Tick) instead of
+	// the controller. Frame-exact only when the world is ticked with the recorded DeltaTimes (see the benchmark's -Replay=).
+	bool StartInputReplay(const FShipInputRecording& Recording);
+	void StopInputReplay();
+
+	UFUNCTION(BlueprintPure, Category = "Ship|Replay")
+	bool IsRecordingInput() const { return bRecordingInput; }
+
+	UFUNCTION(BlueprintPure, Category = "Ship|Replay")
+	bool IsReplayingInput() const { return ReplayFrame != INDEX_NONE; }
+
+	// Saved/Replays/<FileName>[.jsreplay] for relative names, FileName otherwise
+	static FString GetReplayPath(const FString& FileName);
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
+	virtual void NotifyControllerChanged() override;
+
+	// Network movement: input from the move, then controls and one simulation step
+	virtual void SimulateNetMove(const FShipNetMove& Move) override;
+	virtual bool GetNetFuel(float& OutFuel) const override { OutFuel = CurrentFuel; return true; }
+	virtual void SetNetFuel(float Fuel) override { CurrentFuel = Fuel; }
+	virtual float GetFireCooldown() const override { return FireCooldown; }
+
+	// Fixed-step simulation: drain input and apply controls per step rather than per frame
+	virtual void PreFixedStep(float StepSeconds) override;
+	bool ConsumesInputPerStep() const;
+
+	/* ------------ INPUT ------------ */
+
+	// Added to the local player's Enhanced Input subsystem when a player controller takes the ship
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
+	UInputMappingContext* DefaultMappingContext;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
+	int32 MappingContextPriority = 0;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
+	UInputAction* ThrustAction;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
+	UInputAction* FireAction;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
+	UInputAction* RotateAction;
+
+	// Samples pushed by the input handlers since the last Tick
+	FShipInputBuffer InputBuffer;
+
+	// Last value pushed by the legacy Rotate axis
+	float LastBufferedRotation = 0.f;
+
+	// World time at which TryFire may fire again
+	float NextFireTime = 0.f;
+
+	void OnRotateAction(const FInputActionValue& Value);
+	void OnRotateCompleted();
+	void OnRotateAxis(float Value);
+	void OnThrustStarted();
+	void OnThrustCompleted();
+	void OnFireTriggered();
+
+	// Drain InputBuffer into the input state (and fire). With bStopAtThrustChange, stop after the first sample that
+	// starts or stops thrust, leaving the rest for the next step, so a press and release within one frame still thrusts.
+	void ConsumeBufferedInput(bool bStopAtThrustChange = false);
+
+	// Rotation, thrust and fuel from the current input state
+	void ApplyShipControls(float DeltaTime);
 
 	/* ------------ INPUT STATE ------------ */
 
 	float RotationInput = 0.f;
 	bool bThrusting = false;
 
+	// Record this frame's input, or overwrite it from the replay
+	void ProcessRecordedInput(float DeltaTime);
+
+	// Session being recorded or replayed
+	FShipInputRecording InputRecording;
+	bool bRecordingInput = false;
+
+	// Next frame to replay; INDEX_NONE when not replaying
+	int32 ReplayFrame = INDEX_NONE;
+
+	// GetFireCount() when the previous frame was recorded
+	int32 LastRecordedFireCount = 0;
+
     /* ---------------- FUEL ---------------- */
     // Maximum fuel capacity
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Fuel")
@@ -55,4 +169,6 @@ protected:
     // Fuel consumption rate (units per second) while thrusting
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship|Fuel")
     float FuelConsumptionRate = 10.f;
+
+    float FuelConsumed = 0.f;
 };
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// One frame of player input. 7 bytes on disk: DeltaTime, quantized rotate axis and a button byte.
+struct JOYSHIP2_API FShipInputFrame
+{
+    // Bit 0 of Buttons
+    static constexpr uint8 ThrustBit = 1 << 0;
+    // Buttons >> FireShift is the number of Fire() calls this frame (saturates at 127)
+    static constexpr uint8 FireShift = 1;
+    // Bytes one frame takes in the archive
+    static constexpr int64 SerializedSize = sizeof(float) + sizeof(int16) + sizeof(uint8);
+
+    float DeltaTime = 0.f;
+    int16 Rotation = 0;
+    uint8 Buttons = 0;
+
+    static int16 QuantizeAxis(float Value) { return (int16)FMath::RoundToInt(FMath::Clamp(Value, -1.f, 1.f) * 32767.f); }
+    float GetRotation() const { return Rotation / 32767.f; }
+    bool IsThrusting() const { return (Buttons & ThrustBit) != 0; }
+    int32 GetFireCount() const { return Buttons >> FireShift; }
+
+    void Set(float InDeltaTime, float InRotation, bool bThrust, int32 FireCount)
+    {
+        DeltaTime = InDeltaTime;
+        Rotation = QuantizeAxis(InRotation);
+        Buttons = (bThrust ? ThrustBit : 0) | (uint8)(FMath::Clamp(FireCount, 0, 127) << FireShift);
+    }
+
+    friend FArchive& operator<<(FArchive& Ar, FShipInputFrame& Frame)
+    {
+        return Ar << Frame.DeltaTime << Frame.Rotation << Frame.Buttons;
+    }
+};
+
+// A recorded APlayerShip session: the RNG seed and ship state at the start plus every frame's input.
+// Replaying it from the same start state with the recorded DeltaTimes reproduces the session without a player.
+struct JOYSHIP2_API FShipInputRecording
+{
+    static constexpr uint32 Magic = 0x5253594A; // "JYSR"
+    static constexpr uint32 CurrentVersion = 1;
+
+    // Seed passed to FMath::RandInit/SRandInit when recording started
+    int32 RandomSeed = 0;
+
+    // Package name of the world the session was recorded in
+    FString MapName;
+
+    FVector StartLocation = FVector::ZeroVector;
+    FRotator StartRotation = FRotator::ZeroRotator;
+    FVector StartVelocity = FVector::ZeroVector;
+    float StartFuel = 0.f;
+    float StartHealth = 0.f;
+
+    TArray<FShipInputFrame> Frames;
+
+    // Sum of the recorded DeltaTimes
+    float GetDuration() const;
+
+    // True if the recording was made in World's map (PIE prefixes are ignored on both sides)
+    bool MatchesWorld(const UWorld* World) const;
+
+    void Reset() { *this = FShipInputRecording(); }
+
+    // Reads or writes the whole recording. Fails (and flags Ar as errored) on a bad magic, a newer version
+    // or a frame count the rest of the archive cannot hold.
+    bool Serialize(FArchive& Ar);
+
+    bool SaveToFile(const FString& Path) const;
+    bool LoadFromFile(const FString& Path);
+};
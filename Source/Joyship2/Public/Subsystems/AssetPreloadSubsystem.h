@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/SoftObjectPath.h"
+#include "Engine/StreamableManager.h"
+#include "AssetPreloadSubsystem.generated.h"
+
+// Async loads for the soft references gameplay actors hold (projectile classes, explosion effects and sounds).
+// Actors queue their references as they are initialized; everything queued while the map loads is finished before
+// anything begins play, and later requests (spawned actors, streamed cells) stay async. Gameplay code only ever
+// resolves soft references with Get(), so a reference that has not arrived yet is skipped rather than loaded.
+// Once play has begun, every synchronous package load made while this world ticks is counted and logged as a hitch.
+UCLASS()
+class JOYSHIP2_API UAssetPreloadSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // Start loading Paths through the Asset Manager's streamable manager (null and already loaded paths are ignored).
+    // The loaded assets stay resident for the life of the world. OnLoaded runs once all of Paths have loaded,
+    // immediately when they already have.
+    void RequestPreload(TArray<FSoftObjectPath>&& Paths, FStreamableDelegate&& OnLoaded = FStreamableDelegate());
+
+    // Convenience for actors: queue Owner's soft references from its world's subsystem
+    static void Preload(const UObject* Owner, TArray<FSoftObjectPath>&& Paths, FStreamableDelegate&& OnLoaded = FStreamableDelegate());
+
+    // Synchronous package loads on the game thread while this world ticked, since BeginPlay
+    UFUNCTION(BlueprintPure, Category = "Loading")
+    int32 GetNumSyncLoadsDuringPlay() const { return NumSyncLoadsDuringPlay; }
+
+    // First few packages loaded synchronously during play
+    const TArray<FString>& GetSyncLoadedPackages() const { return SyncLoadedPackages; }
+
+    // Seconds BeginPlay waited for map-load requests
+    float GetMapLoadWaitSeconds() const { return MapLoadWaitSeconds; }
+
+protected:
+    void HandleSyncLoad(const FString& PackageName);
+
+    TArray<TSharedPtr<FStreamableHandle>> Handles;
+
+    TSet<FSoftObjectPath> Requested;
+
+    int32 NumSyncLoadsDuringPlay = 0;
+    TArray<FString> SyncLoadedPackages;
+    float MapLoadWaitSeconds = 0.f;
+
+    FDelegateHandle SyncLoadHandle;
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "CollectableSubsystem.generated.h"
+
+class ACollectable;
+class UCollectableSubsystem;
+
+// Counters for a single collectable class (or the sum over all classes)
+USTRUCT(BlueprintType)
+struct JOYSHIP2_API FCollectablePoolStats
+{
+    GENERATED_BODY()
+
+    // In the world and collectable
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Collectable Pool")
+    int32 Active = 0;
+
+    // Collected, waiting in the free list
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Collectable Pool")
+    int32 Pooled = 0;
+
+    // Collected, waiting out their placement's respawn delay
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Collectable Pool")
+    int32 Respawning = 0;
+
+    // Collections so far
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Collectable Pool")
+    int32 Collected = 0;
+
+    // SpawnCollectable calls served from the free list
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Collectable Pool")
+    int32 Reused = 0;
+
+    // SpawnCollectable calls that had to spawn a new actor
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Collectable Pool")
+    int32 Spawned = 0;
+};
+
+// Free list and counters for one collectable class
+USTRUCT()
+struct FCollectablePool
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<ACollectable*> FreeList;
+
+    FCollectablePoolStats Stats;
+};
+
+// Tick function that runs respawns and the magnet pass once per frame in TG_PostPhysics (after ships have moved)
+USTRUCT()
+struct FCollectableMagnetTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UCollectableSubsystem* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCollectableMagnetTickFunction> : public TStructOpsTypeTraitsBase2<FCollectableMagnetTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+// Owns every active magnet (collectable -> pawn) pair in one flat array. A single pass at UpdateRate pulls the
+// collectables toward their pawns, writing the transforms directly (no sweep, no overlap update), and in the same
+// pass collects the ones in range or past their fail-safe delay. Only a pickup whose collision has reached its
+// pawn's gets a real overlap update, so the Blueprint overlap pickup still fires for a pawn that is standing still. Collectables have no Tick and no timers of their own.
+// Collected items are not destroyed: they are deactivated and either wait out their placement's RespawnDelay and
+// reappear in place, or go to a per-class free list that SpawnCollectable draws from.
+UCLASS(Config = Game)
+class JOYSHIP2_API UCollectableSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // Start (or retarget) Collectable's pull toward Pawn; restarts its fail-safe delay
+    void AddMagnet(ACollectable* Collectable, APawn* Pawn);
+
+    void RemoveMagnet(ACollectable* Collectable);
+
+    // Respawns, then the magnet pass
+    void UpdateCollectables(float DeltaTime);
+
+    // Pull, then range and fail-safe collection, for every pair
+    void UpdateMagnets(float DeltaTime);
+
+    int32 GetNumMagnets() const { return Magnets.Num(); }
+
+    /* ---------------- POOLING ---------------- */
+
+    // Place a collectable of CollectableClass at Transform, reusing a pooled one when there is one (server only)
+    UFUNCTION(BlueprintCallable, Category = "Collectable Pool")
+    ACollectable* SpawnCollectable(TSubclassOf<ACollectable> CollectableClass, const FTransform& Transform);
+
+    // Take a collected item: deactivate it, then schedule its respawn or put it in the free list
+    // (destroys it instead when its bReturnToPoolOnCollect is off)
+    void Release(ACollectable* Collectable);
+
+    // Counters follow every collectable from BeginPlay to EndPlay
+    void NotifyBeginPlay(ACollectable* Collectable);
+    void NotifyEndPlay(ACollectable* Collectable);
+
+    UFUNCTION(BlueprintCallable, Category = "Collectable Pool")
+    FCollectablePoolStats GetStatsForClass(TSubclassOf<ACollectable> CollectableClass) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Collectable Pool")
+    FCollectablePoolStats GetTotalStats() const;
+
+    // Clear the Collected/Reused/Spawned counters (Active/Pooled/Respawning are live counts and are kept)
+    UFUNCTION(BlueprintCallable, Category = "Collectable Pool")
+    void ResetStats();
+
+    // Magnet passes per second; 0 runs every frame. Pulls use the time since the last pass, so speed is unaffected.
+    UPROPERTY(Config)
+    float UpdateRate = 30.f;
+
+protected:
+    // Collectable settings are copied in when the pair is added
+    struct FActiveMagnet
+    {
+        TWeakObjectPtr<ACollectable> Collectable;
+        TWeakObjectPtr<APawn> Pawn;
+        float MagnetRadiusSq = 0.f;
+        float AttractionSpeed = 0.f;
+        float StopDistance = 0.f;
+        float CollectDistanceSq = 0.f;
+        bool bRangeCollect = false;
+
+        // Pickup and pawn collision radii summed: inside this their shapes can overlap
+        float OverlapReachSq = 0.f;
+
+        // Seconds left before a forced collection (when bFailSafe)
+        bool bFailSafe = false;
+        float FailSafeRemaining = 0.f;
+
+        // Only the server (or standalone) collects; clients just pull
+        bool bCanCollect = false;
+    };
+
+    // Bulk move: transform update without sweeping or refreshing overlaps
+    static void MoveCollectable(ACollectable* Collectable, const FVector& Location);
+
+    struct FPendingRespawn
+    {
+        TWeakObjectPtr<ACollectable> Collectable;
+        float Remaining = 0.f;
+    };
+
+    // Count down and reactivate in place
+    void UpdateRespawns(float DeltaTime);
+
+    FCollectablePool& GetPool(const ACollectable* Collectable);
+
+    FCollectableMagnetTickFunction TickFunction;
+
+    TArray<FActiveMagnet> Magnets;
+
+    TArray<FPendingRespawn> Respawns;
+
+    UPROPERTY()
+    TMap<UClass*, FCollectablePool> Pools;
+
+    // Collected after the pass, since collecting deactivates (or destroys) actors and removes pairs
+    TArray<FActiveMagnet> PendingCollect;
+
+    // Moved within reach of their pawn this pass; overlaps are updated after it
+    TArray<TWeakObjectPtr<ACollectable>> PendingOverlap;
+
+    float TimeSinceUpdate = 0.f;
+};
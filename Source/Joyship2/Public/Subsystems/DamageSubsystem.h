@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "DamageSubsystem.generated.h"
+
+class UHealthComponent;
+class UDamageSubsystem;
+
+// Tick function that resolves the frame's queued damage in TG_PostUpdateWork (after movement, physics and timers)
+USTRUCT()
+struct FDamageResolveTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UDamageSubsystem* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FDamageResolveTickFunction> : public TStructOpsTypeTraitsBase2<FDamageResolveTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+// Single damage pipeline. Projectiles, simulated projectiles and UGameplayStatics::ApplyDamage (through
+// UHealthComponent's OnTakeAnyDamage binding) all queue here. Once per frame the queue is de-duplicated
+// (one event per victim/causer/shot, so a projectile that both hits and overlaps counts once; generic damage
+// without a shot id is never dropped), summed per
+// victim and applied with one UHealthComponent::ApplyDamage each, which dispatches death exactly once.
+UCLASS()
+class JOYSHIP2_API UDamageSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // Queue Amount against Victim's UHealthComponent. Causer/ShotId identify the source for de-duplication
+    // (ShotId distinguishes several shots from one causer, e.g. a recycled projectile or a simulated volley;
+    // ShotId 0, as UGameplayStatics::ApplyDamage arrives, is applied every time).
+    // Returns false if Victim has no health, is a network client's copy, or the event was a duplicate.
+    bool QueueDamage(AActor* Victim, float Amount, const UObject* Causer, uint32 ShotId = 0, AController* Instigator = nullptr);
+
+    // Apply everything queued so far
+    void ResolveDamage();
+
+    // Unique id for a shot (never 0)
+    uint32 NextShotId() { return ++ShotCounter == 0 ? ++ShotCounter : ShotCounter; }
+
+    int32 GetNumPending() const { return Pending.Num(); }
+
+protected:
+    struct FDamageKey
+    {
+        const AActor* Victim = nullptr;
+        const UObject* Causer = nullptr;
+        uint32 ShotId = 0;
+
+        bool operator==(const FDamageKey& Other) const
+        {
+            return Victim == Other.Victim && Causer == Other.Causer && ShotId == Other.ShotId;
+        }
+
+        friend uint32 GetTypeHash(const FDamageKey& Key)
+        {
+            return HashCombineFast(HashCombineFast(GetTypeHash(Key.Victim), GetTypeHash(Key.Causer)), GetTypeHash(Key.ShotId));
+        }
+    };
+
+    struct FPendingDamage
+    {
+        TWeakObjectPtr<UHealthComponent> Health;
+        float Amount = 0.f;
+    };
+
+    FDamageResolveTickFunction TickFunction;
+
+    TArray<FPendingDamage> Pending;
+    TSet<FDamageKey> PendingKeys;
+
+    // Resolve scratch: total per victim, in first-hit order
+    TMap<UHealthComponent*, float> Totals;
+
+    uint32 ShotCounter = 0;
+};
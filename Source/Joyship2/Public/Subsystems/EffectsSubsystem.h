@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EffectsSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+class USoundBase;
+class UAudioComponent;
+
+// Explosion effects with a budget. Emitters and audio components are pooled on one host actor instead of
+// spawned per death. Each request is culled by distance to the player cameras (APlayerShip::Camera), merged
+// with an identical explosion that just played nearby, and limited per frame and per area, so a chain of
+// deaths in one frame produces a handful of effects instead of dozens of new components.
+UCLASS(Config = Game)
+class JOYSHIP2_API UEffectsSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Deinitialize() override;
+
+    // Play Effect and/or Sound at Location if the budget allows. Returns true if anything played.
+    bool PlayExplosion(UParticleSystem* Effect, USoundBase* Sound, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator);
+
+    // Explosions allowed to start in one frame
+    UPROPERTY(Config)
+    int32 MaxExplosionsPerFrame = 4;
+
+    // Explosions allowed within AreaRadius of each other during AreaWindow seconds
+    UPROPERTY(Config)
+    int32 MaxExplosionsPerArea = 3;
+
+    UPROPERTY(Config)
+    float AreaRadius = 1000.f;
+
+    UPROPERTY(Config)
+    float AreaWindow = 0.5f;
+
+    // An explosion with the same effect within MergeRadius and MergeWindow seconds of one that played is merged into it
+    UPROPERTY(Config)
+    float MergeRadius = 200.f;
+
+    UPROPERTY(Config)
+    float MergeWindow = 0.1f;
+
+    // Explosions further than this from every player camera are skipped
+    UPROPERTY(Config)
+    float CullRadius = 8000.f;
+
+    // Pool caps; when every pooled component is busy the explosion is dropped
+    UPROPERTY(Config)
+    int32 MaxEmitters = 32;
+
+    UPROPERTY(Config)
+    int32 MaxAudioComponents = 16;
+
+    // Requests dropped since the world began or the last ResetStats, by reason (for the benchmark and `stat Joyship`-style debugging)
+    int32 NumCulled = 0;
+    int32 NumMerged = 0;
+    int32 NumOverBudget = 0;
+
+    void ResetStats() { NumCulled = NumMerged = NumOverBudget = 0; }
+
+protected:
+    struct FRecentExplosion
+    {
+        FVector Location = FVector::ZeroVector;
+        float Time = 0.f;
+        UParticleSystem* Effect = nullptr;
+        USoundBase* Sound = nullptr;
+    };
+
+    bool IsNearAnyCamera(const FVector& Location) const;
+    bool EnsureHost();
+    UParticleSystemComponent* AcquireEmitter();
+    UAudioComponent* AcquireAudio();
+
+    UPROPERTY()
+    AActor* HostActor = nullptr;
+
+    UPROPERTY()
+    TArray<UParticleSystemComponent*> Emitters;
+
+    UPROPERTY()
+    TArray<UAudioComponent*> AudioComponents;
+
+    TArray<FRecentExplosion> Recent;
+
+    uint64 BudgetFrame = MAX_uint64;
+    int32 PlayedThisFrame = 0;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "EnemySteeringSubsystem.generated.h"
+
+class AEnemyShip;
+class UEnemySteeringSubsystem;
+
+// Tick function that runs the batched steering pass once per frame in TG_PrePhysics
+USTRUCT()
+struct FEnemySteeringTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UEnemySteeringSubsystem* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FEnemySteeringTickFunction> : public TStructOpsTypeTraitsBase2<FEnemySteeringTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+// Steers every following AEnemyShip in one pass instead of one virtual Tick per enemy.
+// Follower state is gathered into flat arrays, steering is solved with ParallelFor, then written back on the game thread.
+UCLASS(Config = Game)
+class JOYSHIP2_API UEnemySteeringSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    void RegisterEnemy(AEnemyShip* Enemy);
+    void UnregisterEnemy(AEnemyShip* Enemy);
+
+    // Runs the aggro scan (when due) and the gather / solve / write-back pass
+    void UpdateSteering(float DeltaTime);
+
+    // Start/stop following for enemies with bUseSpatialAggro by querying the spatial grid around each player
+    void UpdateAggro();
+
+    // Steering for a single follower: turn Up toward the target in the ZY plane and thrust along the new Up
+    static void ComputeSteering(const FVector& Location, const FQuat& Rotation, const FVector& TargetLocation, float RotationSpeed, float ThrustForce, float DeltaTime, FQuat& OutRotation, FVector& OutVelocity);
+
+    int32 GetNumRegistered() const { return Enemies.Num(); }
+
+    // Below this many followers the solve runs on the game thread (task overhead is not worth it)
+    UPROPERTY(Config)
+    int32 MinFollowersForParallel = 64;
+
+    // How often (seconds) spatial aggro is re-evaluated
+    UPROPERTY(Config)
+    float AggroUpdateInterval = 0.1f;
+
+protected:
+    FEnemySteeringTickFunction TickFunction;
+
+    UPROPERTY()
+    TArray<AEnemyShip*> Enemies;
+
+    // Largest aggro radius among registered enemies (grid query radius around players)
+    float MaxAggroRadius = 0.f;
+    float AggroAccum = 0.f;
+    TArray<AActor*> AggroCandidates;
+
+    // Per-frame SoA scratch buffers (kept between frames to avoid reallocating)
+    TArray<AEnemyShip*> Followers;
+    TArray<FVector> Locations;
+    TArray<FQuat> Rotations;
+    TArray<FVector> TargetLocations;
+    TArray<float> RotationSpeeds;
+    TArray<float> ThrustForces;
+    TArray<FQuat> OutRotations;
+    TArray<FVector> OutVelocities;
+};
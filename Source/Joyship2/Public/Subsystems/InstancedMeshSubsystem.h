@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "InstancedMeshSubsystem.generated.h"
+
+class UStaticMesh;
+class UInstancedStaticMeshComponent;
+
+// Lightweight reference to one instance drawn by UInstancedMeshSubsystem
+struct FInstancedMeshHandle
+{
+    int32 MeshIndex = INDEX_NONE;
+    int32 InstanceIndex = INDEX_NONE;
+
+    bool IsValid() const { return MeshIndex != INDEX_NONE && InstanceIndex != INDEX_NONE; }
+    void Reset() { MeshIndex = INDEX_NONE; InstanceIndex = INDEX_NONE; }
+};
+
+// Draws every collectable/projectile that shares a static mesh through one UInstancedStaticMeshComponent,
+// so hundreds of pickups or bullets cost one scene proxy per mesh instead of one per actor.
+// Removed instances are hidden (zero scale) and recycled so instance indices, and therefore handles, stay stable.
+// Transform changes are queued and flushed in bulk once per frame; tracked actors are copied in the same pass.
+UCLASS()
+class JOYSHIP2_API UInstancedMeshSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    FInstancedMeshHandle AddInstance(UStaticMesh* Mesh, const FTransform& WorldTransform);
+
+    // Hide the instance, recycle its slot and reset Handle
+    void RemoveInstance(FInstancedMeshHandle& Handle);
+
+    // Queue a transform change (applied at the end of the frame)
+    void SetInstanceTransform(const FInstancedMeshHandle& Handle, const FTransform& WorldTransform);
+
+    // Follow Actor's transform every frame (for moving things such as projectiles and magnetised pickups)
+    void TrackActor(AActor* Actor, const FInstancedMeshHandle& Handle, const FTransform& RelativeTransform = FTransform::Identity);
+    void UntrackActor(AActor* Actor);
+
+    int32 GetNumMeshes() const { return Meshes.Num(); }
+
+protected:
+    struct FMeshBatch
+    {
+        UInstancedStaticMeshComponent* Component = nullptr;
+        TArray<int32> FreeInstances;
+        TArray<int32> PendingIndices;
+        TArray<FTransform> PendingTransforms;
+    };
+
+    struct FTrackedActor
+    {
+        TWeakObjectPtr<AActor> Actor;
+        // Map key; stays unique after the actor is gone, so a new actor at the same address cannot alias it
+        TObjectKey<AActor> Key;
+        FInstancedMeshHandle Handle;
+        FTransform RelativeTransform;
+    };
+
+    int32 FindOrAddMesh(UStaticMesh* Mesh);
+    void FlushPending();
+
+    // Owns the instanced components
+    UPROPERTY()
+    AActor* HostActor = nullptr;
+
+    // Keeps the components alive (FMeshBatch is not reflected)
+    UPROPERTY()
+    TArray<UInstancedStaticMeshComponent*> Components;
+
+    TArray<FMeshBatch> Meshes;
+    TMap<UStaticMesh*, int32> MeshIndexMap;
+
+    TArray<FTrackedActor> Tracked;
+    TMap<TObjectKey<AActor>, int32> TrackedIndex;
+
+    // FlushPending scratch: pending entries in instance order and the current run of consecutive instances
+    TArray<int32> FlushOrder;
+    TArray<FTransform> FlushRun;
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Net/ProjectileNetTypes.h"
+#include "ProjectileNetSubsystem.generated.h"
+
+class ABaseShip;
+class AProjectileEventRelay;
+class UProjectileNetSubsystem;
+
+// Tick function that records ship history and sends the frame's fire events, in TG_PostUpdateWork
+USTRUCT()
+struct FProjectileNetTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UProjectileNetSubsystem* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FProjectileNetTickFunction> : public TStructOpsTypeTraitsBase2<FProjectileNetTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+// Server-authoritative shots. Inactive in standalone. In a networked game:
+//   - the server queues every shot it launches as an FProjectileFireEvent and sends the frame's events to all
+//     clients in one batch (AProjectileEventRelay); clients simulate them as cosmetic simulated projectiles,
+//     fast-forwarded by the event's age, and never apply damage
+//   - the owning client draws its own shot at once and sends the event to the server (ABaseShip::ServerFire),
+//     stamped with the server time of the world it was looking at
+//   - the server rewinds ships to that time from a short position history, sweeps the shot through the rewound
+//     window (lag compensation), and either applies the hit or launches the projectile where it is by now
+// Test with "NetEmulation.PktLag 150" and "NetEmulation.PktLoss 5" on a loopback client (see
+// UShipNetMovementComponent for the command lines).
+UCLASS(Config = Game)
+class JOYSHIP2_API UProjectileNetSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // Oldest client view the server will rewind to (seconds)
+    UPROPERTY(Config)
+    float MaxRewindTime = 0.3f;
+
+    // Seconds of ship positions kept for rewinding (at least MaxRewindTime)
+    UPROPERTY(Config)
+    float HistorySeconds = 0.5f;
+
+    // A client shot whose origin is further than this (uu) from the shooter's muzzle is moved to the muzzle
+    UPROPERTY(Config)
+    float MaxOriginError = 300.f;
+
+    // Client shots from one shooter closer together than its fire cooldown minus this (seconds, network jitter) are dropped
+    UPROPERTY(Config)
+    float ClientFireJitter = 0.05f;
+
+    // A client shot aimed further than this (degrees) from the shooter's up vector is turned back to the edge of the cone
+    UPROPERTY(Config)
+    float MaxDirectionError = 5.f;
+
+    // Events per multicast; a busier frame is split over several
+    UPROPERTY(Config)
+    int32 MaxEventsPerBatch = 64;
+
+    bool IsNetworked() const;
+
+    // Server time as this machine knows it (the replicated estimate on clients)
+    double GetServerTime() const;
+
+    // Owning client: server time of the world being shown, i.e. GetServerTime() minus the one-way latency
+    double GetViewTime() const;
+
+    // Server: send this shot to every client with the next batch
+    void QueueFireEvent(const FProjectileFireEvent& Event);
+
+    // Server: resolve a shot fired by Shooter's owning client (see ABaseShip::ServerFire)
+    void ResolveClientShot(ABaseShip* Shooter, FProjectileFireEvent Event);
+
+    // Clients: draw a batch of server shots
+    void SimulateFireEvents(const TArray<FProjectileFireEvent>& Events);
+
+    // Server: ships whose positions are kept for rewinding
+    void RegisterHistory(AActor* Actor);
+    void UnregisterHistory(AActor* Actor);
+
+    // Server: where Actor was at server time Time (interpolated); false if it is not tracked
+    bool GetHistoricalLocation(const AActor* Actor, double Time, FVector& OutLocation) const;
+
+    void RegisterRelay(AProjectileEventRelay* InRelay);
+    void UnregisterRelay(AProjectileEventRelay* InRelay);
+
+    // Record history and flush the queued events
+    void TickNetwork(float DeltaTime);
+
+protected:
+    struct FHistorySample
+    {
+        double Time = 0.0;
+        FVector Location = FVector::ZeroVector;
+    };
+
+    // Ring of samples for one ship, oldest at Head once full
+    struct FHistoryTrack
+    {
+        TWeakObjectPtr<AActor> Actor;
+        float Radius = 0.f;
+        TArray<FHistorySample> Samples;
+        int32 Head = 0;
+        int32 Num = 0;
+    };
+
+    // History is sampled at most this often, so the ring size does not depend on the server frame rate
+    static constexpr float HistoryInterval = 1.f / 60.f;
+
+    void RecordHistory();
+    void FlushEvents();
+
+    const FHistorySample& GetSample(const FHistoryTrack& Track, int32 Age) const;
+    bool GetTrackLocation(const FHistoryTrack& Track, double Time, FVector& OutLocation) const;
+
+    // Nearest tracked ship (other than Ignore) hit by the segment, with every ship placed where it was at Time
+    AActor* TraceRewound(const FVector& Start, const FVector& Direction, float Length, float Radius, double Time, const AActor* Ignore, float& OutDistance) const;
+
+    FProjectileNetTickFunction TickFunction;
+
+    TArray<FHistoryTrack> Tracks;
+    double LastHistoryTime = -1.0;
+
+    TArray<FProjectileFireEvent> QueuedEvents;
+
+    // Server: last accepted client shot per shooter
+    TMap<TWeakObjectPtr<AActor>, double> LastClientShotTime;
+
+    UPROPERTY()
+    AProjectileEventRelay* Relay = nullptr;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+class AProjectile;
+
+// Counters for a single projectile class (or the sum over all classes)
+USTRUCT(BlueprintType)
+struct JOYSHIP2_API FProjectilePoolStats
+{
+    GENERATED_BODY()
+
+    // Acquires served from the free list
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile Pool")
+    int32 Hits = 0;
+
+    // Acquires that had to spawn a new actor
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile Pool")
+    int32 Misses = 0;
+
+    // Projectiles currently in flight
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile Pool")
+    int32 Active = 0;
+
+    // Projectiles waiting in the free list
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile Pool")
+    int32 Free = 0;
+
+    // Highest number of projectiles in flight at the same time
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile Pool")
+    int32 HighWaterMark = 0;
+};
+
+// Free list and counters for one projectile class
+USTRUCT()
+struct FProjectilePool
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<AProjectile*> FreeList;
+
+    FProjectilePoolStats Stats;
+};
+
+// Keeps AProjectile instances alive between shots so firing does not pay for SpawnActor/Destroy and GC.
+// Projectiles are handed out with Acquire and returned with Release (AProjectile::ReleaseProjectile does this).
+UCLASS()
+class JOYSHIP2_API UProjectilePoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Deinitialize() override;
+
+    // Make sure at least Count projectiles of Class exist (free + active). Call from BeginPlay of anything that fires.
+    void Prewarm(TSubclassOf<AActor> ProjectileClass, int32 Count);
+
+    // Fire a projectile of Class travelling along Direction at its InitialSpeed.
+    // AProjectile classes come from the pool; any other actor class falls back to SpawnActor.
+    AActor* SpawnProjectile(TSubclassOf<AActor> ProjectileClass, const FVector& Location, const FRotator& Rotation, const FVector& Direction, AActor* Owner, APawn* Instigator);
+
+    // Take a projectile out of the pool (spawning one on a miss). The projectile is not activated yet.
+    AProjectile* Acquire(TSubclassOf<AProjectile> ProjectileClass);
+
+    // Return a projectile to its pool. It is deactivated (hidden, no collision, no movement).
+    void Release(AProjectile* Projectile);
+
+    UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+    FProjectilePoolStats GetStatsForClass(TSubclassOf<AActor> ProjectileClass) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+    FProjectilePoolStats GetTotalStats() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+    void ResetStats();
+
+protected:
+    AProjectile* SpawnPooledProjectile(TSubclassOf<AProjectile> ProjectileClass);
+
+    UPROPERTY()
+    TMap<UClass*, FProjectilePool> Pools;
+
+    // Projectiles in flight across all classes and the peak of that number
+    int32 TotalActive = 0;
+    int32 TotalHighWaterMark = 0;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/InstancedMeshSubsystem.h"
+#include "SimulatedProjectileSubsystem.generated.h"
+
+class UStaticMesh;
+class USimulatedProjectileSubsystem;
+
+// Tick function that advances every simulated projectile once per frame in TG_PrePhysics
+USTRUCT()
+struct FSimulatedProjectileTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    USimulatedProjectileSubsystem* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FSimulatedProjectileTickFunction> : public TStructOpsTypeTraitsBase2<FSimulatedProjectileTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+// Non-actor projectiles: state lives in flat arrays, is integrated in one ParallelFor pass and hit-tested as swept
+// segments against the spatial grid (plus an optional world-static line trace), so a shot costs no actor, component
+// tick or physics sweep. Speed, damage, lifetime, radius and mesh come from the AProjectile class defaults, so the
+// same ProjectileClass works in either mode. Damage is queued into UDamageSubsystem (one event per shot); on network
+// clients projectiles are cosmetic and stop at whatever they hit without damaging it.
+UCLASS(Config = Game)
+class JOYSHIP2_API USimulatedProjectileSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // Launch one projectile described by ProjectileClass's defaults. Returns false if ProjectileClass is not an AProjectile.
+    // ElapsedTime starts the projectile that many seconds into its flight (e.g. a fire event that arrived late).
+    bool Fire(TSubclassOf<AActor> ProjectileClass, const FVector& Location, const FVector& Direction, AActor* Owner, APawn* Instigator, float ElapsedTime = 0.f);
+
+    // Integrate, hit-test and retire projectiles
+    void UpdateProjectiles(float DeltaTime);
+
+    int32 GetNumActive() const { return Positions.Num(); }
+
+    // Projectiles launched by Fire since the world began or the last ResetStats
+    int32 GetTotalFired() const { return TotalFired; }
+    void ResetStats() { TotalFired = 0; }
+
+    // Also stop at world-static geometry (one line trace per projectile per frame)
+    UPROPERTY(Config)
+    bool bCollideWithWorld = true;
+
+    // Below this many projectiles the integration runs on the game thread
+    UPROPERTY(Config)
+    int32 MinProjectilesForParallel = 128;
+
+    // Per-class values read once from the AProjectile CDO
+    struct FProjectileDesc
+    {
+        float Speed = 3000.f;
+        float Damage = 10.f;
+        float LifeTime = 5.f;
+        float Radius = 8.f;
+        UStaticMesh* Mesh = nullptr;
+        FTransform MeshTransform;
+    };
+
+    // Null if ProjectileClass is not an AProjectile
+    const FProjectileDesc* FindOrAddDesc(UClass* ProjectileClass);
+
+protected:
+    // Apply Damage to Victim on behalf of projectile Index
+    void ApplyHit(int32 Index, AActor* Victim);
+
+    void RemoveProjectile(int32 Index);
+
+    FSimulatedProjectileTickFunction TickFunction;
+
+    TMap<UClass*, FProjectileDesc> Descs;
+
+    // Keeps the described classes (and their meshes) referenced
+    UPROPERTY()
+    TArray<UClass*> DescClasses;
+
+    // Projectile state, one entry per live projectile (SoA)
+    TArray<FVector> Positions;
+    TArray<FVector> Velocities;
+    TArray<float> RemainingLife;
+    TArray<float> Damages;
+    TArray<float> Radii;
+    TArray<TWeakObjectPtr<AActor>> Owners;
+    TArray<TWeakObjectPtr<AController>> InstigatorControllers;
+    TArray<uint32> ShotIds;
+    TArray<FInstancedMeshHandle> MeshHandles;
+    TArray<FTransform> MeshTransforms;
+
+    int32 TotalFired = 0;
+
+    // Per-frame scratch
+    TArray<FVector> PrevPositions;
+};
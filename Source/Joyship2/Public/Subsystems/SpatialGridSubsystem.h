@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SpatialGridSubsystem.generated.h"
+
+// What an indexed actor is; queries filter on any of these bits
+enum class ESpatialGridFlags : uint8
+{
+    None        = 0,
+    Ship        = 1 << 0,   // any ABaseShip
+    Player      = 1 << 1,   // APlayerShip
+    Turret      = 1 << 2,
+    Damageable  = 1 << 3,   // owns a UHealthComponent
+    Collectable = 1 << 4,
+    PooledCollectable = 1 << 5, // collected and waiting in UCollectableSubsystem (kept for network relevancy only)
+    Pawn        = 1 << 6,   // any APawn, registered by the grid itself (turret targeting)
+    All         = 0xFF
+};
+ENUM_CLASS_FLAGS(ESpatialGridFlags);
+
+// Uniform spatial hash over the ZY play plane for gameplay queries (aggro, turret targeting, aim assist).
+// Actors register in BeginPlay and unregister in EndPlay; every APawn is added with the Pawn flag automatically. The grid is rebuilt lazily, at most once per frame,
+// on the first query, so each radius/cone/ray query only touches the cells it overlaps. Registering or unregistering after that build
+// patches the built grid in place instead of forcing another rebuild.
+// Each actor is treated as a circle (its simple collision radius), matching what an overlap or sweep would report.
+UCLASS()
+class JOYSHIP2_API USpatialGridSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // Add Actor (or add Flags to an already registered actor).
+    // Radius < 0 uses the actor's simple collision radius (re-read on each call unless a Radius was given before);
+    // a non-negative Radius always overrides it.
+    void Register(AActor* Actor, ESpatialGridFlags Flags, float Radius = -1.f);
+
+    // Remove Actor completely
+    void Unregister(AActor* Actor);
+
+    // All actors matching Filter whose circle touches the circle (Center, Radius)
+    void QueryRadius(const FVector& Center, float Radius, ESpatialGridFlags Filter, TArray<AActor*>& OutActors, const AActor* IgnoreActor = nullptr);
+
+    // All actors matching Filter whose circle reaches within Range of Origin and within HalfAngleDegrees of Direction
+    void QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, ESpatialGridFlags Filter, TArray<AActor*>& OutActors, const AActor* IgnoreActor = nullptr);
+
+    // First actor matching Filter hit by a sphere of Radius swept from Origin along Direction for Range (like SweepSingle)
+    AActor* FindFirstAlongRay(const FVector& Origin, const FVector& Direction, float Range, float Radius, ESpatialGridFlags Filter, const AActor* IgnoreActor = nullptr);
+
+    // Returns true and fills OutFlags if Actor is indexed
+    bool GetFlags(const AActor* Actor, ESpatialGridFlags& OutFlags) const;
+
+    // Returns true and fills OutRadius if Actor is indexed
+    bool GetRadius(const AActor* Actor, float& OutRadius) const;
+
+    // Change the cell size (uu). Takes effect on the next rebuild.
+    void SetCellSize(float NewCellSize);
+    float GetCellSize() const { return CellSize; }
+
+    int32 GetNumEntries() const { return EntryIndex.Num(); }
+
+protected:
+    // Entries are not UPROPERTYs: the weak pointer lets an actor destroyed without unregistering be pruned safely.
+    // An unused slot has no Key and no Flags, so every query filter skips it.
+    struct FEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+        TObjectKey<AActor> Key;
+        float Radius = 0.f;
+        ESpatialGridFlags Flags = ESpatialGridFlags::None;
+        bool bExplicitRadius = false;
+    };
+
+    void HandleActorSpawned(AActor* Actor);
+
+    // Rebuild the hash if it has not been built this frame
+    void EnsureBuilt();
+
+    bool IsBuilt() const { return BuiltFrame == GFrameCounter; }
+
+    bool IsSlotUsed(int32 Slot) const { return Entries[Slot].Key != TObjectKey<AActor>(); }
+    void ReleaseSlot(int32 Slot);
+
+    FIntPoint CellOf(const FVector2D& P) const;
+    int32 BucketOf(const FIntPoint& Cell) const;
+
+    // Visit every built entry in Cell
+    template<typename FuncType>
+    void ForEachInCell(const FIntPoint& Cell, ESpatialGridFlags Filter, const AActor* IgnoreActor, FuncType&& Func);
+
+    // Visit every entry registered since the build (not in any cell yet)
+    template<typename FuncType>
+    void ForEachAdded(ESpatialGridFlags Filter, const AActor* IgnoreActor, FuncType&& Func);
+
+    // Visit every entry whose cell lies in [MinCell, MaxCell], plus those registered since the build
+    template<typename FuncType>
+    void ForEachInCells(const FIntPoint& MinCell, const FIntPoint& MaxCell, ESpatialGridFlags Filter, const AActor* IgnoreActor, FuncType&& Func);
+
+    static FVector2D ToPlane(const FVector& V) { return FVector2D(V.Y, V.Z); }
+
+    float CellSize = 500.f;
+
+    // Largest registered radius; cell ranges are padded by this so big actors are not missed
+    float MaxEntryRadius = 0.f;
+
+    // Slots are stable: the built arrays below refer to them by index
+    TArray<FEntry> Entries;
+    TMap<TObjectKey<AActor>, int32> EntryIndex;
+    TArray<int32> FreeSlots;
+
+    // Slots released since the build. The built arrays may still point at them, so they are only reused after the next build.
+    TArray<int32> ReleasedSlots;
+
+    // Entries registered since the build, with the position they had then
+    struct FAddedEntry
+    {
+        int32 Slot = INDEX_NONE;
+        FVector2D Position = FVector2D::ZeroVector;
+    };
+    TArray<FAddedEntry> AddedSinceBuild;
+
+    // Built data, sorted by bucket
+    uint32 BucketMask = 0;
+    TArray<int32> BucketStart;
+    TArray<int32> SortedEntries;
+    TArray<FIntPoint> SortedCells;
+    TArray<FVector2D> SortedPositions;
+
+    uint64 BuiltFrame = MAX_uint64;
+
+    FDelegateHandle ActorSpawnedHandle;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/SoftObjectPath.h"
+#include "StreamingCellSubsystem.generated.h"
+
+class ULevel;
+
+// Counters for streamed cells and the gameplay actors in them
+USTRUCT(BlueprintType)
+struct JOYSHIP2_API FStreamingCellStats
+{
+    GENERATED_BODY()
+
+    // Streamed levels (World Partition cells) currently in the world
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Streaming")
+    int32 LoadedCells = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Streaming")
+    int32 PeakLoadedCells = 0;
+
+    // Turrets, enemies and collectables that have begun play and not ended it
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Streaming")
+    int32 LiveActors = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Streaming")
+    int32 PeakActors = 0;
+
+    // Cell actors removed because their cell streamed out
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Streaming")
+    int32 StreamedOut = 0;
+
+    // Placed actors destroyed or collected; they stay gone when their cell streams back in
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Streaming")
+    int32 Consumed = 0;
+};
+
+// Gameplay side of World Partition streaming. Turrets, enemies and collectables register with their managers
+// (grid, steering, significance, collectables) in BeginPlay and leave them in EndPlay, which World Partition calls
+// as their cell streams in and out; this subsystem sits next to those hooks. It counts loaded cells and live
+// gameplay actors, and remembers which placed actors were consumed (killed, destroyed or collected for good), since
+// a cell that streams back in reloads every actor it was saved with. Consumed placements are discarded before
+// BeginPlay on the server, and the engine's destroyed-startup-actor list tells clients.
+//
+// World Partition runtime spatial hash cells are square in XY and unbounded in Z. The ZY play plane therefore
+// streams along Y only, which is the axis long levels grow along; 12800 uu cells with a 25600 uu loading range
+// keep the next screen or two loaded around a ship.
+UCLASS()
+class JOYSHIP2_API UStreamingCellSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // PostInitializeComponents of a placed actor: destroys it and returns true when it was consumed earlier
+    static bool DiscardIfConsumed(AActor* Actor);
+
+    // BeginPlay of a turret, enemy or collectable
+    void AddCellActor(AActor* Actor);
+
+    // EndPlay of a turret, enemy or collectable. bConsumed: the actor is gone for good (a placed one is not reloaded).
+    void RemoveCellActor(AActor* Actor, EEndPlayReason::Type EndPlayReason, bool bConsumed);
+
+    bool IsConsumed(const AActor* Actor) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Streaming")
+    FStreamingCellStats GetStats() const { return Stats; }
+
+    // Clear the peaks back to the current counts
+    UFUNCTION(BlueprintCallable, Category = "Streaming")
+    void ResetPeaks();
+
+protected:
+    void HandleLevelAdded(ULevel* Level, UWorld* World);
+    void HandleLevelRemoved(ULevel* Level, UWorld* World);
+
+    FStreamingCellStats Stats;
+
+    // Placed actors that must not come back, by path (stable across a cell's unload and reload)
+    TSet<FSoftObjectPath> ConsumedActors;
+
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+};
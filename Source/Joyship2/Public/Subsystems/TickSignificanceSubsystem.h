@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "TickSignificanceSubsystem.generated.h"
+
+// How much an actor matters to the players right now, most significant first
+enum class ESignificanceTier : uint8
+{
+    High,       // near a player or on screen: tick every frame
+    Medium,
+    Low,
+    Dormant,    // far away and off screen: may stop ticking
+    Num
+};
+
+// Scores registered actors by distance to the nearest APlayerShip and whether they sit inside that player's
+// camera view, a few times a second. Each actor is told only when its tier changes and applies the tier itself
+// (usually via GetTierTickInterval), because only the actor knows whether it should be ticking at all
+// (an idle collectable or a turret without a target stays asleep regardless of tier).
+// Actor ticks receive the real time since their last tick, so slowed ticks stay correct.
+UCLASS(Config = Game)
+class JOYSHIP2_API UTickSignificanceSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    using FOnTierChanged = TFunction<void(ESignificanceTier)>;
+
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // Start scoring Actor. OnTierChanged is called right away with the current tier and then on every change.
+    void Register(AActor* Actor, FOnTierChanged&& OnTierChanged);
+    void Unregister(AActor* Actor);
+
+    ESignificanceTier GetTier(const AActor* Actor) const;
+
+    // Tick interval for a tier (0 = every frame)
+    float GetTierTickInterval(ESignificanceTier Tier) const;
+
+    // Re-score every registered actor
+    void UpdateSignificance();
+
+    int32 GetNumRegistered() const { return Entries.Num(); }
+    int32 GetNumInTier(ESignificanceTier Tier) const { return TierCounts[(int32)Tier]; }
+
+    // How often (seconds) actors are re-scored
+    UPROPERTY(Config)
+    float UpdateInterval = 0.25f;
+
+    // Within this distance of a player: High regardless of view
+    UPROPERTY(Config)
+    float NearDistance = 2500.f;
+
+    // Inside the camera view and within this distance: High
+    UPROPERTY(Config)
+    float VisibleDistance = 8000.f;
+
+    // Within these distances: Medium / Low; beyond FarDistance: Dormant
+    UPROPERTY(Config)
+    float MidDistance = 6000.f;
+
+    UPROPERTY(Config)
+    float FarDistance = 15000.f;
+
+    // Tick intervals (seconds) for Medium, Low and Dormant actors that keep ticking
+    UPROPERTY(Config)
+    float MediumTickInterval = 0.1f;
+
+    UPROPERTY(Config)
+    float LowTickInterval = 0.33f;
+
+    UPROPERTY(Config)
+    float DormantTickInterval = 1.f;
+
+protected:
+    struct FEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+        TObjectKey<AActor> Key;
+        ESignificanceTier Tier = ESignificanceTier::High;
+        FOnTierChanged OnTierChanged;
+    };
+
+    struct FViewer
+    {
+        FVector Location = FVector::ZeroVector;
+        FVector CameraLocation = FVector::ZeroVector;
+        FVector CameraForward = FVector::ForwardVector;
+        float CosHalfFOV = 0.f;
+    };
+
+    void GatherViewers();
+    void RemoveEntry(const TObjectKey<AActor>& Key);
+    ESignificanceTier ScoreLocation(const FVector& Location) const;
+
+    FTimerHandle UpdateTimer;
+
+    TArray<FEntry> Entries;
+    TMap<TObjectKey<AActor>, int32> EntryIndex;
+    TArray<FViewer> Viewers;
+
+    int32 TierCounts[(int32)ESignificanceTier::Num] = {};
+};
@@ -2,10 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Subsystems/InstancedMeshSubsystem.h"
 #include "Projectile.generated.h"
 
 class USphereComponent;
 class UProjectileMovementComponent;
+class UStaticMesh;
 
 UCLASS()
 class JOYSHIP2_API AProjectile : public AActor
@@ -16,7 +18,12 @@ public:
     AProjectile();
 
 protected:
+    virtual void PostInitializeComponents() override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Flip bActive and keep the live projectile counter in sync
+    void SetProjectileActive(bool bNewActive);
 
 public:
     // Collision
@@ -35,9 +42,49 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
     float LifeTime = 5.f;
 
+    // Optional mesh drawn through UInstancedMeshSubsystem while in flight (leave the Blueprint without its own mesh component)
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile|Rendering")
+    UStaticMesh* InstancedMesh = nullptr;
+
+    // Offset/scale of InstancedMesh relative to the actor
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile|Rendering")
+    FTransform InstancedMeshTransform;
+
+    // True when this projectile is owned by UProjectilePoolSubsystem (set before BeginPlay)
+    bool bPooled = false;
+
+    // True while in flight; false while the projectile sits in the pool (or before BeginPlay)
+    bool bActive = false;
+
+    // Identifies the current flight for damage de-duplication (a pooled projectile gets a new id per shot)
+    uint32 ShotId = 0;
+
+    // Reset movement, collision and lifespan and launch along Direction at InitialSpeed
+    void ActivateProjectile(const FVector& Location, const FRotator& Rotation, const FVector& Direction);
+
+    // Hide, disable collision and stop movement so the projectile can wait in the pool
+    void DeactivateProjectile();
+
+    // End of life: return to the pool if pooled, otherwise destroy
+    UFUNCTION(BlueprintCallable, Category = "Projectile")
+    void ReleaseProjectile();
+
     UFUNCTION()
     void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
     UFUNCTION()
     void OnOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult);
+
+protected:
+    // Replaces actor lifespan so pooled projectiles are recycled instead of destroyed
+    FTimerHandle LifeTimer;
+
+    // Queue Damage against OtherActor through UDamageSubsystem
+    void DealDamage(AActor* OtherActor);
+
+    // Collision setting to restore when leaving the pool
+    ECollisionEnabled::Type DefaultCollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+
+    // Instance handle while active and InstancedMesh is set
+    FInstancedMeshHandle MeshHandle;
 };